@@ -5,6 +5,17 @@
 #error Unexpected version of Arduboy Library
 #endif // It may work even if you use other version. So comment out the above line.
 
+//#define INPUT_RECORD  // Log button states and frame hashes to Serial
+//#define INPUT_REPLAY  // Replay button states of "replay.h" and verify frame hashes
+
+#if defined(INPUT_RECORD) || defined(INPUT_REPLAY)
+#define INPUT_HARNESS
+#define INPUT_SEED      0x4F424E00UL
+#define micros()        ((unsigned long) inputFrames << 14) // Deterministic time
+#define millis()        ((unsigned long) inputFrames << 4)
+extern uint16_t inputFrames;
+#endif
+
 class MyArduboy2 : public Arduboy2
 {
 public:
@@ -20,6 +31,8 @@ public:
     void    drawFastVLine(int16_t x, int16_t y, int8_t h, uint8_t color);
     void    drawFastHLine(int16_t x, int16_t y, uint8_t w, uint8_t color);
     void    fillRect(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color);
+    void    drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h);
+    void    drawBitmapBordered(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
 
     void    initAudio(uint8_t chans);
     void    closeAudio(void);
@@ -35,6 +48,7 @@ private:
     void    drawChar(int16_t x, int16_t y, unsigned char c, uint8_t color, uint8_t bg, uint8_t size);
     void    fillBeltBlack(uint8_t *p, uint8_t d, uint8_t w);
     void    fillBeltWhite(uint8_t *p, uint8_t d, uint8_t w);
+    void    drawMaskedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h);
     uint8_t lastButtonState;
     uint8_t currentButtonState;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MyArduboy2.h"
+#include "MyRandom.h"
 
 /*  Defines  */
 
@@ -131,7 +131,6 @@ static void     drawEnemies(void);
 static void     drawExplosion(void);
 static void     drawBackground(void);
 static void     drawLetters(void);
-static void     drawLettersBigLabel(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
 static void     drawLettersGameSeed(void);
 
 /*  Local Functions (macros)  */
@@ -153,6 +152,7 @@ static BULLET_T bullets[BULLET_MAX];
 static GROUP_T  groups[GROUP_MAX];
 static ENEMY_T  enemies[ENEMY_MAX];
 static EXPLO_T  explo;
+static MyRandomCompat patternRandom; // keeps patterns of existing game seeds
 static uint16_t gameFrames;
 static uint8_t  gameRank, bulletsNum;
 static uint8_t  playerX, playerY, playerFire, playerSlow;
@@ -228,7 +228,7 @@ static void initGameParams(void)
     initBullets();
     initEnemies();
     explo.a = IMG_EXPLO_ID_MAX;
-    randomSeed(record.gameSeed + 1);
+    patternRandom.setSeed(record.gameSeed + 1);
     dprint(F("Game start: seed="));
     dprint(record.gameSeed);
     dprint(F(" rank="));
@@ -413,21 +413,21 @@ static void newGroup(uint8_t groupIdx)
     GROUP_T *pG = &groups[idx];
 
     /*  Moving path design  */
-    pG->xRad = random(4, 37);
-    pG->yRad = random(3, 28);
-    pG->yFlip = random(2);
-    pG->xCoef = random(4, 64);
-    pG->yCoef = random(4, 64);
-    pG->entryInt = random(8);
+    pG->xRad = patternRandom.range(4, 37);
+    pG->yRad = patternRandom.range(3, 28);
+    pG->yFlip = patternRandom.below(2);
+    pG->xCoef = patternRandom.range(4, 64);
+    pG->yCoef = patternRandom.range(4, 64);
+    pG->entryInt = patternRandom.below(8);
 
     /*  Bullets design  */
-    pG->type = random(ENEMY_TYPE_MAX);
-    pG->fireInt = random(FPS, FPS * 3 + 1);
-    pG->fireCycle = random(8);
-    pG->fireExSpd = random(4);
+    pG->type = patternRandom.below(ENEMY_TYPE_MAX);
+    pG->fireInt = patternRandom.range(FPS, FPS * 3 + 1);
+    pG->fireCycle = patternRandom.below(8);
+    pG->fireExSpd = patternRandom.below(4);
     uint8_t fires = gameRank * pG->fireInt / FPS / 2;
     if (fires == 0) fires = 1;
-    uint8_t fireDiv = (random(4)) ? 1 : random(1, sqrt(fires) + 1);
+    uint8_t fireDiv = (patternRandom.below(4)) ? 1 : patternRandom.range(1, sqrt(fires) + 1);
     uint8_t fireThick = fires / fireDiv;
     if (pG->type <= ENEMY_TYPE_FUNWISE) {
         pG->fireTimes = fireDiv;
@@ -439,20 +439,20 @@ static void newGroup(uint8_t groupIdx)
     uint16_t fireCycleMax = pG->fireInt / pG->fireTimes - BULLET_CYC_BASE;
     if (pG->fireCycle > fireCycleMax) pG->fireCycle = fireCycleMax;
     if ((pG->type == ENEMY_TYPE_FUNWISE || pG->type == ENEMY_TYPE_MOWING) && fireThick > 1) {
-        uint8_t mowGap = random(32, 64) / (fireThick - 1);
+        uint8_t mowGap = patternRandom.range(32, 64) / (fireThick - 1);
         pG->fireGap = constrain(mowGap, BULLET_GAP_BASE, 23) - BULLET_GAP_BASE;
     } else {
-        pG->fireGap = random(1, 5);
+        pG->fireGap = patternRandom.range(1, 5);
     }
 
     /*  Position of each enemy  */
     ENEMY_T *pE = &enemies[idx * ENEMY_UNITY];
     int8_t x = playerX / PLAYER_SCALE, y = playerY / PLAYER_SCALE;
     for (int i = 0; i < ENEMY_UNITY; i++, pE++) {
-        pE->bx = random(pG->xRad / 2, WIDTH / 2 - 3 - pG->xRad);
-        pE->by = random(pG->yRad + 3, HEIGHT - 3 - pG->yRad);
+        pE->bx = patternRandom.range(pG->xRad / 2, WIDTH / 2 - 3 - pG->xRad);
+        pE->by = patternRandom.range(pG->yRad + 3, HEIGHT - 3 - pG->yRad);
         pE->life = ENEMY_LIFE_INIT;
-        pE->framesGap = random(256);
+        pE->framesGap = patternRandom.below(256);
         Point enemyPoint = getEnemyCoords(pG, pE, 0);
         pE->fireDeg = myAtan2f(y - enemyPoint.y, x - enemyPoint.x);
     }
@@ -737,7 +737,11 @@ static void drawBackground(void)
     /*  Starts  */
     uint8_t g = counter & 3;
     uint8_t d = g * 71;
+#ifdef __AVR__
     uint8_t *p = (uint8_t *)drawBackground + g * 3;
+#else
+    uint8_t *p = (uint8_t *)imgCompleted + g * 3; // Code bytes differ between host builds
+#endif
     int16_t s = (state == STATE_START) ? counter - START_DURATION : gameFrames;
     for (int16_t y = g * 2; y < HEIGHT; y += 8, p += 12) {
         d += pgm_read_byte(p) + 29;
@@ -765,7 +769,7 @@ static void drawLetters(void)
     switch (state) {
     case STATE_START:
         if (bitRead(counter, 3)) {
-            drawLettersBigLabel((WIDTH - IMG_READY_W) / 2, 24, imgReady, IMG_READY_W, IMG_READY_H);
+            arduboy.drawBitmapBordered((WIDTH - IMG_READY_W) / 2, 24, imgReady, IMG_READY_W, IMG_READY_H);
         }
         drawLettersGameSeed();
         break;
@@ -775,11 +779,11 @@ static void drawLetters(void)
     case STATE_OVER:
         if (isDefeated) {
             int16_t a = 30 - min(counter, 30);
-            drawLettersBigLabel((WIDTH - IMG_FAILED_W) / 2 + a * a / 10, 24, imgFailed,
+            arduboy.drawBitmapBordered((WIDTH - IMG_FAILED_W) / 2 + a * a / 10, 24, imgFailed,
                     IMG_FAILED_W, IMG_FAILED_H);
         } else {
             int16_t dy = min(counter, 40) - 16;
-            drawLettersBigLabel((WIDTH - IMG_COMPLETED_W) / 2, dy, imgCompleted,
+            arduboy.drawBitmapBordered((WIDTH - IMG_COMPLETED_W) / 2, dy, imgCompleted,
                     IMG_COMPLETED_W, IMG_COMPLETED_H);
         }
         if (counter >= OVER_OMIT) {
@@ -794,14 +798,6 @@ static void drawLetters(void)
     }
 }
 
-static void drawLettersBigLabel(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h)
-{
-    for (int i = 1; i <= 7; i += 2) {
-        arduboy.drawBitmap(x + i % 3 - 1, y + i / 3 - 1, bitmap, w, h, BLACK);
-    }
-    arduboy.drawBitmap(x, y, bitmap, w, h);
-}
-
 static void drawLettersGameSeed(void)
 {
     bool is2Digits = (gameRank >= 10);
@@ -42,7 +42,7 @@ static void drawSettings(void);
 static void drawCredit(void);
 static void drawCodeEntry(void);
 static void drawTitleLogo(void);
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 
 /*  Local Functions (macros)  */
 
@@ -47,6 +47,7 @@
 #define DUTY_CYCLE_MAX  5
 #define NOTE_MAX        127
 #define NOTE_MIDDLE     sizeof(midiByteNoteFrequencies)
+#define WAVE_STEP_INDEX_MAX 88
 
 /*  Local Functions  */
 
@@ -54,6 +55,7 @@ static void stepScore(void);
 static void playNote(uint8_t chan, uint8_t note, uint8_t dutyCycle);
 static void stopNote(uint8_t chan);
 static void setupTimer(uint8_t timer, uint16_t frequency, uint8_t dutyCycle);
+static uint8_t decodeWaveSample(void);
 
 /*  Local Functions (macros)  */
 
@@ -123,6 +125,11 @@ static volatile const byte *scoreStart = 0;
 static volatile const byte *scoreCursor = 0;
 static volatile const byte *waveCursor = 0;
 
+// IMA-ADPCM decoder state of the wave
+static volatile int16_t wavePredictor;
+static volatile uint8_t waveStepIndex;
+static volatile bool isWaveHighNibble;
+
 // score tuning parameters
 static volatile int8_t scorePitchDefault, scorePitch;
 static volatile uint8_t scoreRepeat;
@@ -150,6 +157,20 @@ PROGMEM static const int8_t tuneNoteTable[] = {
     0, 1, 2, 3, 4, 6, 8, 12, 0, -12, -8, -6, -4, -3, -2, -1
 };
 
+// IMA-ADPCM step sizes and step index adjustments
+PROGMEM static const uint16_t waveStepTable[WAVE_STEP_INDEX_MAX + 1] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66,
+    73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+PROGMEM static const int8_t waveIndexTable[] = {
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
 /*---------------------------------------------------------------------------*/
 /*                            Initialize & Finalize                          */
 /*---------------------------------------------------------------------------*/
@@ -288,11 +309,14 @@ void MyArduboy2::playWave(uint16_t frequency, const byte *wave, uint16_t samples
         stopScore();
     }
     audioPriority = priority;
-    isWavePlaying = true;
     waveCursor = wave;
-    enablePWM();
-    OCR4A = pgm_read_byte(waveCursor);
+    wavePredictor = 0;
+    waveStepIndex = 0;
+    isWaveHighNibble = false;
     timer3ToggleCount = samples;
+    enablePWM();
+    OCR4A = decodeWaveSample();
+    isWavePlaying = true; // the decoder is ready before the interrupt sees the wave
     setupTimer(3, frequency, 1);
 }
 
@@ -402,6 +426,35 @@ static void setupTimer(uint8_t timerNum, uint16_t frequency, uint8_t dutyCycle)
     }
 }
 
+// Decode one 4-bit IMA-ADPCM code (lower nibble first) into an unsigned 8-bit sample
+static uint8_t decodeWaveSample(void)
+{
+    uint8_t code = pgm_read_byte(waveCursor);
+    if (isWaveHighNibble) {
+        code >>= 4;
+        waveCursor++;
+    }
+    isWaveHighNibble = !isWaveHighNibble;
+
+    uint16_t step = pgm_read_word(waveStepTable + waveStepIndex);
+    uint16_t diff = step >> 3;
+    if (code & 4) diff += step;
+    if (code & 2) diff += step >> 1;
+    if (code & 1) diff += step >> 2;
+    int32_t predictor = wavePredictor;
+    predictor += (code & 8) ? -(int32_t)diff : diff;
+    if (predictor < -32768) predictor = -32768;
+    if (predictor > 32767) predictor = 32767;
+    wavePredictor = predictor;
+
+    int8_t stepIndex = waveStepIndex + (int8_t)pgm_read_byte(waveIndexTable + (code & 7));
+    if (stepIndex < 0) stepIndex = 0;
+    if (stepIndex > WAVE_STEP_INDEX_MAX) stepIndex = WAVE_STEP_INDEX_MAX;
+    waveStepIndex = stepIndex;
+
+    return (wavePredictor >> 8) + 128;
+}
+
 /*---------------------------------------------------------------------------*/
 /*                        Interrupt service routines                         */
 /*---------------------------------------------------------------------------*/
@@ -427,7 +480,8 @@ ISR(TIMER3_COMPA_vect) // TIMER 3
     // and use it to time score waits, whether or not it is playing a note.
     if (isWavePlaying) {
         if (--timer3ToggleCount > 0) {
-            if (!isAllMuted) OCR4A = pgm_read_byte(++waveCursor);
+            uint8_t sample = decodeWaveSample();
+            if (!isAllMuted) OCR4A = sample;
         } else {
             isWavePlaying = false;
             disablePWM();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*  Entries of text coded by canonical Huffman code, made by etc/textcorpus.go  */
+
+class MyCorpus
+{
+public:
+    void     setup(const uint8_t *p);
+    uint16_t getCount(void) { return count; }
+    void     seek(uint16_t idx);
+    char     next(void);
+
+private:
+    const uint8_t   *pLengths, *pSymbols, *pOffsets, *pData, *pNext;
+    uint16_t        count;
+    uint8_t         shift, maxLength, currentByte, mask;
+};
+
+inline void MyCorpus::setup(const uint8_t *p)
+{
+    count = pgm_read_byte(p) | pgm_read_byte(p + 1) << 8;
+    shift = pgm_read_byte(p + 2);
+    maxLength = pgm_read_byte(p + 3);
+    pLengths = p + 4;
+    pSymbols = pLengths + maxLength;
+    uint16_t symbolsNum = 0;
+    for (uint8_t i = 0; i < maxLength; i++) symbolsNum += pgm_read_byte(pLengths + i);
+    pOffsets = pSymbols + symbolsNum;
+    pData = pOffsets + count * 2;
+    pNext = NULL;
+}
+
+inline void MyCorpus::seek(uint16_t idx)
+{
+    /*  The table is of bytes in little endian, which may be at an odd address  */
+    const uint8_t *p = pOffsets + idx * 2;
+    uint32_t bitOffset = (uint32_t) (pgm_read_byte(p) | pgm_read_byte(p + 1) << 8) << shift;
+    pNext = pData + (bitOffset >> 3);
+    mask = 0x80 >> (bitOffset & 7);
+    currentByte = pgm_read_byte(pNext++);
+}
+
+/*  Returns '\0' at the end of the entry, reading at most maxLength bits  */
+inline char MyCorpus::next(void)
+{
+    if (!pNext) return '\0';
+    uint16_t code = 0, first = 0, index = 0;
+    for (uint8_t i = 0; i < maxLength; i++) {
+        if (currentByte & mask) code |= 1;
+        mask >>= 1;
+        if (!mask) {
+            currentByte = pgm_read_byte(pNext++);
+            mask = 0x80;
+        }
+        uint8_t n = pgm_read_byte(pLengths + i);
+        if (code < first + n) {
+            char symbol = pgm_read_byte(pSymbols + index + code - first);
+            if (!symbol) pNext = NULL;
+            return symbol;
+        }
+        index += n;
+        first = (first + n) << 1;
+        code <<= 1;
+    }
+    pNext = NULL;
+    return '\0';
+}
@@ -203,27 +203,27 @@ static void eepReadBlock(void *p, size_t n)
 static void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 static void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 static void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 static void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
@@ -64,13 +64,15 @@ void    drawGame(void);
 /*  Global Functions (macros)  */
 
 #define IMPORT_BIN_FILE(file, sym) asm (    \
+    ".pushsection .progmem.data,\"a\",@progbits\n" \
     ".global " #sym "\n"                    \
     #sym ":\n"                              \
     ".incbin \"" file "\"\n"                \
     ".byte 0\n"                             \
     ".global _sizeof_" #sym "\n"            \
     ".set _sizeof_" #sym ", . - " #sym "\n" \
-    ".balign 2\n")
+    ".balign 2\n"                           \
+    ".popsection\n")
 
 #define circulate(n, v, m)      (((n) + (v) + (m)) % (m))
 #define circulateOne(n, v, m)   (((n) + (v) + (m) - 1) % (m) + 1)
@@ -1,8 +1,7 @@
 #pragma once
 
 IMPORT_BIN_FILE("banana.bin", waveBanana);
-IMPORT_BIN_FILE("sayingsData.bin", sayingsData);
-IMPORT_BIN_FILE("sayingsOffset.bin", sayingsOffset);
+IMPORT_BIN_FILE("sayings.bin", sayings);
 
 /*---------------------------------------------------------------------------*/
 /*                                Image Data                                 */
@@ -71,6 +70,7 @@ PROGMEM static const byte soundError[] = {
     0x98, 0x38, 0x00, 0x64, 0x80, 0x00, 0x64, 0x98, 0x38, 0x01, 0x90, 0x80, 0xF0
 };
 
+// IMA-ADPCM, converted by etc/adpcmconv.go
 #define WAVE_BANANA_LENGTH  8544
 #define WAVE_BANANA_FREQ    8000
 
@@ -80,8 +80,4 @@ extern const byte waveBanana[];
 /*                                Other Data                                 */
 /*---------------------------------------------------------------------------*/
 
-#define SAYINGS_MAX     48
-
-extern const uint8_t sayingsData[];
-extern const uint16_t sayingsOffset[];
-PROGMEM static const char sayingGraphs[] = { ' ', '\'', ',', '-', '?', '.' };
+extern const uint8_t sayings[];
@@ -0,0 +1,152 @@
+package main
+
+/*
+Convert a PCM wave file into 4-bit IMA-ADPCM for playWave() of MyArduboy2.
+
+The source of banana.bin is banana.wav, 8-bit mono at 8000 Hz, which gives
+the same bytes as the committed banana.bin:
+
+	go run adpcmconv.go banana.wav ../banana.bin
+
+The LENGTH and FREQ defines for data.h are printed.
+
+Usage: go run adpcmconv.go <input.wav> <output.bin>
+*/
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"strings"
+)
+
+const stepIndexMax = 88
+
+var stepTable = [stepIndexMax + 1]int{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+	11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+	32767,
+}
+
+var indexTable = [8]int{-1, -1, -1, -1, 2, 4, 6, 8}
+
+func main() {
+	if len(os.Args) < 3 {
+		fmt.Fprintf(os.Stderr, "Usage: %s <input.wav> <output.bin>\n", os.Args[0])
+		os.Exit(1)
+	}
+	samples, frequency, err := readWave(os.Args[1])
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	if err := ioutil.WriteFile(os.Args[2], encode(samples), 0644); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	name := strings.ToUpper(strings.TrimSuffix(filepath.Base(os.Args[2]), ".bin"))
+	fmt.Printf("#define WAVE_%s_LENGTH  %d\n", name, len(samples))
+	fmt.Printf("#define WAVE_%s_FREQ    %d\n", name, frequency)
+}
+
+// readWave returns the samples of a PCM wave file as signed 16-bit mono values.
+func readWave(path string) ([]int, int, error) {
+	data, err := ioutil.ReadFile(path)
+	if err != nil {
+		return nil, 0, err
+	}
+	if len(data) < 12 || string(data[0:4]) != "RIFF" || string(data[8:12]) != "WAVE" {
+		return nil, 0, errors.New("Not a wave file")
+	}
+	var channels, bits, frequency int
+	for pos := 12; pos+8 <= len(data); {
+		id := string(data[pos : pos+4])
+		size := int(binary.LittleEndian.Uint32(data[pos+4 : pos+8]))
+		body := data[pos+8 : min(pos+8+size, len(data))]
+		switch id {
+		case "fmt ":
+			if binary.LittleEndian.Uint16(body[0:2]) != 1 {
+				return nil, 0, errors.New("Only linear PCM is supported")
+			}
+			channels = int(binary.LittleEndian.Uint16(body[2:4]))
+			frequency = int(binary.LittleEndian.Uint32(body[4:8]))
+			bits = int(binary.LittleEndian.Uint16(body[14:16]))
+		case "data":
+			if channels == 0 || (bits != 8 && bits != 16) {
+				return nil, 0, errors.New("Only 8 or 16 bits PCM is supported")
+			}
+			bytesPerFrame := channels * bits / 8
+			samples := make([]int, len(body)/bytesPerFrame)
+			for i := range samples {
+				sum := 0
+				for c := 0; c < channels; c++ {
+					p := i*bytesPerFrame + c*bits/8
+					if bits == 8 {
+						sum += (int(body[p]) - 128) << 8
+					} else {
+						sum += int(int16(binary.LittleEndian.Uint16(body[p : p+2])))
+					}
+				}
+				samples[i] = sum / channels
+			}
+			return samples, frequency, nil
+		}
+		pos += 8 + size + size&1
+	}
+	return nil, 0, errors.New("No data chunk")
+}
+
+// encode packs the samples into 4-bit IMA-ADPCM codes, lower nibble first.
+// The decoder starts with predictor 0 and step index 0, so no header is needed.
+func encode(samples []int) []byte {
+	ret := make([]byte, (len(samples)+1)/2)
+	predictor, stepIndex := 0, 0
+	for i, sample := range samples {
+		step := stepTable[stepIndex]
+		diff := sample - predictor
+		code := 0
+		if diff < 0 {
+			code = 8
+			diff = -diff
+		}
+		if diff >= step {
+			code |= 4
+			diff -= step
+		}
+		if diff >= step>>1 {
+			code |= 2
+			diff -= step >> 1
+		}
+		if diff >= step>>2 {
+			code |= 1
+		}
+
+		/*  Track the decoder exactly  */
+		delta := step >> 3
+		if code&4 != 0 {
+			delta += step
+		}
+		if code&2 != 0 {
+			delta += step >> 1
+		}
+		if code&1 != 0 {
+			delta += step >> 2
+		}
+		if code&8 != 0 {
+			predictor = max(predictor-delta, -32768)
+		} else {
+			predictor = min(predictor+delta, 32767)
+		}
+		stepIndex = min(max(stepIndex+indexTable[code&7], 0), stepIndexMax)
+
+		ret[i/2] |= byte(code << uint(i&1*4))
+	}
+	return ret
+}
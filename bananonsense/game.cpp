@@ -1,5 +1,6 @@
 #include "common.h"
 #include "data.h"
+#include "MyCorpus.h"
 
 /*  Defines  */
 
@@ -33,7 +34,6 @@ enum LETTER_T : uint8_t {
 #define BITS_PER_LETTER 2
 #define TARGET_PATTERN  0x998 // "BANANA" = 0b100110011000
 #define TIMER_MAX       (FPS * 30) // 30 seconds
-#define BITS_PER_SAYING 5
 
 /*  Typedefs  */
 
@@ -50,7 +50,7 @@ static void handleInterlude(void);
 static void handleGameOver(void);
 
 static void setupWave(void);
-static void setupMessage(uint8_t idx);
+static void setupMessage(uint16_t idx);
 static void setupField(void);
 static void updateField(void);
 static bool isTarget(int8_t x, int8_t y);
@@ -92,6 +92,7 @@ static int16_t timer;
 static uint8_t score;
 static int8_t targetX, targetY, cursorX, cursorY, offsetX, offsetY;
 static char message[80];
+static MyCorpus sayingsCorpus;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -99,6 +100,7 @@ static char message[80];
 
 void initGame(void)
 {
+    sayingsCorpus.setup(sayings);
     score = 0;
     setupWave();
 }
@@ -236,7 +238,7 @@ static void setupWave(void)
         strcpy_P(message, PSTR("MOVE THE CURSOR AND FIND \"BANANA\"."));
     } else {
         ab.playWave(WAVE_BANANA_FREQ, waveBanana, WAVE_BANANA_LENGTH, SND_PRIO_BANANA);
-        setupMessage(random(SAYINGS_MAX));
+        setupMessage(random(sayingsCorpus.getCount()));
     }
     setupField();
     state = STATE_START;
@@ -244,25 +246,11 @@ static void setupWave(void)
     isInvalid = true;
 } 
 
-static void setupMessage(uint8_t idx)
+static void setupMessage(uint16_t idx)
 {
-    uint16_t bitOffset = pgm_read_word(&sayingsOffset[idx]) * BITS_PER_SAYING;
-    const uint8_t *pSrc = &sayingsData[bitOffset >> 3]; // bitOffset / 8
-    uint8_t bits = bitOffset & 7; // bitOffset % 8
-    uint16_t data = pgm_read_byte(pSrc++) >> bits;
-    bits = 8 - bits;
+    sayingsCorpus.seek(idx);
     char *pDest = message;
-    while (true) {
-        if (bits < BITS_PER_SAYING) {
-            data |= pgm_read_byte(pSrc++) << bits;
-            bits += 8;
-        }
-        uint8_t a = data & maskbits(BITS_PER_SAYING);
-        *pDest++ = (a < 26) ? a + 'A' : pgm_read_byte(&sayingGraphs[a - 26]);
-        data >>= BITS_PER_SAYING;
-        bits -= BITS_PER_SAYING;
-        if (a == maskbits(BITS_PER_SAYING)) break;
-    }
+    while (pDest < message + sizeof(message) - 1 && (*pDest = sayingsCorpus.next())) pDest++;
     *pDest = '\0';
 }
 
@@ -30,11 +30,6 @@ enum {
 
 /*  Typedefs  */
 
-typedef struct {
-    int16_t x, y;
-    int8_t  vx, vy;
-} BOX;
-
 typedef struct {
     int8_t x, y;
 } SNOW;
@@ -46,8 +41,8 @@ static void moveCat(void);
 static void initBoxes(void);
 static void throwFirstBox(void);
 static void moveBoxes(void);
-static void boundBox(BOX *pBox, int gap);
-static int  getNewBoxIndex(void);
+static void boundBox(int idx, int gap);
+static void removeBox(int idx);
 static void initSnows(void);
 static void moveSnows(void);
 
@@ -266,8 +261,9 @@ static bool     isHiscore;
 static uint8_t  catX;
 static uint8_t  catAnim;
 static uint8_t  meowY;
-static uint8_t  boxCnt, boxIdx;
-static BOX      boxAry[BOXES];
+static uint8_t  boxCnt; // Live boxes are packed at the head of the arrays
+static int16_t  boxX[BOXES], boxY[BOXES];
+static int8_t   boxVx[BOXES], boxVy[BOXES];
 static SNOW     snowAry[SNOWS];
 
 /*---------------------------------------------------------------------------*/
@@ -404,50 +400,44 @@ static void moveCat(void)
 
 static void initBoxes(void)
 {
-    for (int i = 0; i < BOXES; i++) {
-        boxAry[i].x = -1;
-    }
     boxCnt = 0;
-    boxIdx = 0;
 }
 
 static void throwFirstBox(void)
 {
-    BOX *pBox = &boxAry[0];
-    pBox->x = coord(64);
-    pBox->y = coord(32);
-    pBox->vx = 0;
-    pBox->vy = -64;
+    boxX[0] = coord(64);
+    boxY[0] = coord(32);
+    boxVx[0] = 0;
+    boxVy[0] = -64;
     boxCnt = 1;
 }
 
 static void moveBoxes(void)
 {
     boolean isBound = false;
-    for (int i = 0; i < BOXES; i++) {
-        BOX *pBox = &boxAry[i];
-        if (pBox->x < 0) continue;
-        uint16_t lastY = pBox->y;
-        pBox->x += pBox->vx;
-        pBox->y += pBox->vy;
-        pBox->vy++;
-
-        if (pBox->x < coord(4)) {
-            pBox->x = coord(4);
-            pBox->vx = -pBox->vx * 3 / 4;
-        } else if (pBox->x > coord(124)) {
-            pBox->x = coord(124);
-            pBox->vx = -pBox->vx * 3 / 4;
+
+    /*  Backward not to move new boxes and ones moved by removeBox() twice  */
+    for (int i = boxCnt - 1; i >= 0; i--) {
+        uint16_t lastY = boxY[i];
+        boxX[i] += boxVx[i];
+        boxY[i] += boxVy[i];
+        boxVy[i]++;
+
+        if (boxX[i] < coord(4)) {
+            boxX[i] = coord(4);
+            boxVx[i] = -boxVx[i] * 3 / 4;
+        } else if (boxX[i] > coord(124)) {
+            boxX[i] = coord(124);
+            boxVx[i] = -boxVx[i] * 3 / 4;
         }
 
-        int gap = pBox->x - coord(catX);
-        if (timer > 0 && pBox->y >= coord(60) && lastY < coord(60) && abs(gap) <= coord(10)) {
-            boundBox(pBox, coordInv(gap));
+        int gap = boxX[i] - coord(catX);
+        if (timer > 0 && boxY[i] >= coord(60) && lastY < coord(60) && abs(gap) <= coord(10)) {
+            boundBox(i, coordInv(gap));
             isBound = true;
             score++;
-        } else if (pBox->y > coord(70)) {
-            pBox->x = -1;
-            boxCnt--;
+        } else if (boxY[i] > coord(70)) {
+            removeBox(i);
         }
     }
 
@@ -458,11 +448,11 @@ static void moveBoxes(void)
     }
 }
 
-static void boundBox(BOX *pBox, int gap)
+static void boundBox(int idx, int gap)
 {
-    int16_t x = pBox->x;
-    int8_t  vx = pBox->vx;
-    int8_t  vy = -pBox->vy / 2;
+    int16_t x = boxX[idx];
+    int8_t  vx = boxVx[idx];
+    int8_t  vy = -boxVy[idx] / 2;
 
     int mul = 2;
     if (timer > secs(30)) {
@@ -474,22 +464,22 @@ static void boundBox(BOX *pBox, int gap)
     }
     for (int i = 0; i < mul; i++, gap += 8) {
         if (i > 0 && boxCnt < BOXES) {
-            pBox = &boxAry[getNewBoxIndex()];
-            pBox->x = x;
-            boxCnt++;
+            idx = boxCnt++;
+            boxX[idx] = x;
         }
-        pBox->y = coord(60);
-        pBox->vx = vx + gap;
-        pBox->vy = vy - (40 - abs(gap));
+        boxY[idx] = coord(60);
+        boxVx[idx] = vx + gap;
+        boxVy[idx] = vy - (40 - abs(gap));
     }
 }
 
-static int getNewBoxIndex(void)
+static void removeBox(int idx)
 {
-    do {
-        boxIdx = (boxIdx + 1) % BOXES;
-    } while (boxAry[boxIdx].x >= 0);
-    return boxIdx;
+    boxCnt--;
+    boxX[idx] = boxX[boxCnt];
+    boxY[idx] = boxY[boxCnt];
+    boxVx[idx] = boxVx[boxCnt];
+    boxVy[idx] = boxVy[boxCnt];
 }
 
 static void initSnows(void)
@@ -534,11 +524,9 @@ static void drawSantaClaus(void)
 
 static void drawBoxes(void)
 {
-    for (int i = 0; i < BOXES; i++) {
-        BOX *pBox = &boxAry[i];
-        if (pBox->x < 0) continue;
-        int16_t x = coordInv(pBox->x) - 4;
-        int16_t y = coordInv(pBox->y) - 4;
+    for (int i = 0; i < boxCnt; i++) {
+        int16_t x = coordInv(boxX[i]) - 4;
+        int16_t y = coordInv(boxY[i]) - 4;
         int8_t anim = x % 6;
         arduboy.drawBitmap(x, y, imgBox[anim], 8, 8, WHITE);
     }
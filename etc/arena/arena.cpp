@@ -0,0 +1,261 @@
+/*
+ * Self-play arena of the CPUs of reversi and quarto.
+ *
+ * Two engines, which arena.sh builds from any copies of game.cpp, play pairs
+ * of games from the same opening with the sides swapped. Every thread runs its
+ * own processes of the engines, because the game logic keeps its state in
+ * global variables. The score of engine A is reported with the 95% Wilson score
+ * interval, and the nodes and the time per move of each engine.
+ *
+ * Usage: arena [-g games] [-j threads] [-r random plies] [-s seed]
+ *              "<engine A>" <level A> "<engine B>" <level B>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
+#include <math.h>
+#include <mutex>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/*  Typedefs  */
+
+struct ENGINE_T {
+    pid_t   pid;
+    FILE    *pIn, *pOut;
+};
+
+struct REPLY_T {
+    bool            isOver;
+    std::string     position;
+    int             side; // Side to move, or the winner if over
+    unsigned long   nodes;
+    long            micros;
+};
+
+struct STATS_T {
+    long                wins, draws, losses, errors;
+    unsigned long long  nodes[2];
+    std::vector<long>   micros[2];
+};
+
+/*  Local Variables  */
+
+static const char   *engineCommands[2];
+static int          engineLevels[2];
+static int          gamesNum = 1000, threadsNum, randomPlies;
+static unsigned long baseSeed = 1;
+static std::atomic<int> nextPair;
+static std::mutex   statsMutex;
+static STATS_T      stats;
+
+/*---------------------------------------------------------------------------*/
+/*                                  Engines                                  */
+/*---------------------------------------------------------------------------*/
+
+static bool startEngine(ENGINE_T *p, const char *command)
+{
+    int toChild[2], fromChild[2];
+    if (pipe2(toChild, O_CLOEXEC) < 0) return false;
+    if (pipe2(fromChild, O_CLOEXEC) < 0) return false;
+    p->pid = fork();
+    if (p->pid == 0) {
+        dup2(toChild[0], 0);
+        dup2(fromChild[1], 1);
+        execl("/bin/sh", "sh", "-c", command, (char *) NULL);
+        _exit(127);
+    }
+    close(toChild[0]);
+    close(fromChild[1]);
+    p->pIn = fdopen(toChild[1], "w");
+    p->pOut = fdopen(fromChild[0], "r");
+    return p->pid > 0;
+}
+
+static void stopEngine(ENGINE_T *p)
+{
+    fclose(p->pIn);
+    fclose(p->pOut);
+    waitpid(p->pid, NULL, 0);
+}
+
+static bool request(ENGINE_T *p, const std::string &command, REPLY_T *pReply)
+{
+    fprintf(p->pIn, "%s\n", command.c_str());
+    fflush(p->pIn);
+    char line[256], status[8], position[128];
+    if (!fgets(line, sizeof(line), p->pOut)) return false;
+    if (sscanf(line, "%7s %127s %d %lu %ld", status, position, &pReply->side,
+            &pReply->nodes, &pReply->micros) != 5) return false;
+    pReply->isOver = (std::string(status) == "over");
+    pReply->position = position;
+    return pReply->isOver || std::string(status) == "move";
+}
+
+static std::string goCommand(int level, unsigned long seed, const std::string &position)
+{
+    return "go " + std::to_string(level) + " " + std::to_string(seed) + " " + position;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                   Games                                   */
+/*---------------------------------------------------------------------------*/
+
+/*  Returns the winner variant (0: A, 1: B), -1 for a draw or -2 for an error  */
+static int playGame(ENGINE_T *engines, const REPLY_T &opening, int swap, unsigned long seed, STATS_T *pStats)
+{
+    REPLY_T reply = opening;
+    for (int ply = 0; !reply.isOver; ply++) {
+        int v = reply.side ^ swap;
+        if (!request(&engines[v], goCommand(engineLevels[v], seed + ply, reply.position), &reply)) return -2;
+        pStats->nodes[v] += reply.nodes;
+        pStats->micros[v].push_back(reply.micros);
+    }
+    return (reply.side < 0) ? -1 : reply.side ^ swap;
+}
+
+static void worker(void)
+{
+    ENGINE_T engines[2];
+    for (int v = 0; v < 2; v++) {
+        if (!startEngine(&engines[v], engineCommands[v])) {
+            perror(engineCommands[v]);
+            exit(1);
+        }
+    }
+    for (int pair; (pair = nextPair++) < gamesNum / 2; ) {
+        STATS_T pairStats = {};
+        unsigned long seed = (baseSeed + pair) * 1000003UL;
+
+        /*  Opening by random moves, retried while the game ends in it  */
+        REPLY_T opening;
+        bool isValid = false;
+        for (int retry = 0; !isValid && retry < 16; retry++) {
+            isValid = request(&engines[0], "init " + std::to_string(seed + retry * 1000), &opening);
+            for (int ply = 0; isValid && !opening.isOver && ply < randomPlies; ply++) {
+                isValid = request(&engines[0], goCommand(0, seed + retry * 1000 + ply, opening.position), &opening);
+            }
+            isValid = isValid && !opening.isOver;
+        }
+
+        for (int swap = 0; swap < 2; swap++) {
+            int winner = (isValid) ? playGame(engines, opening, swap, seed + 500 + swap * 250, &pairStats) : -2;
+            if (winner == 0) pairStats.wins++;
+            if (winner == 1) pairStats.losses++;
+            if (winner == -1) pairStats.draws++;
+            if (winner == -2) pairStats.errors++;
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.wins += pairStats.wins;
+        stats.draws += pairStats.draws;
+        stats.losses += pairStats.losses;
+        stats.errors += pairStats.errors;
+        for (int v = 0; v < 2; v++) {
+            stats.nodes[v] += pairStats.nodes[v];
+            stats.micros[v].insert(stats.micros[v].end(), pairStats.micros[v].begin(), pairStats.micros[v].end());
+        }
+        long done = stats.wins + stats.draws + stats.losses + stats.errors;
+        if (done % 100 == 0) fprintf(stderr, "\r%ld / %d games", done, gamesNum);
+    }
+    for (int v = 0; v < 2; v++) stopEngine(&engines[v]);
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Report                                   */
+/*---------------------------------------------------------------------------*/
+
+/*  A score of 0 or 1 is taken as half a game from it, not to be infinite  */
+static double toElo(double score, long games)
+{
+    score = std::min(std::max(score, 0.5 / games), 1.0 - 0.5 / games);
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+static double percentile(const std::vector<long> &sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    return sorted[std::min((size_t) (p * sorted.size()), sorted.size() - 1)] / 1000.0;
+}
+
+static void report(void)
+{
+    long games = stats.wins + stats.draws + stats.losses;
+    if (games == 0) {
+        fprintf(stderr, "No games were played (%ld errors)\n", stats.errors);
+        exit(1);
+    }
+    double score = (stats.wins + stats.draws * 0.5) / games;
+
+    /*  Wilson score interval as of wins only, a little wider than draws need  */
+    double z2n = 1.96 * 1.96 / games;
+    double center = (score + z2n / 2.0) / (1.0 + z2n);
+    double margin = sqrt(score * (1.0 - score) * z2n + z2n * z2n / 4.0) / (1.0 + z2n);
+    double lower = std::max(center - margin, 0.0), upper = std::min(center + margin, 1.0);
+    printf("games=%ld A wins=%ld draws=%ld losses=%ld errors=%ld\n",
+            games, stats.wins, stats.draws, stats.losses, stats.errors);
+    printf("A score=%.3f [%.3f, %.3f] elo=%+.0f [%+.0f, %+.0f]\n", score, lower, upper,
+            toElo(score, games), toElo(lower, games), toElo(upper, games));
+    printf("%-4s %-8s %12s %10s %10s %10s %10s %10s\n",
+            "", "level", "nodes/move", "avg ms", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    for (int v = 0; v < 2; v++) {
+        std::vector<long> &micros = stats.micros[v];
+        std::sort(micros.begin(), micros.end());
+        double sum = 0;
+        for (long m : micros) sum += m;
+        size_t moves = std::max(micros.size(), (size_t) 1);
+        printf("%-4s %-8d %12.0f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                (v == 0) ? "A" : "B", engineLevels[v], (double) stats.nodes[v] / moves,
+                sum / moves / 1000.0, percentile(micros, 0.5), percentile(micros, 0.9),
+                percentile(micros, 0.99), percentile(micros, 1.0));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    threadsNum = std::max((int) std::thread::hardware_concurrency(), 1);
+    int opt;
+    while ((opt = getopt(argc, argv, "g:j:r:s:")) != -1) {
+        switch (opt) {
+        case 'g':
+            gamesNum = atoi(optarg);
+            break;
+        case 'j':
+            threadsNum = std::max(atoi(optarg), 1);
+            break;
+        case 'r':
+            randomPlies = atoi(optarg);
+            break;
+        case 's':
+            baseSeed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            optind = argc;
+            break;
+        }
+    }
+    if (argc - optind != 4) {
+        fprintf(stderr, "Usage: %s [-g games] [-j threads] [-r random plies] [-s seed] "
+                "\"<engine A>\" <level A> \"<engine B>\" <level B>\n", argv[0]);
+        return 2;
+    }
+    for (int v = 0; v < 2; v++) {
+        engineCommands[v] = argv[optind + v * 2];
+        engineLevels[v] = atoi(argv[optind + v * 2 + 1]);
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsNum; i++) threads.emplace_back(worker);
+    for (std::thread &t : threads) t.join();
+    fprintf(stderr, "\n");
+    report();
+    return 0;
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+
+# Build the engines of two variants of a game and let them play in the arena.
+# A variant is "[<directory>:]<level>", where the directory holds the
+# game.cpp to build, e.g. a git worktree of another revision; it defaults to
+# the game in this tree.
+#
+# Usage: etc/arena/arena.sh [arena options] <reversi|quarto> <variant A> <variant B>
+#   e.g. etc/arena/arena.sh -g 2000 -r 8 reversi /tmp/base/reversi:4 4
+# Engine options, such as "-2" of quarto, are given by ENGINE_OPTIONS.
+
+ARENA_DIR=`dirname $0`
+BUILD_DIR="${ARENA_DIR}/_build"
+CXX=${CXX:-c++}
+CXXFLAGS='-O2 -std=gnu++11 -w'
+
+options=()
+while [ $# -gt 3 ]
+do
+	options+=("$1")
+	shift
+done
+if [ $# -ne 3 ] || [ ! -f "${ARENA_DIR}/$1.cpp" ]
+then
+	sed -n 's/^# \{0,1\}//;/^Usage/,$p' $0 | sed '/^$/q' >&2
+	exit 2
+fi
+game=$1
+mkdir -p ${BUILD_DIR} || exit 1
+
+if [ ! -x ${BUILD_DIR}/arena ] || [ ${ARENA_DIR}/arena.cpp -nt ${BUILD_DIR}/arena ]
+then
+	${CXX} ${CXXFLAGS} -pthread -o ${BUILD_DIR}/arena ${ARENA_DIR}/arena.cpp || exit 1
+fi
+
+args=()
+for i in A B
+do
+	variant=$2
+	shift
+	dir=${game}
+	level=${variant##*:}
+	[ "${variant}" != "${level}" ] && dir=${variant%:*}
+	source=`cd ${dir} 2>/dev/null && pwd`/game.cpp
+	if [ ! -f ${source} ]
+	then
+		echo "No game.cpp in \"${dir}\"" >&2
+		exit 1
+	fi
+	engine="${BUILD_DIR}/${game}_${i}"
+	echo "--- ${i}: ${source} level ${level}" >&2
+	${CXX} ${CXXFLAGS} -I${ARENA_DIR}/include -DGAME_SOURCE="\"${source}\"" \
+			-o ${engine} ${ARENA_DIR}/${game}.cpp || exit 1
+	args+=("${engine} ${ENGINE_OPTIONS}" ${level})
+done
+
+${BUILD_DIR}/arena "${options[@]}" "${args[@]}"
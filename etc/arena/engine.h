@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+ * Common part of the arena engines, included after the game source.
+ *
+ * An engine keeps no game between commands. Each command line carries the
+ * whole position as a token without spaces, and each reply carries the
+ * position after the move:
+ *
+ *   init <seed>                    -> move <position> <side> 0 0
+ *   go <level> <seed> <position>   -> move <position> <side> <nodes> <micros>
+ *                                     over <position> <winner> <nodes> <micros>
+ *
+ * <side> is the player to move next (0: first player, 1: second player),
+ * <winner> is 0, 1 or -1 for a draw. Level 0 plays a random legal move.
+ */
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+
+/*  Implemented by each engine  */
+
+static bool initEngine(int argc, char *argv[]);
+static void initPosition(void);
+static bool readPosition(const char *p);
+static void writePosition(char *p);
+static int  getSide(void);
+static int  playMove(int level); // Returns -2 if the game goes on, or the winner
+
+/*  Stubs of MyArduboy and common.cpp  */
+
+uint8_t         Arduboy::sBuffer[WIDTH * HEIGHT / 8];
+unsigned long   arenaNodes;
+MyArduboy       arduboy;
+RECORD_T        record;
+bool            isRecordDirty, isInvalid;
+int8_t          padX, padY, padRepeatCount;
+
+static std::mt19937 arenaRandom;
+
+void randomSeed(unsigned long seed) { arenaRandom.seed(seed); }
+long random(long howBig) { return (howBig > 0) ? (long) (arenaRandom() % howBig) : 0; }
+long random(long howSmall, long howBig) { return howSmall + random(howBig - howSmall); }
+
+void    MyArduboy::beginNoLogo(void) {}
+bool    MyArduboy::nextFrame(void) { return true; }
+bool    MyArduboy::buttonDown(uint8_t buttons) { return false; }
+bool    MyArduboy::buttonPressed(uint8_t buttons) { return false; }
+bool    MyArduboy::buttonUp(uint8_t buttons) { return false; }
+void    MyArduboy::setTextColor(uint8_t color) {}
+void    MyArduboy::setTextColor(uint8_t color, uint8_t bg) {}
+size_t  MyArduboy::printEx(int16_t x, int16_t y, const char *p) { return 0; }
+size_t  MyArduboy::printEx(int16_t x, int16_t y, const __FlashStringHelper *p) { return 0; }
+size_t  MyArduboy::write(uint8_t c) { return 1; }
+void    MyArduboy::drawRect2(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color) {}
+void    MyArduboy::drawFastVLine2(int16_t x, int16_t y, int8_t h, uint8_t color) {}
+void    MyArduboy::drawFastHLine2(int16_t x, int16_t y, uint8_t w, uint8_t color) {}
+void    MyArduboy::fillRect2(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color) {}
+bool    MyArduboy::isAudioEnabled(void) { return false; }
+void    MyArduboy::setAudioEnabled(bool on) {}
+void    MyArduboy::saveAudioOnOff(void) {}
+void    MyArduboy::playScore2(const byte *score, uint8_t priority) {}
+void    MyArduboy::stopScore2(void) {}
+
+void    readRecord(void) {}
+void    writeRecord(void) {}
+void    clearRecord(void) {}
+void    handleDPad(void) { padX = padY = 0; }
+void    drawNumber(int16_t x, int16_t y, int32_t value) {}
+void    drawTime(int16_t x, int16_t y, uint32_t frames) {}
+void    setSound(bool on) {}
+void    playSoundTick(void) {}
+void    playSoundClick(void) {}
+void    clearMenuItems(void) {}
+void    addMenuItem(const __FlashStringHelper *label, void (*func)(void)) {}
+int8_t  getMenuItemPos(void) { return 0; }
+int8_t  getMenuItemCount(void) { return 0; }
+void    setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f, bool s) {}
+void    setMenuItemPos(int8_t pos) {}
+void    handleMenu(void) {}
+void    drawMenuItems(bool isForced) {}
+
+/*---------------------------------------------------------------------------*/
+
+static void replyPosition(int winner, unsigned long nodes, long micros)
+{
+    char position[128];
+    writePosition(position);
+    if (winner == -2) {
+        printf("move %s %d %lu %ld\n", position, getSide(), nodes, micros);
+    } else {
+        printf("over %s %d %lu %ld\n", position, winner, nodes, micros);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    char line[256], position[128];
+    unsigned long seed;
+    int level;
+    if (!initEngine(argc, argv)) {
+        fprintf(stderr, "Usage: %s [options]\n", argv[0]);
+        return 2;
+    }
+    while (fgets(line, sizeof(line), stdin)) {
+        if (sscanf(line, "init %lu", &seed) == 1) {
+            randomSeed(seed);
+            initPosition();
+            replyPosition(-2, 0, 0);
+        } else if (sscanf(line, "go %d %lu %127s", &level, &seed, position) == 3 && readPosition(position)) {
+            randomSeed(seed);
+            arenaNodes = 0;
+            auto start = std::chrono::steady_clock::now();
+            int winner = playMove(level);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            replyPosition(winner, arenaNodes,
+                    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        } else {
+            printf("error %s", line);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
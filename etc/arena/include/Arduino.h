@@ -0,0 +1,47 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build the game logic on the host.
+ * millis() never advances, so the CPU is never interrupted, and it counts the
+ * calls instead, which are made once per node by the search loops.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+typedef uintptr_t   uint_farptr_t;
+
+class __FlashStringHelper;
+#define F(s)                ((const __FlashStringHelper *) (s))
+#define PROGMEM
+#define pgm_read_byte(p)    (*(const uint8_t *) (p))
+#define pgm_read_word(p)    (*(const uint16_t *) (p))
+#define pgm_read_dword(p)   (*(const uint32_t *) (p))
+#define pgm_read_ptr(p)     (*(void * const *) (p))
+#define memcpy_P            memcpy
+#define strlen_P            strlen
+#define strlen_PF(p)        strlen((const char *) (p))
+#define _BV(b)              (1 << (b))
+
+#define constrain(v, l, h)  ((v) < (l) ? (l) : ((v) > (h) ? (h) : (v)))
+
+/*  Functions instead of the macros of Arduino, not to break the C++ library  */
+template <typename A, typename B>
+inline auto min(A a, B b) -> typename std::common_type<A, B>::type { return (a < b) ? a : b; }
+template <typename A, typename B>
+inline auto max(A a, B b) -> typename std::common_type<A, B>::type { return (a > b) ? a : b; }
+
+extern unsigned long arenaNodes;
+
+inline unsigned long millis(void) { arenaNodes++; return 0; }
+inline unsigned long micros(void) { return 0; }
+
+void    randomSeed(unsigned long seed);
+long    random(long howBig);
+long    random(long howSmall, long howBig);
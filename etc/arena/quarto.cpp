@@ -0,0 +1,85 @@
+/*
+ * Quarto engine of the arena, built from the game.cpp given by GAME_SOURCE.
+ * The position is the board, the current piece, the rest pieces and the turn
+ * in hexadecimal. Option "-2" enables the 2x2 rule.
+ */
+
+#ifndef GAME_SOURCE
+#define GAME_SOURCE "../../quarto/game.cpp"
+#endif
+#include GAME_SOURCE
+#include "engine.h"
+
+static bool initEngine(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-2") != 0) return false;
+        record.settings |= SETTING_BIT_2x2_RULE;
+    }
+    return true;
+}
+
+static void initPosition(void)
+{
+    memset(&game.board, BOARD_EMPTY, BOARD_SIZE * BOARD_SIZE);
+    game.turn = 0;
+    game.currentPiece = random(PIECE_MAX);
+    game.restPieces = ~(1 << game.currentPiece);
+}
+
+static bool readPosition(const char *p)
+{
+    uint8_t *pBoard = &game.board[0][0];
+    for (uint8_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
+        if (sscanf(p + i * 2, "%2hhx", &pBoard[i]) != 1) return false;
+    }
+    unsigned int currentPiece, restPieces, turn;
+    if (sscanf(p + BOARD_SIZE * BOARD_SIZE * 2, ":%x:%x:%x", &currentPiece, &restPieces, &turn) != 3) return false;
+    game.currentPiece = currentPiece;
+    game.restPieces = restPieces;
+    game.turn = turn;
+    return game.turn < TURN_MAX;
+}
+
+static void writePosition(char *p)
+{
+    uint8_t *pBoard = &game.board[0][0];
+    for (uint8_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
+        sprintf(p + i * 2, "%02x", pBoard[i]);
+    }
+    sprintf(p + BOARD_SIZE * BOARD_SIZE * 2, ":%x:%x:%x", game.currentPiece, game.restPieces, game.turn);
+}
+
+static int getSide(void)
+{
+    return game.turn % 2;
+}
+
+static int playMove(int level)
+{
+    record.cpuLevel = level;
+    if (level == 0) {
+        do {
+            cpuX = random(BOARD_SIZE);
+            cpuY = random(BOARD_SIZE);
+        } while (game.board[cpuY][cpuX] != BOARD_EMPTY);
+        cpuPiece = random(PIECE_MAX);
+    } else {
+        cpuThinking();
+    }
+
+    /*  Place the piece, then give the chosen piece to the opponent  */
+    game.board[cpuY][cpuX] = game.currentPiece;
+    if (isWinMove(&game, cpuX, cpuY, true)) return game.turn % 2;
+    if (game.restPieces == 0) {
+        game.turn++;
+        return -1;
+    }
+    while (!(game.restPieces & 1 << cpuPiece)) {
+        cpuPiece = (cpuPiece + 1) % PIECE_MAX;
+    }
+    game.turn++;
+    game.currentPiece = cpuPiece;
+    game.restPieces &= ~(1 << cpuPiece);
+    return -2;
+}
@@ -0,0 +1,87 @@
+/*
+ * Reversi engine of the arena, built from the game.cpp given by GAME_SOURCE.
+ * The position is the black, white and flag rows in hexadecimal, the turn
+ * and whether the last move was a pass, e.g. "...:0:0".
+ */
+
+#ifndef GAME_SOURCE
+#define GAME_SOURCE "../../reversi/game.cpp"
+#endif
+#include GAME_SOURCE
+#include "engine.h"
+
+static bool initEngine(int argc, char *argv[])
+{
+    return argc == 1;
+}
+
+static void initPosition(void)
+{
+    memset(&board, 0, sizeof(board));
+    board.black[3] = 1 << 3;
+    board.white[3] = 1 << 4;
+    board.black[4] = 1 << 4;
+    board.white[4] = 1 << 3;
+    analyzeBoard(&board);
+}
+
+static bool readPosition(const char *p)
+{
+    memset(&board, 0, sizeof(board));
+    for (int8_t i = 0; i < BOARD_H * 3; i++) {
+        uint8_t *pRow = (i < BOARD_H) ? &board.black[i] : (i < BOARD_H * 2) ? &board.white[i - BOARD_H] : &board.flag[i - BOARD_H * 2];
+        if (sscanf(p + i * 2, "%2hhx", pRow) != 1) return false;
+    }
+    int isWhiteTurn, isLastPassed;
+    if (sscanf(p + BOARD_H * 6, ":%d:%d", &isWhiteTurn, &isLastPassed) != 2) return false;
+    board.isWhiteTurn = isWhiteTurn;
+    board.isLastPassed = isLastPassed;
+    analyzeBoard(&board);
+    return board.numPlaceable > 0;
+}
+
+static void writePosition(char *p)
+{
+    for (int8_t i = 0; i < BOARD_H * 3; i++) {
+        uint8_t row = (i < BOARD_H) ? board.black[i] : (i < BOARD_H * 2) ? board.white[i - BOARD_H] : board.flag[i - BOARD_H * 2];
+        sprintf(p + i * 2, "%02x", row);
+    }
+    sprintf(p + BOARD_H * 6, ":%d:%d", board.isWhiteTurn, board.isLastPassed);
+}
+
+static int getSide(void)
+{
+    return board.isWhiteTurn;
+}
+
+static int playMove(int level)
+{
+    record.cpuLevel = level;
+    if (level == 0) {
+        int n = random(board.numPlaceable);
+        for (int8_t i = 0; i < BOARD_W * BOARD_H; i++) {
+            int8_t x = i & 7, y = i >> 3;
+            if ((~(board.black[y] | board.white[y]) & board.flag[y] & 1 << x) && n-- == 0) {
+                cursorPos.x = x;
+                cursorPos.y = y;
+                placeStone();
+                break;
+            }
+        }
+    } else {
+        aiRandom.setSeed(random(0x7FFFFFFFL));
+        cpuThinking();
+    }
+
+    /*  Toggle the turn, passing if there is no move  */
+    board.isWhiteTurn = !board.isWhiteTurn;
+    board.isLastPassed = false;
+    analyzeBoard(&board);
+    if (!isGameOver(&board) && board.numPlaceable == 0) {
+        board.isWhiteTurn = !board.isWhiteTurn;
+        board.isLastPassed = true;
+        analyzeBoard(&board);
+    }
+    if (!isGameOver(&board)) return -2;
+    return (board.numBlack > board.numWhite) ? 0 : (board.numBlack < board.numWhite) ? 1 : -1;
+}
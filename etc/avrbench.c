@@ -0,0 +1,221 @@
+/*
+ * Measure CPU time per frame of a built .hex image on simavr.
+ *
+ * Frames are delimited by the SPI bursts of display(). The cycles in which
+ * the CPU is awake between two bursts are the cost of the frame; the cycles
+ * spent in the timer 1, 3 and 4 interrupt handlers are counted as audio.
+ *
+ * Usage: avrbench [-f frames] [-i script] [-n name] <hex file>
+ * The script has the same "I state frames" lines as the log of INPUT_RECORD,
+ * where state is the button bits of buttonsState() in hexadecimal.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sim_avr.h>
+#include <sim_hex.h>
+#include <sim_irq.h>
+#include <avr_ioport.h>
+#include <avr_spi.h>
+
+/*  Defines  */
+
+#define CPU_FREQUENCY   16000000UL
+#define FRAME_CYCLES    (CPU_FREQUENCY / 60)
+#define FRAME_GAP       (FRAME_CYCLES / 4)  // Idle SPI longer than this starts a new frame
+#define FRAMES_DEFAULT  1800
+#define FRAMES_SKIP     60                  // Boot and logo
+#define CYCLES_LIMIT    (FRAME_CYCLES * 16) // No display for this long means a hang
+
+#define isAudioVector(v) (((v) >= 16 && (v) <= 20) || ((v) >= 31 && (v) <= 35) || ((v) >= 38 && (v) <= 42))
+
+typedef struct {
+    char    port;
+    uint8_t bit;
+    uint8_t mask;   // Bit of buttonsState()
+} BUTTON_T;
+
+typedef struct {
+    uint8_t state;
+    uint8_t frames;
+} RUN_T;
+
+/*  Local Constants  */
+
+static const BUTTON_T buttons[] = {
+    { 'F', 7, 0x80 }, // Up
+    { 'F', 6, 0x40 }, // Right
+    { 'F', 5, 0x20 }, // Left
+    { 'F', 4, 0x10 }, // Down
+    { 'E', 6, 0x08 }, // A
+    { 'B', 4, 0x04 }, // B
+};
+
+#define BUTTONS_NUM (sizeof(buttons) / sizeof(buttons[0]))
+
+/*  Local Variables  */
+
+static avr_t                *avr;
+static avr_irq_t            *buttonIrqs[BUTTONS_NUM];
+static RUN_T                *runs;
+static int                  runsNum, runIdx, runCount;
+static avr_cycle_count_t    lastSpiCycle, frameStartCycle;
+static avr_cycle_count_t    frameBusy, frameAudio;
+static avr_cycle_count_t    worstBusy, totalBusy, totalAudio;
+static long                 frames, measuredFrames, overFrames;
+static long                 framesMax = FRAMES_DEFAULT;
+
+/*---------------------------------------------------------------------------*/
+
+static void setButtons(uint8_t state)
+{
+    for (int i = 0; i < BUTTONS_NUM; i++) {
+        avr_raise_irq(buttonIrqs[i], !(state & buttons[i].mask)); // Active low
+    }
+}
+
+static void updateInput(void)
+{
+    if (runIdx >= runsNum) return;
+    if (runCount == 0) setButtons(runs[runIdx].state);
+    if (++runCount >= runs[runIdx].frames) {
+        runIdx++;
+        runCount = 0;
+    }
+}
+
+static void finishFrame(void)
+{
+    if (frames >= FRAMES_SKIP) {
+        if (worstBusy < frameBusy) worstBusy = frameBusy;
+        if (frameBusy > FRAME_CYCLES) overFrames++;
+        totalBusy += frameBusy;
+        totalAudio += frameAudio;
+        measuredFrames++;
+    }
+    frames++;
+    frameBusy = frameAudio = 0;
+    updateInput();
+}
+
+static void onSpiOutput(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    if (avr->cycle - lastSpiCycle > FRAME_GAP) {
+        if (frameStartCycle > 0) finishFrame();
+        frameStartCycle = avr->cycle;
+    }
+    lastSpiCycle = avr->cycle;
+}
+
+static int readScript(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) return -1;
+    char line[64];
+    unsigned int state, count;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "I %x %u", &state, &count) != 2 || count == 0) continue;
+        runs = realloc(runs, sizeof(RUN_T) * (runsNum + 1));
+        runs[runsNum].state = state;
+        runs[runsNum].frames = (count > 255) ? 255 : count;
+        runsNum++;
+    }
+    fclose(fp);
+    return runsNum;
+}
+
+static double toMillis(double cycles)
+{
+    return cycles * 1000.0 / CPU_FREQUENCY;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+    const char *name = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:i:n:")) != -1) {
+        switch (opt) {
+        case 'f':
+            framesMax = atol(optarg) + FRAMES_SKIP;
+            break;
+        case 'i':
+            if (readScript(optarg) < 0) {
+                perror(optarg);
+                return 1;
+            }
+            break;
+        case 'n':
+            name = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-f frames] [-i script] [-n name] <hex file>\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "Usage: %s [-f frames] [-i script] [-n name] <hex file>\n", argv[0]);
+        return 2;
+    }
+    if (name == NULL) name = argv[optind];
+
+    /*  Set up the MCU  */
+    ihex_chunk_p chunks;
+    int chunksNum = read_ihex_chunks(argv[optind], &chunks);
+    if (chunksNum <= 0) {
+        fprintf(stderr, "%s: failed to read\n", argv[optind]);
+        return 1;
+    }
+    avr = avr_make_mcu_by_name("atmega32u4");
+    if (avr == NULL) {
+        fprintf(stderr, "atmega32u4 isn't supported\n");
+        return 1;
+    }
+    avr_init(avr);
+    avr->frequency = CPU_FREQUENCY;
+    avr->log = LOG_NONE;
+    for (int i = 0; i < chunksNum; i++) {
+        avr_loadcode(avr, chunks[i].data, chunks[i].size, chunks[i].baseaddr);
+    }
+    free_ihex_chunks(chunks);
+    for (int i = 0; i < BUTTONS_NUM; i++) {
+        buttonIrqs[i] = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(buttons[i].port), buttons[i].bit);
+    }
+    setButtons(0);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_OUTPUT), onSpiOutput, NULL);
+
+    /*  Run and count cycles instruction by instruction  */
+    int state = cpu_Running;
+    while (frames < framesMax && state != cpu_Done && state != cpu_Crashed) {
+        avr_cycle_count_t cycle = avr->cycle;
+        int lastState = avr->state;
+        state = avr_run(avr);
+        if (avr->cycle - lastSpiCycle > CYCLES_LIMIT) {
+            fprintf(stderr, "%s: no display for %.0f ms\n", name, toMillis(CYCLES_LIMIT));
+            break;
+        }
+        if (lastState == cpu_Sleeping) continue; // Skipped to the next wake-up
+        avr_cycle_count_t delta = avr->cycle - cycle;
+        frameBusy += delta;
+        if (avr->interrupts.running_ptr > 0 &&
+                isAudioVector(avr->interrupts.running[avr->interrupts.running_ptr - 1]->vector)) {
+            frameAudio += delta;
+        }
+    }
+
+    /*  Report  */
+    if (measuredFrames == 0) {
+        fprintf(stderr, "%s: no frames measured\n", name);
+        return 1;
+    }
+    double avgBusy = (double) totalBusy / measuredFrames;
+    printf("%-16s frames=%ld worst=%.3f avg=%.3f headroom=%.3f audio=%.3f over=%ld\n",
+            name, measuredFrames, toMillis(worstBusy), toMillis(avgBusy),
+            toMillis((double) FRAME_CYCLES - worstBusy),
+            toMillis((double) totalAudio / measuredFrames), overFrames);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env bash
+
+# Measure the frame time of the built images on simavr and compare them with
+# the baseline. A game regresses when its worst or average frame time grows by
+# more than the tolerance (percent).
+#
+# Usage: etc/avrbench.sh [-u] [<project>...]
+#   -u  Store the results as the new baseline
+# Scripted input for a project is read from etc/avrbench/<project>.txt if any.
+
+BIN_DIR='etc'
+HEX_DIR='_hexs'
+BASELINE="${BIN_DIR}/avrbench_baseline.txt"
+TOLERANCE=${TOLERANCE:-3}
+FRAMES=${FRAMES:-1800}
+BENCH="${BIN_DIR}/avrbench.bin"
+
+update=0
+if [ "$1" = '-u' ]
+then
+	update=1
+	shift
+fi
+
+if [ $# -ge 1 ]
+then
+	projects=$@
+else
+	projects=`cat .circleci/projects.txt`
+fi
+
+if [ ! -x ${BENCH} ] || [ ${BIN_DIR}/avrbench.c -nt ${BENCH} ]
+then
+	flags=`pkg-config --cflags --libs simavr 2>/dev/null || echo "-I/usr/include/simavr -lsimavr -lelf"`
+	cc -O2 -o ${BENCH} ${BIN_DIR}/avrbench.c ${flags} || exit 1
+fi
+
+results=`mktemp`
+trap "rm -f ${results}" EXIT
+for project in ${projects}
+do
+	hex=`ls ${HEX_DIR}/${project}_v*.hex 2>/dev/null | tail -n 1`
+	if [ -z "${hex}" ]
+	then
+		echo "No image of \"${project}\"" >&2
+		exit 1
+	fi
+	script="${BIN_DIR}/avrbench/${project}.txt"
+	options="-f ${FRAMES} -n ${project}"
+	[ -f ${script} ] && options="${options} -i ${script}"
+	${BENCH} ${options} ${hex} >> ${results} || exit 1
+	tail -n 1 ${results}
+done
+
+if [ ${update} -eq 1 ]
+then
+	cp ${results} ${BASELINE}
+	echo "--- Baseline updated"
+	exit 0
+fi
+if [ ! -f ${BASELINE} ]
+then
+	echo "--- No baseline at ${BASELINE}; store one by -u on a known good revision" >&2
+	exit 1
+fi
+
+awk -v tol=${TOLERANCE} '
+	function value(line, key) { match(line, key "=[0-9.]+"); return substr(line, RSTART + length(key) + 1, RLENGTH - length(key) - 1) }
+	NR == FNR { base[$1] = $0; next }
+	!($1 in base) {
+		printf "--- %s: not in the baseline\n", $1
+		failed = 1
+	}
+	($1 in base) {
+		for (i = 1; i <= 2; i++) {
+			key = (i == 1) ? "worst" : "avg"
+			b = value(base[$1], key) + 0; v = value($0, key) + 0
+			if (v > b * (1 + tol / 100)) {
+				printf "--- %s: %s %.3f -> %.3f ms\n", $1, key, b, v
+				failed = 1
+			}
+		}
+	}
+	END { exit failed }
+' ${BASELINE} ${results} || { echo "--- Regression detected" >&2; exit 1; }
+echo "--- No regression"
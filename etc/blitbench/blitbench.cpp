@@ -0,0 +1,245 @@
+/*
+ * Micro-benchmark of the masked and bordered bitmap drawing of MyArduboy2.
+ *
+ * Sprites of the sizes which the games draw are put at every position across
+ * and around the screen over random contents, once by drawBitmapWithMask() or
+ * drawBitmapBordered() and once by the passes of drawBitmap() which they took
+ * the place of: the mask in black and the bitmap in white, or the bitmap in
+ * black at the four neighbours and in white. The screens must match. The
+ * bytes read from PROGMEM and the CPU time per sprite of each way are
+ * reported, and blitbench.sh builds it from the copy of each game.
+ *
+ * With LIB_PACKED defined, the images of the header given by PACKED_IMAGES,
+ * which blitbench.sh makes by etc/imgpack.go from the title images of the
+ * games, are drawn as well, once by drawBitmap() from the raw bytes and once
+ * by drawCompressedBitmap() from the packed ones.
+ *
+ * Build: c++ -O2 -std=gnu++11 -Wall -I etc/blitbench/include \
+ *            -DLIB='"../../ardubullets/MyArduboy2.cpp"' -DLIB_BORDERED \
+ *            -o blitbench etc/blitbench/blitbench.cpp
+ *
+ * Usage: blitbench [-n rounds] [-r seed]
+ */
+
+#include <random>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include LIB
+#ifdef LIB_PACKED
+#include PACKED_IMAGES
+#endif
+
+#ifndef LIB_CLASS
+#define LIB_CLASS   MyArduboy2
+#endif
+
+/*  Defines  */
+
+#define ROUNDS_DEFAULT  20
+#define SPRITE_W_MAX    128
+#define SPRITE_H_MAX    32
+#define SPRITE_SIZE_MAX (SPRITE_W_MAX * SPRITE_H_MAX / 8)
+#define GUARD_SIZE      SPRITE_SIZE_MAX // Filled bytes around a sprite, which must not be drawn
+
+typedef struct {
+    const char  *name;
+    uint8_t     w, h;
+    bool        isBordered;
+} SPRITE_T;
+
+typedef struct {
+    const char      *name;
+    const uint8_t   *raw, *packed;
+    uint16_t        rawSize, packedSize;
+    uint8_t         w, h;
+} IMAGE_T;
+
+typedef struct {
+    unsigned long   reads;
+    double          nanos;
+} RESULT_T;
+
+/*  Global Variables  */
+
+unsigned long pgmReads;
+uint8_t Arduboy2::sBuffer[WIDTH * HEIGHT / 8];
+
+/*  Local Constants  */
+
+static const SPRITE_T sprites[] = {
+    { "knightmove heart",           11, 11, false },
+    { "knightmove knight",          15, 15, false },
+    { "knightmove petit",            9,  7, false },
+    { "evasion player",             16, 16, false },
+    { "evasion figure",             10, 14, false },
+#ifdef LIB_BORDERED
+    { "ardubullets ready",          48, 16, true },
+    { "ardubullets completed",      72, 16, true },
+    { "evasion gameover",          118, 24, true },
+#endif
+};
+
+#ifdef LIB_PACKED
+static const IMAGE_T packedImages[] = { IMAGES };
+#endif
+
+/*  Local Variables  */
+
+static LIB_CLASS        arduboy;
+static uint8_t          images[2][GUARD_SIZE + SPRITE_SIZE_MAX + GUARD_SIZE];
+static uint8_t *const   bitmap = images[0] + GUARD_SIZE;
+static uint8_t *const   mask = images[1] + GUARD_SIZE;
+static uint8_t          screen[WIDTH * HEIGHT / 8];
+static std::mt19937     rng;
+static int              failures;
+static const SPRITE_T   *pSprite;
+#ifdef LIB_PACKED
+static const IMAGE_T    *pImage;
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+static double getThreadNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*  The rows under the height are blank as in the images of the games, and the bytes around
+    the sprite are set, so that reading out of it shows on the screen  */
+static void makeSprite(const SPRITE_T &s)
+{
+    uint8_t pages = (s.h + 7) >> 3;
+    memset(images, 0xFF, sizeof(images));
+    for (int i = 0; i < s.w * pages; i++) {
+        uint8_t blank = (i / s.w == pages - 1 && (s.h & 7)) ? 0xFF << (s.h & 7) : 0;
+        bitmap[i] = rng() & ~blank;
+        mask[i] = (bitmap[i] | rng()) & ~blank;
+    }
+}
+
+static void drawByPasses(int16_t x, int16_t y)
+{
+    const SPRITE_T &s = *pSprite;
+    if (s.isBordered) {
+        for (int i = 1; i <= 7; i += 2) {
+            arduboy.drawBitmap(x + i % 3 - 1, y + i / 3 - 1, bitmap, s.w, s.h, BLACK);
+        }
+    } else {
+        arduboy.drawBitmap(x, y, mask, s.w, s.h, BLACK);
+    }
+    arduboy.drawBitmap(x, y, bitmap, s.w, s.h, WHITE);
+}
+
+static void drawAtOnce(int16_t x, int16_t y)
+{
+    const SPRITE_T &s = *pSprite;
+#ifdef LIB_BORDERED
+    if (s.isBordered) {
+        arduboy.drawBitmapBordered(x, y, bitmap, s.w, s.h);
+        return;
+    }
+#endif
+    arduboy.drawBitmapWithMask(x, y, bitmap, mask, s.w, s.h);
+}
+
+#ifdef LIB_PACKED
+static void drawRaw(int16_t x, int16_t y)
+{
+    arduboy.drawBitmap(x, y, pImage->raw, pImage->w, pImage->h, WHITE);
+}
+
+static void drawPacked(int16_t x, int16_t y)
+{
+    arduboy.drawCompressedBitmap(x, y, pImage->packed, pImage->w, pImage->h, WHITE);
+}
+#endif
+
+/*  Draws at every position by both ways, checks the screens and times each way  */
+static void bench(const char *name, uint8_t w, uint8_t h, void (*const ways[2])(int16_t, int16_t),
+        int rounds, RESULT_T results[2])
+{
+    int16_t pages = (h + 7) >> 3;
+    int16_t xMin = -w - 1, xMax = WIDTH + 1, yMin = -pages * 8 - 1, yMax = HEIGHT + 1;
+    long draws = (long) (xMax - xMin) * (yMax - yMin);
+    for (int16_t y = yMin; y < yMax; y++) {
+        for (int16_t x = xMin; x < xMax; x++) {
+            for (size_t i = 0; i < sizeof(screen); i++) screen[i] = rng();
+            uint8_t expected[sizeof(screen)];
+            memcpy(arduboy.getBuffer(), screen, sizeof(screen));
+            ways[0](x, y);
+            memcpy(expected, arduboy.getBuffer(), sizeof(screen));
+            memcpy(arduboy.getBuffer(), screen, sizeof(screen));
+            ways[1](x, y);
+            if (memcmp(expected, arduboy.getBuffer(), sizeof(screen)) != 0) {
+                if (failures++ < 10) fprintf(stderr, "%s: mismatch at (%d, %d)\n", name, x, y);
+            }
+        }
+    }
+
+    for (int way = 0; way < 2; way++) {
+        pgmReads = 0;
+        double start = getThreadNanos();
+        for (int r = 0; r < rounds; r++) {
+            for (int16_t y = yMin; y < yMax; y++) {
+                for (int16_t x = xMin; x < xMax; x++) {
+                    ways[way](x, y);
+                }
+            }
+        }
+        results[way].nanos = (getThreadNanos() - start) / rounds / draws;
+        results[way].reads = pgmReads / rounds / draws;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+    int rounds = ROUNDS_DEFAULT;
+    unsigned seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+        case 'n': rounds = atoi(optarg);    break;
+        case 'r': seed = atoi(optarg);      break;
+        default:
+            fprintf(stderr, "Usage: %s [-n rounds] [-r seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng.seed(seed);
+
+    static void (*const spriteDraws[2])(int16_t, int16_t) = { drawByPasses, drawAtOnce };
+    printf("%-24s %7s | %12s %8s | %12s %8s\n", "sprite", "size", "passes reads", "ns", "once reads", "ns");
+    for (const SPRITE_T &s : sprites) {
+        RESULT_T results[2];
+        makeSprite(s);
+        pSprite = &s;
+        bench(s.name, s.w, s.h, spriteDraws, rounds, results);
+        char size[8];
+        snprintf(size, sizeof(size), "%dx%d", s.w, s.h);
+        printf("%-24s %7s | %12lu %8.1f | %12lu %8.1f\n", s.name, size,
+                results[0].reads, results[0].nanos, results[1].reads, results[1].nanos);
+    }
+
+#ifdef LIB_PACKED
+    static void (*const imageDraws[2])(int16_t, int16_t) = { drawRaw, drawPacked };
+    printf("%-24s %7s | %12s %8s | %12s %8s | %s\n",
+            "image", "size", "raw reads", "ns", "packed reads", "ns", "bytes");
+    for (const IMAGE_T &img : packedImages) {
+        RESULT_T results[2];
+        pImage = &img;
+        bench(img.name, img.w, img.h, imageDraws, rounds, results);
+        char size[8];
+        snprintf(size, sizeof(size), "%dx%d", img.w, img.h);
+        printf("%-24s %7s | %12lu %8.1f | %12lu %8.1f | %d -> %d\n", img.name, size,
+                results[0].reads, results[0].nanos, results[1].reads, results[1].nanos, img.rawSize, img.packedSize);
+    }
+#endif
+    printf((failures) ? "--- %d mismatches\n" : "--- OK\n", failures);
+    return (failures) ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+
+# Build the blitter bench from the copy of MyArduboy2.cpp, or MyArduboy.cpp
+# of knightmove, of each game which has drawBitmapWithMask(), and run it. For
+# a copy which has drawCompressedBitmap(), the title images of the games are
+# packed by etc/imgpack.go and drawn by it as well.
+#
+# Usage: etc/blitbench/blitbench.sh [blitbench options] [<project>...]
+#   e.g. etc/blitbench/blitbench.sh -n 50 ardubullets knightmove
+
+BENCH_DIR=`dirname $0`
+BUILD_DIR="${BENCH_DIR}/_build"
+CXX=${CXX:-c++}
+CXXFLAGS='-O2 -std=gnu++11 -Wall'
+IMAGES='ardubullets/title.cpp:imgTitle ardubullets/title.cpp:imgSubTitle morse/credit.cpp:imgTitle'
+
+options=()
+while [ $# -gt 0 ] && [ "${1:0:1}" = '-' ]
+do
+	options+=("$1" "$2")
+	shift 2
+done
+
+if [ $# -ge 1 ]
+then
+	projects=$@
+else
+	projects=`grep -l 'drawBitmapWithMask' */MyArduboy*.h | xargs -n 1 dirname`
+fi
+mkdir -p ${BUILD_DIR} || exit 1
+
+# Raw and packed arrays of the images, and the table of them
+packed="${BUILD_DIR}/packed.h"
+if grep -q 'drawCompressedBitmap' `printf '%s/MyArduboy*.h ' ${projects}` 2>/dev/null
+then
+	n=0
+	table=''
+	: > ${packed}
+	for image in ${IMAGES}
+	do
+		src=${image%:*}
+		name=${image#*:}
+		n=$((n + 1))
+		raw=`sed -n "/ ${name}\[/,/};/p" ${src}`
+		pack=`go run ${BENCH_DIR}/../imgpack.go -name ${name} ${src}` || exit 1
+		echo "${raw/ ${name}[/ imgRaw${n}[}" >> ${packed}
+		echo "${pack/ ${name}[/ imgPacked${n}[}" >> ${packed}
+		size=`echo "${raw}" | sed -n '1s/.*\/\/ \([0-9]*\)x\([0-9]*\).*/\1, \2/p'`
+		table+=" \\"$'\n'"    { \"${src%%/*} ${name}\", imgRaw${n}, imgPacked${n}, sizeof(imgRaw${n}), sizeof(imgPacked${n}), ${size} },"
+	done
+	echo "#define IMAGES${table}" >> ${packed}
+fi
+
+failed=0
+for project in ${projects}
+do
+	if [ -f ${project}/MyArduboy2.cpp ]
+	then
+		lib=("-DLIB=\"../../${project}/MyArduboy2.cpp\"")
+	else
+		lib=("-DLIB=\"../../${project}/MyArduboy.cpp\"" -DLIB_CLASS=MyArduboy -DUSE_ARDUBOY2_LIB)
+	fi
+	grep -q 'drawBitmapBordered' ${project}/MyArduboy*.h && lib+=(-DLIB_BORDERED)
+	grep -q 'drawCompressedBitmap' ${project}/MyArduboy*.h && lib+=(-DLIB_PACKED "-DPACKED_IMAGES=\"../../${packed}\"")
+	echo "--- ${project}"
+	${CXX} ${CXXFLAGS} -I ${BENCH_DIR}/include "${lib[@]}" \
+			-o ${BUILD_DIR}/${project} ${BENCH_DIR}/blitbench.cpp || exit 1
+	${BUILD_DIR}/${project} "${options[@]}" || failed=1
+done
+exit ${failed}
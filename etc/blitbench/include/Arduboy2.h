@@ -0,0 +1,123 @@
+#pragma once
+
+/*
+ * Arduboy2 stand-in for the blitter bench: the screen buffer and drawBitmap()
+ * as the library draws, one pass over the buffer for each call, and nothing
+ * else does anything.
+ */
+
+#include <Arduino.h>
+
+#define ARDUBOY_LIB_VER 50201
+
+#define WIDTH   128
+#define HEIGHT  64
+#define BLACK   0
+#define WHITE   1
+#define INVERT  2
+
+#define LEFT_BUTTON     _BV(5)
+#define RIGHT_BUTTON    _BV(6)
+#define UP_BUTTON       _BV(7)
+#define DOWN_BUTTON     _BV(4)
+#define A_BUTTON        _BV(3)
+#define B_BUTTON        _BV(2)
+
+#define PIN_SPEAKER_1   5
+#define PIN_SPEAKER_2   13
+
+class Arduboy2Audio
+{
+public:
+    static void begin(void) {}
+    static void on(void) {}
+    static void off(void) {}
+    static void toggle(void) {}
+    static void saveOnOff(void) {}
+    static bool enabled(void) { return false; }
+};
+
+class Print
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    template <typename T> size_t print(T) { return 0; }
+    template <typename T> size_t print(T, int) { return 0; }
+};
+
+class Arduboy2 : public Print
+{
+public:
+    uint8_t *getBuffer(void) { return sBuffer; }
+    void    clear(void) { memset(sBuffer, 0, sizeof(sBuffer)); }
+    void    setCursor(int16_t, int16_t) {}
+    void    setTextSize(uint8_t) {}
+    void    drawPixel(int16_t x, int16_t y, uint8_t color = WHITE);
+    void    fillRect(int16_t, int16_t, uint8_t, uint8_t, uint8_t = WHITE) {}
+    void    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color = WHITE);
+    void    boot(void) {}
+    void    blank(void) {}
+    void    display(void) {}
+    void    flashlight(void) {}
+    void    systemButtons(void) {}
+    bool    nextFrame(void) { return true; }
+    uint8_t buttonsState(void) { return 0; }
+    Arduboy2Audio audio;
+
+protected:
+    static uint8_t sBuffer[WIDTH * HEIGHT / 8];
+    int16_t cursor_x, cursor_y;
+    uint8_t textColor, textBackground, textSize;
+    bool    textWrap;
+};
+
+inline void Arduboy2::drawPixel(int16_t x, int16_t y, uint8_t color)
+{
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+    uint8_t *p = &sBuffer[(y / 8) * WIDTH + x];
+    *p = (color) ? *p | _BV(y & 7) : *p & ~_BV(y & 7);
+}
+
+/*  Same as drawBitmap() of Arduboy2 5.2.1  */
+inline void Arduboy2::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color)
+{
+    if (x + w <= 0 || x > WIDTH - 1 || y + h <= 0 || y > HEIGHT - 1) return;
+
+    int yOffset = abs(y) % 8;
+    int sRow = y / 8;
+    if (y < 0) {
+        sRow--;
+        yOffset = 8 - yOffset;
+    }
+    int rows = h / 8;
+    if (h % 8 != 0) rows++;
+    for (int a = 0; a < rows; a++) {
+        int bRow = sRow + a;
+        if (bRow > (HEIGHT / 8) - 1) break;
+        if (bRow > -2) {
+            for (int iCol = 0; iCol < w; iCol++) {
+                if (iCol + x > (WIDTH - 1)) break;
+                if (iCol + x >= 0) {
+                    if (bRow >= 0) {
+                        if (color == WHITE) {
+                            sBuffer[(bRow * WIDTH) + x + iCol] |= pgm_read_byte(bitmap + (a * w) + iCol) << yOffset;
+                        } else if (color == BLACK) {
+                            sBuffer[(bRow * WIDTH) + x + iCol] &= ~(pgm_read_byte(bitmap + (a * w) + iCol) << yOffset);
+                        } else {
+                            sBuffer[(bRow * WIDTH) + x + iCol] ^= pgm_read_byte(bitmap + (a * w) + iCol) << yOffset;
+                        }
+                    }
+                    if (yOffset && bRow < (HEIGHT / 8) - 1 && bRow > -2) {
+                        if (color == WHITE) {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] |= pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset);
+                        } else if (color == BLACK) {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] &= ~(pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset));
+                        } else {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] ^= pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+/*
+ * ArduboyPlaytune stand-in for the blitter bench, which plays nothing.
+ */
+
+#include <Arduino.h>
+
+class ArduboyPlaytune
+{
+public:
+    ArduboyPlaytune(bool (*)(void)) {}
+    void    initChannel(uint8_t) {}
+    void    playScore(const byte *) {}
+    void    stopScore(void) {}
+    bool    playing(void) { return false; }
+};
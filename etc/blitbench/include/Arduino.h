@@ -0,0 +1,32 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build MyArduboy2 and MyArduboy on the host.
+ * Every byte read from PROGMEM is counted.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+
+extern unsigned long pgmReads;
+
+class __FlashStringHelper;
+#define F(s)                ((const __FlashStringHelper *) (s))
+#define PROGMEM
+#define pgm_read_byte(p)    (pgmReads++, *(const uint8_t *) (p))
+#define pgm_read_word(p)    (*(const uint16_t *) (p))
+#define pgm_read_dword(p)   (*(const uint32_t *) (p))
+#define _BV(b)              (1 << (b))
+#define bitRead(v, b)       (((v) >> (b)) & 1)
+
+#define min(a, b)           ((a) < (b) ? (a) : (b))
+#define max(a, b)           ((a) > (b) ? (a) : (b))
+#define constrain(v, l, h)  ((v) < (l) ? (l) : ((v) > (h) ? (h) : (v)))
+
+inline unsigned long millis(void) { return 0; }
+inline unsigned long micros(void) { return 0; }
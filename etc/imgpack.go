@@ -0,0 +1,262 @@
+package main
+
+/*
+Pack a bitmap array of a source file for drawCompressedBitmap() of MyArduboy2.
+
+The bytes are kept in the order of drawBitmap(), a row of 8-pixel pages after
+another, and coded as a sequence of operations:
+
+	0x00-0x3F  literal: (n + 1) bytes follow as they are
+	0x40-0x7F  run: the next byte repeats ((n & 0x3F) + 2) times
+	0x80-0xFF  copy: 1 LLLLL OO and a byte of offset, ((L + 3) bytes)
+	           from ((OO << 8 | offset) + 1) bytes before the offset byte
+
+A copy refers only to bytes of earlier literals, which are stored as they are
+in flash, so the decoder reads them back from PROGMEM and needs no buffer.
+Copies take the longest match, runs win over shorter copies, and the result is
+verified by decoding.
+
+Packing pays only when the bytes saved are more than the code of the decoder
+which the game links, so it is for big images or many of them. The title
+images of ardubullets and morse save 146 and 47 bytes, and are kept raw.
+etc/blitbench/blitbench.sh compares the drawing of them both ways.
+
+With -d, a packed array is decoded back to the raw bytes for editing.
+
+Usage: go run imgpack.go [-d] -name <array name> <source file>
+*/
+
+import (
+	"flag"
+	"fmt"
+	"os"
+	"regexp"
+	"strconv"
+	"strings"
+)
+
+const (
+	literalMax = 64
+	runMin     = 2
+	runMax     = 65
+	copyMin    = 3
+	copyMax    = 34
+	offsetMax  = 1024
+)
+
+/*---------------------------------------------------------------------------*/
+/*                                Source File                                */
+/*---------------------------------------------------------------------------*/
+
+func readArray(path, name string) ([]byte, string, error) {
+	src, err := os.ReadFile(path)
+	if err != nil {
+		return nil, "", err
+	}
+	re := regexp.MustCompile(`(?s)` + regexp.QuoteMeta(name) + `\s*\[[^\]]*\]\s*=\s*\{(.*?)\};`)
+	m := re.FindSubmatchIndex(src)
+	if m == nil {
+		return nil, "", fmt.Errorf("%s: array %q isn't found", path, name)
+	}
+	body := string(src[m[2]:m[3]])
+	comment := ""
+	if i := strings.Index(body, "//"); i >= 0 {
+		comment = strings.TrimSpace(body[i+2 : strings.IndexByte(body[i:]+"\n", '\n')+i])
+	}
+	var data []byte
+	for _, line := range strings.Split(body, "\n") {
+		if i := strings.Index(line, "//"); i >= 0 {
+			line = line[:i]
+		}
+		for _, f := range strings.Split(line, ",") {
+			if f = strings.TrimSpace(f); f == "" {
+				continue
+			}
+			v, err := strconv.ParseUint(f, 0, 8)
+			if err != nil {
+				return nil, "", fmt.Errorf("%s: %v", name, err)
+			}
+			data = append(data, byte(v))
+		}
+	}
+	return data, comment, nil
+}
+
+func printArray(name, comment string, data []byte) {
+	fmt.Printf("PROGMEM static const uint8_t %s[%d] = { // %s\n", name, len(data), comment)
+	for i := 0; i < len(data); i += 16 {
+		var fields []string
+		for _, b := range data[i:min(i+16, len(data))] {
+			fields = append(fields, fmt.Sprintf("0x%02X", b))
+		}
+		sep := ","
+		if i+16 >= len(data) {
+			sep = ""
+		}
+		fmt.Printf("    %s%s\n", strings.Join(fields, ", "), sep)
+	}
+	fmt.Println("};")
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                   Codec                                   */
+/*---------------------------------------------------------------------------*/
+
+type segment struct {
+	addr int // position of the first byte in the packed data
+	raw  []byte
+}
+
+type packer struct {
+	out      []byte
+	segments []segment // literals which copies can refer to
+	literal  int       // position of the header of the open literal, or -1
+	ops      [3]int
+}
+
+func (p *packer) closeLiteral() {
+	if p.literal >= 0 {
+		p.segments = append(p.segments, segment{p.literal + 1, p.out[p.literal+1:]})
+		p.literal = -1
+	}
+}
+
+/*  Longest match of the head of data in the literals within the reach of offsets  */
+func (p *packer) findCopy(data []byte) (int, int) {
+	bestLen, bestAddr := 0, 0
+	offsetPos := len(p.out) + 1
+	segments := p.segments
+	if p.literal >= 0 {
+		segments = append(segments[:len(segments):len(segments)], segment{p.literal + 1, p.out[p.literal+1:]})
+	}
+	for _, s := range segments {
+		for i := range s.raw {
+			if offsetPos-(s.addr+i) > offsetMax {
+				continue
+			}
+			n := 0
+			for n < copyMax && n < len(data) && i+n < len(s.raw) && s.raw[i+n] == data[n] {
+				n++
+			}
+			if n > bestLen {
+				bestLen, bestAddr = n, s.addr+i
+			}
+		}
+	}
+	return bestLen, bestAddr
+}
+
+func pack(data []byte) ([]byte, [3]int) {
+	p := &packer{literal: -1}
+	for i := 0; i < len(data); {
+		run := 1
+		for run < runMax && i+run < len(data) && data[i+run] == data[i] {
+			run++
+		}
+		copyLen, copyAddr := p.findCopy(data[i:])
+		switch {
+		case run >= copyMin && run >= copyLen || run >= runMin && p.literal < 0 && copyLen < copyMin:
+			p.closeLiteral()
+			p.out = append(p.out, byte(0x40+run-runMin), data[i])
+			p.ops[1]++
+			i += run
+		case copyLen >= copyMin:
+			p.closeLiteral()
+			offset := len(p.out) + 1 - copyAddr - 1
+			p.out = append(p.out, byte(0x80|(copyLen-copyMin)<<2|offset>>8), byte(offset))
+			p.ops[2]++
+			i += copyLen
+		default:
+			if p.literal < 0 || p.out[p.literal] == literalMax-1 {
+				p.closeLiteral()
+				p.literal = len(p.out)
+				p.out = append(p.out, 0xFF)
+				p.ops[0]++
+			}
+			p.out[p.literal]++
+			p.out = append(p.out, data[i])
+			i++
+		}
+	}
+	return p.out, p.ops
+}
+
+/*  Same as unpackByte() of MyArduboy2.cpp  */
+func unpack(packed []byte, size int) ([]byte, error) {
+	var out []byte
+	for p := 0; len(out) < size; {
+		if p >= len(packed) {
+			return nil, fmt.Errorf("unexpected end of data")
+		}
+		c := int(packed[p])
+		p++
+		switch {
+		case c < 0x40:
+			if p+c+1 > len(packed) {
+				return nil, fmt.Errorf("unexpected end of data")
+			}
+			out = append(out, packed[p:p+c+1]...)
+			p += c + 1
+		case c < 0x80:
+			if p >= len(packed) {
+				return nil, fmt.Errorf("unexpected end of data")
+			}
+			for n := c - 0x40 + runMin; n > 0; n-- {
+				out = append(out, packed[p])
+			}
+			p++
+		default:
+			if p >= len(packed) {
+				return nil, fmt.Errorf("unexpected end of data")
+			}
+			src := p - ((c&3)<<8 | int(packed[p])) - 1
+			n := (c>>2)&0x1F + copyMin
+			if src < 0 || src+n > p {
+				return nil, fmt.Errorf("copy out of range at %d", p-1)
+			}
+			out = append(out, packed[src:src+n]...)
+			p++
+		}
+	}
+	return out[:size], nil
+}
+
+func main() {
+	decode := flag.Bool("d", false, "decode a packed array back to the raw bytes")
+	size := flag.Int("size", 0, "number of raw bytes for -d (default: from the comment)")
+	name := flag.String("name", "", "name of the array")
+	flag.Parse()
+	if flag.NArg() != 1 || *name == "" {
+		flag.Usage()
+		os.Exit(2)
+	}
+	data, comment, err := readArray(flag.Arg(0), *name)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	if *decode {
+		var w, h int
+		fmt.Sscanf(comment, "%dx%d", &w, &h)
+		if *size == 0 {
+			*size = w * ((h + 7) / 8)
+		}
+		raw, err := unpack(data, *size)
+		if err != nil || *size == 0 {
+			fmt.Fprintf(os.Stderr, "%s: can't decode (%v)\n", *name, err)
+			os.Exit(1)
+		}
+		printArray(*name, strings.TrimSuffix(comment, ", packed"), raw)
+		return
+	}
+
+	packed, ops := pack(data)
+	if raw, err := unpack(packed, len(data)); err != nil || string(raw) != string(data) {
+		fmt.Fprintf(os.Stderr, "%s: verification failed\n", *name)
+		os.Exit(1)
+	}
+	printArray(*name, strings.TrimSuffix(comment, ", packed")+", packed", packed)
+	fmt.Fprintf(os.Stderr, "%s: %d -> %d bytes (%.1f%%), literals %d, runs %d, copies %d\n",
+		*name, len(data), len(packed), float64(len(packed))*100/float64(len(data)), ops[0], ops[1], ops[2])
+}
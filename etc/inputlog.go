@@ -0,0 +1,127 @@
+package main
+
+/*
+Convert a serial log of the input harness into "replay.h".
+
+Build a game with INPUT_RECORD defined in its MyArduboy header, open the serial
+monitor, play, and save the log. The log contains the random seed ("S"), runs
+of button states ("I state frames") and the hash of every frame ("H hash").
+The generated header is included by the same game built with INPUT_REPLAY
+defined, which feeds the buttons frame by frame and reports every frame whose
+hash differs ("E frame") and a summary at the end ("R frames errors").
+
+Usage: go run inputlog.go [-o replay.h] [-hashes=false] <log file>
+*/
+
+import (
+	"bufio"
+	"flag"
+	"fmt"
+	"os"
+	"strconv"
+	"strings"
+)
+
+func main() {
+	out := flag.String("o", "replay.h", "output header")
+	withHashes := flag.Bool("hashes", true, "include frame hashes to verify")
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+
+	f, err := os.Open(flag.Arg(0))
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	defer f.Close()
+
+	var seed uint64
+	var runs [][2]uint64
+	var hashes []uint64
+	frames := uint64(0)
+	scanner := bufio.NewScanner(f)
+	for line := 1; scanner.Scan(); line++ {
+		fields := strings.Fields(scanner.Text())
+		if len(fields) == 0 {
+			continue
+		}
+		var vals []uint64
+		for i, field := range fields[1:] {
+			base := 16
+			if fields[0] == "I" && i == 1 {
+				base = 10
+			}
+			v, err := strconv.ParseUint(field, base, 32)
+			if err != nil {
+				fmt.Fprintf(os.Stderr, "line %d: %v\n", line, err)
+				os.Exit(1)
+			}
+			vals = append(vals, v)
+		}
+		switch {
+		case fields[0] == "S" && len(vals) == 1:
+			if runs != nil || hashes != nil {
+				fmt.Fprintf(os.Stderr, "line %d: only the first session is used\n", line)
+				goto done
+			}
+			seed = vals[0]
+		case fields[0] == "I" && len(vals) == 2 && vals[1] > 0 && vals[1] <= 255:
+			runs = append(runs, [2]uint64{vals[0] & 0xFF, vals[1]})
+			frames += vals[1]
+		case fields[0] == "H" && len(vals) == 1:
+			hashes = append(hashes, vals[0]&0xFFFF)
+		default:
+			fmt.Fprintf(os.Stderr, "line %d: ignored %q\n", line, scanner.Text())
+		}
+	}
+done:
+	if len(runs) == 0 {
+		fmt.Fprintln(os.Stderr, "no button runs found")
+		os.Exit(1)
+	}
+
+	/*  Hashes after the last complete run can't be reproduced  */
+	if !*withHashes {
+		hashes = nil
+	} else if uint64(len(hashes)) > frames {
+		hashes = hashes[:frames]
+	}
+
+	w, err := os.Create(*out)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	defer w.Close()
+	fmt.Fprintf(w, "// Generated by etc/inputlog.go from %s, %d frames in %d runs\n\n",
+		flag.Arg(0), frames, len(runs))
+	fmt.Fprintf(w, "#define INPUT_REPLAY_HASHES %d\n\n", len(hashes))
+	fmt.Fprintf(w, "PROGMEM static const uint8_t inputReplayData[] = {\n")
+	fmt.Fprintf(w, "    0x%02X, 0x%02X, 0x%02X, 0x%02X, // seed\n",
+		seed&0xFF, seed>>8&0xFF, seed>>16&0xFF, seed>>24&0xFF)
+	for i := 0; i < len(runs); i += 8 {
+		fmt.Fprint(w, "   ")
+		for _, r := range runs[i:min(i+8, len(runs))] {
+			fmt.Fprintf(w, " 0x%02X, %d,", r[0], r[1])
+		}
+		fmt.Fprintln(w)
+	}
+	fmt.Fprintf(w, "    0x00, 0 // terminator\n};\n\n")
+	fmt.Fprintf(w, "PROGMEM static const uint16_t inputReplayHashes[] = {\n")
+	for i := 0; i < len(hashes); i += 12 {
+		fmt.Fprint(w, "   ")
+		for _, h := range hashes[i:min(i+12, len(hashes))] {
+			fmt.Fprintf(w, " 0x%04X,", h)
+		}
+		fmt.Fprintln(w)
+	}
+	if len(hashes) == 0 {
+		fmt.Fprintln(w, "    0x0000 // not verified")
+	}
+	fmt.Fprintf(w, "};\n")
+	fmt.Printf("%s: %d frames, %d runs, %d hashes, %d bytes of flash\n",
+		*out, frames, len(runs), len(hashes), 4+len(runs)*2+2+max(len(hashes), 1)*2)
+}
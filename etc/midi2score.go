@@ -0,0 +1,371 @@
+package main
+
+/*
+Compile a standard MIDI file into a MyArduboyPlaytune score.
+
+Notes are assigned to the available channels (the highest notes are kept when
+there are not enough channels), note timings are quantized to milliseconds, and
+phrases repeated 2^n times in a row, optionally transposed by a step of
+tuneNoteTable, are folded with TUNE_OP_MARK and TUNE_OP_REPEAT.
+
+Usage: go run midi2score.go [-chans n] [-duty n] [-name symbol] [-loop] [-literal] <file.mid>
+*/
+
+import (
+	"encoding/binary"
+	"errors"
+	"flag"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+)
+
+const (
+	opPlayNote    = 0x90
+	opStopNote    = 0x80
+	opMark        = 0xD0
+	opRepeat      = 0xE0
+	opStop        = 0xF0
+	waitMax       = 0x7FFF
+	repeatBitsMax = 7 // the players count repeats in a uint8_t against 1 << n
+	drumChannel   = 9
+)
+
+var tuneNoteTable = []int{0, 1, 2, 3, 4, 6, 8, 12, 0, -12, -8, -6, -4, -3, -2, -1}
+
+type noteEvent struct {
+	tick     int
+	on       bool
+	note     int
+	midiChan int
+}
+
+type op struct {
+	code int // opcode with its channel and duty bits
+	note int // -1 if the op has no note
+}
+
+type step struct {
+	ops  []op
+	wait int
+}
+
+func main() {
+	chans := flag.Int("chans", 2, "number of channels (AVAILABLE_CHANNELS)")
+	duty := flag.Int("duty", 2, "duty cycle parameter of notes (2 to 5)")
+	name := flag.String("name", "", "symbol name of the array")
+	loop := flag.Bool("loop", false, "repeat the whole score endlessly")
+	literal := flag.Bool("literal", false, "don't fold repeated phrases")
+	drums := flag.Bool("drums", false, "include MIDI channel 10 (drums)")
+	flag.Parse()
+	if flag.NArg() != 1 || *chans < 1 || *chans > 4 || *duty < 2 || *duty > 5 {
+		flag.Usage()
+		os.Exit(1)
+	}
+	path := flag.Arg(0)
+	if *name == "" {
+		base := strings.TrimSuffix(filepath.Base(path), filepath.Ext(path))
+		*name = "sound" + strings.Title(base)
+	}
+
+	data, err := ioutil.ReadFile(path)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	events, toMsec, err := parseMidi(data, *drums)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	steps := assignChannels(events, toMsec, *chans, *duty)
+	literalScore := encode(steps, false, *loop)
+	score := literalScore
+	if !*literal && !*loop {
+		score = encode(steps, true, false)
+	}
+	fmt.Fprintf(os.Stderr, "%d bytes (literal encoding: %d bytes)\n", len(score), len(literalScore))
+	printArray(*name, score)
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                MIDI parser                                */
+/*---------------------------------------------------------------------------*/
+
+// parseMidi returns note events of all tracks sorted by tick, and a function
+// converting ticks into milliseconds according to the tempo map.
+func parseMidi(data []byte, drums bool) ([]noteEvent, func(int) float64, error) {
+	if len(data) < 14 || string(data[0:4]) != "MThd" {
+		return nil, nil, errors.New("Not a standard MIDI file")
+	}
+	division := int(binary.BigEndian.Uint16(data[12:14]))
+	if division&0x8000 != 0 {
+		return nil, nil, errors.New("SMPTE time division is not supported")
+	}
+	type tempo struct{ tick, usecPerBeat int }
+	tempos := []tempo{{0, 500000}}
+	var events []noteEvent
+
+	pos := 8 + int(binary.BigEndian.Uint32(data[4:8]))
+	for pos+8 <= len(data) {
+		size := int(binary.BigEndian.Uint32(data[pos+4 : pos+8]))
+		if string(data[pos:pos+4]) != "MTrk" {
+			pos += 8 + size
+			continue
+		}
+		track := data[pos+8 : min(pos+8+size, len(data))]
+		pos += 8 + size
+		tick, status := 0, 0
+		for i := 0; i < len(track); {
+			delta, n := readVarLen(track[i:])
+			tick += delta
+			i += n
+			if i >= len(track) {
+				break
+			}
+			if track[i]&0x80 != 0 {
+				status = int(track[i])
+				i++
+			}
+			switch {
+			case status == 0xFF: // meta event
+				if i+1 >= len(track) {
+					return nil, nil, errors.New("Broken meta event")
+				}
+				kind := track[i]
+				length, n := readVarLen(track[i+1:])
+				body := track[i+1+n : min(i+1+n+length, len(track))]
+				if kind == 0x51 && len(body) == 3 {
+					tempos = append(tempos, tempo{tick, int(body[0])<<16 | int(body[1])<<8 | int(body[2])})
+				}
+				i += 1 + n + length
+			case status == 0xF0 || status == 0xF7: // sysex
+				length, n := readVarLen(track[i:])
+				i += n + length
+			case status >= 0x80:
+				kind, ch := status&0xF0, status&0x0F
+				length := 2
+				if kind == 0xC0 || kind == 0xD0 {
+					length = 1
+				}
+				if i+length > len(track) {
+					return nil, nil, errors.New("Broken channel event")
+				}
+				if (kind == 0x80 || kind == 0x90) && (drums || ch != drumChannel) {
+					on := kind == 0x90 && track[i+1] > 0
+					events = append(events, noteEvent{tick, on, int(track[i]), ch})
+				}
+				i += length
+			default:
+				return nil, nil, errors.New("Running status without status byte")
+			}
+		}
+	}
+
+	sort.SliceStable(events, func(a, b int) bool {
+		if events[a].tick != events[b].tick {
+			return events[a].tick < events[b].tick
+		}
+		return !events[a].on && events[b].on // note-offs first
+	})
+	sort.SliceStable(tempos, func(a, b int) bool { return tempos[a].tick < tempos[b].tick })
+	toMsec := func(tick int) float64 {
+		msec := 0.0
+		for j, t := range tempos {
+			end := tick
+			if j+1 < len(tempos) && tempos[j+1].tick < tick {
+				end = tempos[j+1].tick
+			}
+			if end > t.tick {
+				msec += float64(end-t.tick) * float64(t.usecPerBeat) / float64(division) / 1000
+			}
+		}
+		return msec
+	}
+	return events, toMsec, nil
+}
+
+func readVarLen(b []byte) (int, int) {
+	v := 0
+	for i := 0; i < len(b) && i < 4; i++ {
+		v = v<<7 | int(b[i]&0x7F)
+		if b[i]&0x80 == 0 {
+			return v, i + 1
+		}
+	}
+	return v, len(b)
+}
+
+/*---------------------------------------------------------------------------*/
+/*                            Channel assignment                             */
+/*---------------------------------------------------------------------------*/
+
+// assignChannels converts note events into steps of ops followed by a wait.
+func assignChannels(events []noteEvent, toMsec func(int) float64, chans, duty int) []step {
+	type voice struct {
+		busy           bool
+		note, midiChan int
+	}
+	voices := make([]voice, chans)
+	var steps []step
+	var cur step
+	lastMsec := 0
+	for _, e := range events {
+		msec := int(toMsec(e.tick) + 0.5)
+		if wait := msec - lastMsec; wait > 0 { // a rest before the first note is a step without ops
+			cur.wait = wait
+			steps = append(steps, cur)
+			cur = step{}
+			lastMsec = msec
+		}
+		if e.on {
+			c := -1
+			for j := range voices {
+				if !voices[j].busy {
+					c = j
+					break
+				}
+			}
+			if c < 0 { // steal the lowest voice if the new note is higher
+				for j := range voices {
+					if c < 0 || voices[j].note < voices[c].note {
+						c = j
+					}
+				}
+				if voices[c].note >= e.note {
+					continue
+				}
+			}
+			voices[c] = voice{true, e.note, e.midiChan}
+			cur.ops = append(cur.ops, op{opPlayNote | (duty-2)<<2 | c, e.note})
+		} else {
+			for j := range voices {
+				if voices[j].busy && voices[j].note == e.note && voices[j].midiChan == e.midiChan {
+					voices[j].busy = false
+					cur.ops = append(cur.ops, op{opStopNote | j, -1})
+					break
+				}
+			}
+		}
+	}
+	for j := range voices {
+		if voices[j].busy {
+			cur.ops = append(cur.ops, op{opStopNote | j, -1})
+		}
+	}
+	steps = append(steps, cur)
+	return steps
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Encoder                                  */
+/*---------------------------------------------------------------------------*/
+
+func (s step) bytes(pitch int) []byte {
+	var ret []byte
+	for _, o := range s.ops {
+		ret = append(ret, byte(o.code))
+		if o.note >= 0 {
+			ret = append(ret, byte(o.note+pitch))
+		}
+	}
+	for wait := s.wait; wait > 0; wait -= waitMax {
+		w := min(wait, waitMax)
+		ret = append(ret, byte(w>>8), byte(w))
+	}
+	return ret
+}
+
+// matches reports whether b equals a transposed by pitch.
+func matches(a, b []step, pitch int) bool {
+	for i := range a {
+		if a[i].wait != b[i].wait || len(a[i].ops) != len(b[i].ops) {
+			return false
+		}
+		for j, o := range a[i].ops {
+			p := b[i].ops[j]
+			if o.code != p.code || (o.note >= 0 && (o.note+pitch != p.note || o.note+pitch < 0 || o.note+pitch > 127)) {
+				return false
+			}
+		}
+	}
+	return true
+}
+
+func encode(steps []step, fold bool, loop bool) []byte {
+	var ret []byte
+	markPos := 0 // where the player's mark is without an explicit TUNE_OP_MARK
+	for i := 0; i < len(steps); {
+		bestSaved, bestLen, bestBits, bestIdx := 0, 0, 0, 0
+		for l := 1; fold && i+l*2 <= len(steps); l++ {
+			cost := 0
+			for _, s := range steps[i : i+l] {
+				cost += len(s.bytes(0))
+			}
+			for idx, delta := range tuneNoteTable {
+				if idx == 8 {
+					continue // same as index 0
+				}
+				r := 1
+				for i+(r+1)*l <= len(steps) && r < 1<<repeatBitsMax &&
+					matches(steps[i:i+l], steps[i+r*l:i+(r+1)*l], r*delta) {
+					r++
+				}
+				bits := 0
+				for 2<<bits <= r {
+					bits++
+				}
+				if bits == 0 {
+					continue
+				}
+				overhead := 1
+				if idx != 0 || len(ret) != markPos {
+					overhead++
+				}
+				if saved := ((1<<bits)-1)*cost - overhead; saved > bestSaved {
+					bestSaved, bestLen, bestBits, bestIdx = saved, l, bits, idx
+				}
+			}
+		}
+		if bestSaved > 0 {
+			if bestIdx != 0 || len(ret) != markPos {
+				ret = append(ret, byte(opMark|bestIdx))
+			}
+			for _, s := range steps[i : i+bestLen] {
+				ret = append(ret, s.bytes(0)...)
+			}
+			ret = append(ret, byte(opRepeat|bestBits))
+			markPos = len(ret)
+			i += bestLen << bestBits
+		} else {
+			ret = append(ret, steps[i].bytes(0)...)
+			i++
+		}
+	}
+	if loop {
+		return append(ret, opRepeat)
+	}
+	return append(ret, opStop)
+}
+
+func printArray(name string, score []byte) {
+	fmt.Printf("PROGMEM static const byte %s[] = {\n", name)
+	for i := 0; i < len(score); i += 16 {
+		line := score[i:min(i+16, len(score))]
+		fmt.Print("    ")
+		for j, b := range line {
+			fmt.Printf("0x%02X", b)
+			if i+j < len(score)-1 {
+				fmt.Print(",")
+				if j < len(line)-1 {
+					fmt.Print(" ")
+				}
+			}
+		}
+		fmt.Println()
+	}
+	fmt.Println("};")
+}
@@ -0,0 +1,201 @@
+package main
+
+/*
+Tests of midi2score.go on small MIDI files made in memory.
+
+Usage: go test etc/midi2score.go etc/midi2score_test.go
+*/
+
+import (
+	"bytes"
+	"encoding/binary"
+	"testing"
+)
+
+type testNote struct {
+	tick, length, note int
+}
+
+// makeMidi returns a MIDI file of format 0 with 480 ticks per beat at 120 BPM,
+// so a tick is 1.0417 ms and 480 ticks are 500 ms.
+func makeMidi(notes []testNote) []byte {
+	type event struct {
+		tick int
+		msg  []byte
+	}
+	var events []event
+	for _, n := range notes {
+		events = append(events, event{n.tick, []byte{0x90, byte(n.note), 100}})
+		events = append(events, event{n.tick + n.length, []byte{0x80, byte(n.note), 0}})
+	}
+	for i := 1; i < len(events); i++ { // insertion sort keeps note-offs of the same tick first
+		for j := i; j > 0 && (events[j].tick < events[j-1].tick ||
+			events[j].tick == events[j-1].tick && events[j].msg[0] == 0x80 && events[j-1].msg[0] == 0x90); j-- {
+			events[j], events[j-1] = events[j-1], events[j]
+		}
+	}
+	var track []byte
+	last := 0
+	for _, e := range events {
+		track = append(track, varLen(e.tick-last)...)
+		track = append(track, e.msg...)
+		last = e.tick
+	}
+	track = append(track, 0x00, 0xFF, 0x2F, 0x00)
+
+	var b bytes.Buffer
+	b.WriteString("MThd")
+	binary.Write(&b, binary.BigEndian, []uint32{6})
+	binary.Write(&b, binary.BigEndian, []uint16{0, 1, 480})
+	b.WriteString("MTrk")
+	binary.Write(&b, binary.BigEndian, uint32(len(track)))
+	b.Write(track)
+	return b.Bytes()
+}
+
+func varLen(v int) []byte {
+	ret := []byte{byte(v & 0x7F)}
+	for v >>= 7; v > 0; v >>= 7 {
+		ret = append([]byte{byte(v&0x7F | 0x80)}, ret...)
+	}
+	return ret
+}
+
+func compile(t *testing.T, notes []testNote, chans int, fold bool) []byte {
+	events, toMsec, err := parseMidi(makeMidi(notes), false)
+	if err != nil {
+		t.Fatal(err)
+	}
+	return encode(assignChannels(events, toMsec, chans, 2), fold, false)
+}
+
+func TestCompile(t *testing.T) {
+	tests := []struct {
+		name  string
+		notes []testNote
+		want  []byte
+	}{
+		{"note at the start", []testNote{{0, 480, 60}},
+			[]byte{0x90, 0x3C, 0x01, 0xF4, 0x80, 0xF0}},
+		{"rest before the first note", []testNote{{480, 480, 60}},
+			[]byte{0x01, 0xF4, 0x90, 0x3C, 0x01, 0xF4, 0x80, 0xF0}},
+		{"rest between notes", []testNote{{0, 240, 60}, {480, 240, 64}},
+			[]byte{0x90, 0x3C, 0x00, 0xFA, 0x80, 0x00, 0xFA, 0x90, 0x40, 0x00, 0xFA, 0x80, 0xF0}},
+		{"chord on two channels", []testNote{{0, 480, 60}, {0, 480, 67}},
+			[]byte{0x90, 0x3C, 0x91, 0x43, 0x01, 0xF4, 0x80, 0x81, 0xF0}},
+		{"wait longer than 0x7FFF", []testNote{{0, 32000, 60}},
+			[]byte{0x90, 0x3C, 0x7F, 0xFF, 0x02, 0x36, 0x80, 0xF0}},
+	}
+	for _, tc := range tests {
+		if got := compile(t, tc.notes, 2, false); !bytes.Equal(got, tc.want) {
+			t.Errorf("%s: got % X, want % X", tc.name, got, tc.want)
+		}
+	}
+}
+
+// noteOnTimes returns when each note starts in a score without repeats.
+func noteOnTimes(score []byte) []int {
+	var ret []int
+	msec := 0
+	for i := 0; i < len(score); {
+		c := int(score[i])
+		switch {
+		case c < 0x80:
+			msec += c<<8 | int(score[i+1])
+			i += 2
+		case c&0xF0 == opPlayNote:
+			ret = append(ret, msec)
+			i += 2
+		default:
+			i++
+		}
+	}
+	return ret
+}
+
+func TestLeadingRestKeepsTiming(t *testing.T) {
+	for _, start := range []int{0, 96, 480, 1920} {
+		notes := []testNote{{start, 480, 60}, {start + 480, 480, 62}}
+		score := compile(t, notes, 1, false)
+		got := noteOnTimes(score)
+		for i, n := range notes {
+			if want := int(float64(n.tick)*500/480 + 0.5); i >= len(got) || got[i] != want {
+				t.Errorf("start %d: note %d starts at %v ms, want %d ms (% X)", start, i, got, want, score)
+			}
+		}
+	}
+}
+
+func TestFoldedScoreAfterRest(t *testing.T) {
+	var notes []testNote
+	for i := 0; i < 8; i++ {
+		notes = append(notes, testNote{480 + i*240, 120, 60 + i%2*7})
+	}
+	literal := compile(t, notes, 1, false)
+	folded := compile(t, notes, 1, true)
+	if len(folded) >= len(literal) {
+		t.Errorf("not folded: %d bytes, literal %d bytes", len(folded), len(literal))
+	}
+	if folded[0] != 0x01 || folded[1] != 0xF4 {
+		t.Errorf("the leading rest is lost: % X", folded)
+	}
+}
+
+// playedNotes counts the notes which a player plays from a score, with a
+// repeat counter of 8 bits like MyArduboyPlaytune, and gives -1 if it keeps
+// playing for too long.
+func playedNotes(score []byte) int {
+	notes, start, cursor := 0, 0, 0
+	var repeat uint8
+	for steps := 0; steps < 1000000; steps++ {
+		c := int(score[cursor])
+		cursor++
+		switch {
+		case c < 0x80:
+			cursor++
+		case c&0xF0 == opPlayNote:
+			notes++
+			cursor++
+		case c&0xF0 == opMark:
+			start = cursor - 1
+		case c&0xF0 == opRepeat:
+			if n := c & 0x0F; n == 0 {
+				cursor = start
+			} else if repeat++; int(repeat) < 1<<n {
+				cursor = start
+			} else {
+				start, repeat = cursor, 0
+			}
+		case c == opStop:
+			return notes
+		}
+	}
+	return -1
+}
+
+func TestLongRepeatPlays(t *testing.T) {
+	for _, n := range []int{257, 513, 1000} {
+		var notes []testNote
+		for i := 0; i < n; i++ {
+			notes = append(notes, testNote{i * 240, 120, 60})
+		}
+		score := compile(t, notes, 1, true)
+		for i := 0; i < len(score); {
+			c := int(score[i])
+			switch {
+			case c < 0x80:
+				i += 2
+				continue
+			case c&0xF0 == opPlayNote:
+				i += 2
+				continue
+			case c&0xF0 == opRepeat && c&0x0F > 7:
+				t.Errorf("%d notes: repeat of 2^%d, which the players can't count (% X)", n, c&0x0F, score)
+			}
+			i++
+		}
+		if got := playedNotes(score); got != n {
+			t.Errorf("%d notes: %d played (% X)", n, got, score)
+		}
+	}
+}
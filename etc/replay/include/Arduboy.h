@@ -0,0 +1,55 @@
+#pragma once
+
+/*
+ * Arduboy 1.1.1 stand-in for the replayer, on the common part of
+ * HostArduboy.h. The audio switch is kept in the EEPROM as the library does,
+ * and the tunes play nothing.
+ */
+
+#include <HostArduboy.h>
+
+#define ARDUBOY_LIB_VER 10101
+
+#define EEPROM_AUDIO_ON_OFF 2
+#define EEPROM_STORAGE_SPACE_START 16
+
+class ArduboyAudio
+{
+public:
+    static void begin(void) {}
+    static void on(void) { audio_enabled = true; }
+    static void off(void) { audio_enabled = false; }
+    static void saveOnOff(void) { EEPROM.update(EEPROM_AUDIO_ON_OFF, audio_enabled); }
+    static bool enabled(void) { return audio_enabled; }
+
+protected:
+    static bool audio_enabled;
+};
+
+class ArduboyTunes
+{
+public:
+    void    initChannel(byte) {}
+    void    playScore(const byte *) {}
+    void    stopScore(void) {}
+    bool    playing(void) { return false; }
+    void    tone(unsigned int, unsigned long) {}
+    void    closeChannels(void) {}
+};
+
+class Arduboy : public Print, public HostArduboy
+{
+public:
+    void    begin(void) {}
+    void    start(void) {}
+    void    setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void    setTextSize(uint8_t s) { textsize = (s > 0) ? s : 1; }
+    void    setTextWrap(bool w) { wrap = w; }
+    void    initRandomSeed(void) {}
+    ArduboyTunes tunes;
+    ArduboyAudio audio;
+
+protected:
+    uint8_t textsize = 1;
+    bool    wrap = false;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+/*
+ * Arduboy2 stand-in for the replayer, on the common part of HostArduboy.h.
+ * The audio switch is kept in the EEPROM as the library does.
+ */
+
+#include <HostArduboy.h>
+
+#define ARDUBOY_LIB_VER 50201
+
+#define EEPROM_AUDIO_ON_OFF 2
+#define EEPROM_STORAGE_SPACE_START 16
+
+struct Point
+{
+    int16_t x, y;
+    Point(void) {}
+    Point(int16_t x, int16_t y) : x(x), y(y) {}
+};
+
+struct Rect
+{
+    int16_t x, y;
+    uint8_t width, height;
+    Rect(void) {}
+    Rect(int16_t x, int16_t y, uint8_t width, uint8_t height) : x(x), y(y), width(width), height(height) {}
+};
+
+class Arduboy2Audio
+{
+public:
+    static void begin(void) { isEnabled = (EEPROM.read(EEPROM_AUDIO_ON_OFF) != 0); }
+    static void on(void) { isEnabled = true; }
+    static void off(void) { isEnabled = false; }
+    static void toggle(void) { isEnabled = !isEnabled; }
+    static void saveOnOff(void) { EEPROM.update(EEPROM_AUDIO_ON_OFF, isEnabled); }
+    static bool enabled(void) { return isEnabled; }
+
+private:
+    static bool isEnabled;
+};
+
+class Arduboy2 : public Print, public HostArduboy
+{
+public:
+    using   HostArduboy::collide;
+    bool    collide(Point point, Rect rect);
+    bool    collide(Rect rect1, Rect rect2);
+    void    begin(void) {}
+    void    setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    int16_t getCursorX(void) { return cursor_x; }
+    int16_t getCursorY(void) { return cursor_y; }
+    void    setTextColor(uint8_t color) { textColor = color; }
+    uint8_t getTextColor(void) { return textColor; }
+    void    setTextBackground(uint8_t bg) { textBackground = bg; }
+    void    setTextSize(uint8_t s) { textSize = (s > 0) ? s : 1; }
+    void    setTextWrap(bool w) { textWrap = w; }
+    void    initRandomSeed(void) {}
+    Arduboy2Audio audio;
+
+protected:
+    uint8_t textColor = WHITE, textBackground = BLACK, textSize = 1;
+    bool    textWrap = false;
+};
+
+inline bool Arduboy2::collide(Point point, Rect rect)
+{
+    return point.x >= rect.x && point.x < rect.x + rect.width && point.y >= rect.y && point.y < rect.y + rect.height;
+}
+
+inline bool Arduboy2::collide(Rect rect1, Rect rect2)
+{
+    return !(rect2.x >= rect1.x + rect1.width || rect2.x + rect2.width <= rect1.x ||
+            rect2.y >= rect1.y + rect1.height || rect2.y + rect2.height <= rect1.y);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+ * ArduboyPlaytune stand-in for the replayer, which plays nothing.
+ */
+
+#include <Arduino.h>
+
+class ArduboyPlaytune
+{
+public:
+    ArduboyPlaytune(bool (*)(void)) {}
+    void    initChannel(byte) {}
+    void    playScore(const byte *) {}
+    void    stopScore(void) {}
+    bool    playing(void) { return false; }
+    void    tone(unsigned int, unsigned long) {}
+    void    closeChannels(void) {}
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+/*
+ * Arduino core on the host for the replayer. rand() and random() give the
+ * same sequences as avr-libc, Print formats as Arduino does with the 32-bit
+ * long of the AVR, and what is written to Serial goes to the replayer.
+ */
+
+#include <cstdlib>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/power.h>
+
+#define F_CPU   16000000UL
+#define PI      3.1415926535897932384626433832795
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+
+class __FlashStringHelper;
+#define F(s)                ((const __FlashStringHelper *) (s))
+
+#define DEC     10
+#define HEX     16
+#define OCT     8
+#define BIN     2
+
+#define LOW     0
+#define HIGH    1
+#define INPUT   0
+#define OUTPUT  1
+
+#define _BV(b)              (1 << (b))
+#define bit(b)              (1UL << (b))
+#define bitRead(v, b)       (((v) >> (b)) & 1)
+#define bitSet(v, b)        ((v) |= (1UL << (b)))
+#define bitClear(v, b)      ((v) &= ~(1UL << (b)))
+#define bitToggle(v, b)     ((v) ^= (1UL << (b)))
+#define bitWrite(v, b, x)   ((x) ? bitSet(v, b) : bitClear(v, b))
+#define lowByte(w)          ((uint8_t) ((w) & 0xFF))
+#define highByte(w)         ((uint8_t) ((w) >> 8))
+#define constrain(v, l, h)  ((v) < (l) ? (l) : ((v) > (h) ? (h) : (v)))
+
+/*  Functions instead of the macros of Arduino, not to break the C++ library  */
+template <typename A, typename B>
+inline auto min(A a, B b) -> typename std::common_type<A, B>::type { return (a < b) ? a : b; }
+template <typename A, typename B>
+inline auto max(A a, B b) -> typename std::common_type<A, B>::type { return (a > b) ? a : b; }
+
+/*  Only the speaker pins exist, both on port C  */
+#define PC  3
+#define digitalPinToPort(pin)       ((void) (pin), PC)
+#define digitalPinToBitMask(pin)    ((pin) == 13 ? _BV(7) : _BV(6))
+#define portOutputRegister(port)    ((void) (port), &PORTC)
+#define portModeRegister(port)      ((void) (port), &DDRC)
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void delay(unsigned long) {}
+inline void delayMicroseconds(unsigned int) {}
+
+/*  Time is the frame counter of the replayer unless the harness maps it  */
+unsigned long millis(void);
+unsigned long micros(void);
+
+/*  Random numbers of avr-libc, whose int is 16 bits and long is 32 bits  */
+int     hostRand(void);
+void    hostSrand(uint16_t seed);
+long    hostRandom(void);
+long    hostRandom(long howBig);
+long    hostRandom(long howSmall, long howBig);
+void    hostSrandom(uint32_t seed);
+#define rand        hostRand
+#define srand       hostSrand
+#define random      hostRandom
+#define srandom     hostSrandom
+#undef  RAND_MAX
+#define RAND_MAX    0x7FFF
+#define RANDOM_MAX  0x7FFFFFFF
+
+inline void randomSeed(unsigned long seed) { if (seed != 0) srandom(seed); }
+
+class Print
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    size_t  write(const char *s) { return write((const uint8_t *) s, strlen(s)); }
+    size_t  write(const uint8_t *p, size_t n) { size_t ret = 0; while (n--) ret += write(*p++); return ret; }
+
+    size_t  print(const char *s) { return write(s); }
+    size_t  print(const __FlashStringHelper *s) { return print((const char *) s); }
+    size_t  print(char c) { return write((uint8_t) c); }
+    size_t  print(unsigned char n, int base = DEC) { return print((unsigned long) n, base); }
+    size_t  print(int n, int base = DEC) { return print((long) n, base); }
+    size_t  print(unsigned int n, int base = DEC) { return print((unsigned long) n, base); }
+    size_t  print(long n, int base = DEC);
+    size_t  print(unsigned long n, int base = DEC);
+    size_t  print(double n, int digits = 2);
+    size_t  println(void) { return write("\r\n"); }
+    template <typename T> size_t println(T v) { size_t ret = print(v); return ret + println(); }
+    template <typename T> size_t println(T v, int f) { size_t ret = print(v, f); return ret + println(); }
+
+private:
+    size_t  printNumber(uint32_t n, uint8_t base);
+};
+
+inline size_t Print::print(long n, int base)
+{
+    if (base == 0) return write((uint8_t) n);
+    if (base == 10 && (int32_t) n < 0) return print('-') + printNumber(-(int32_t) n, 10);
+    return printNumber((uint32_t) n, base);
+}
+
+inline size_t Print::print(unsigned long n, int base)
+{
+    if (base == 0) return write((uint8_t) n);
+    return printNumber((uint32_t) n, base);
+}
+
+inline size_t Print::print(double n, int digits)
+{
+    size_t ret = 0;
+    if (n < 0.0) {
+        ret += print('-');
+        n = -n;
+    }
+    double rounding = 0.5;
+    for (int i = 0; i < digits; i++) rounding /= 10.0;
+    n += rounding;
+    unsigned long intPart = (unsigned long) n;
+    ret += print(intPart);
+    if (digits > 0) ret += print('.');
+    for (double rem = n - intPart; digits-- > 0; ) {
+        rem *= 10.0;
+        unsigned int d = (unsigned int) rem;
+        ret += print(d);
+        rem -= d;
+    }
+    return ret;
+}
+
+inline size_t Print::printNumber(uint32_t n, uint8_t base)
+{
+    char buf[33], *p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    if (base < 2) base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--p = (c < 10) ? c + '0' : c + 'A' - 10;
+    } while (n);
+    return write(p);
+}
+
+class HardwareSerial : public Print
+{
+public:
+    void    begin(unsigned long) {}
+    int     available(void) { return 0; }
+    int     read(void) { return -1; }
+    virtual size_t write(uint8_t c);
+    using   Print::write;
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+class USBDevice_
+{
+public:
+    bool    configured(void) { return false; }
+};
+
+static USBDevice_ USBDevice;
@@ -0,0 +1,20 @@
+#pragma once
+
+/*
+ * EEPROM library of Arduino on hostEeprom[] of avr/eeprom.h.
+ */
+
+#include <avr/eeprom.h>
+
+class EEPROMClass
+{
+public:
+    uint8_t read(int idx) { return hostEeprom[idx & E2END]; }
+    void    write(int idx, uint8_t val) { hostEeprom[idx & E2END] = val; }
+    void    update(int idx, uint8_t val) { hostEeprom[idx & E2END] = val; }
+    uint16_t length(void) { return E2END + 1; }
+    template <typename T> T &get(int idx, T &t) { memcpy(&t, &hostEeprom[idx & E2END], sizeof(T)); return t; }
+    template <typename T> const T &put(int idx, const T &t) { memcpy(&hostEeprom[idx & E2END], &t, sizeof(T)); return t; }
+};
+
+static EEPROMClass EEPROM;
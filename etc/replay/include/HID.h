@@ -0,0 +1,22 @@
+#pragma once
+
+/*
+ * HID library stand-in for the replayer, whose USB is never connected.
+ */
+
+#include <Arduino.h>
+
+class HIDSubDescriptor
+{
+public:
+    HIDSubDescriptor(const void *, uint16_t) {}
+};
+
+class HID_
+{
+public:
+    int     AppendDescriptor(HIDSubDescriptor *) { return 1; }
+    int     SendReport(uint8_t, const void *, int) { return 0; }
+};
+
+inline HID_ &HID(void) { static HID_ obj; return obj; }
@@ -0,0 +1,258 @@
+#pragma once
+
+/*
+ * Common part of the Arduboy and Arduboy2 stand-ins for the replayer: the
+ * screen buffer and the drawing functions which give the same pixels as the
+ * libraries, the frames and buttons which come from the replayer, and the
+ * hardware which does nothing.
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+#define WIDTH   128
+#define HEIGHT  64
+#define BLACK   0
+#define WHITE   1
+#define INVERT  2
+
+#define LEFT_BUTTON     _BV(5)
+#define RIGHT_BUTTON    _BV(6)
+#define UP_BUTTON       _BV(7)
+#define DOWN_BUTTON     _BV(4)
+#define A_BUTTON        _BV(3)
+#define B_BUTTON        _BV(2)
+
+#define PIN_SPEAKER_1   5
+#define PIN_SPEAKER_2   13
+
+#define RED_LED         10
+#define GREEN_LED       11
+#define BLUE_LED        9
+#define RGB_ON          LOW
+#define RGB_OFF         HIGH
+
+#define OLED_ALL_PIXELS_ON  0xA5
+#define OLED_PIXELS_FROM_RAM 0xA4
+#define OLED_PIXELS_INVERTED 0xA7
+#define OLED_PIXELS_NORMAL  0xA6
+
+/*  Defined by the replayer  */
+bool    hostNextFrame(void);
+uint8_t hostButtonsState(void);
+
+class HostArduboy
+{
+public:
+    uint8_t *getBuffer(void) { return sBuffer; }
+    void    clear(void) { fillScreen(BLACK); }
+    void    fillScreen(uint8_t color) { memset(sBuffer, (color == BLACK) ? 0x00 : 0xFF, sizeof(sBuffer)); }
+    void    drawPixel(int16_t x, int16_t y, uint8_t color = WHITE);
+    uint8_t getPixel(uint8_t x, uint8_t y);
+    void    drawFastVLine(int16_t x, int16_t y, uint8_t h, uint8_t color = WHITE);
+    void    drawFastHLine(int16_t x, int16_t y, uint8_t w, uint8_t color = WHITE);
+    void    drawRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color = WHITE);
+    void    fillRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color = WHITE);
+    void    drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color = WHITE);
+    void    drawCircle(int16_t x0, int16_t y0, uint8_t r, uint8_t color = WHITE);
+    void    fillCircle(int16_t x0, int16_t y0, uint8_t r, uint8_t color = WHITE);
+    void    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color = WHITE);
+    void    invert(bool) {}
+    void    allPixelsOn(bool) {}
+    void    display(void) {}
+    void    boot(void) {}
+    void    blank(void) {}
+    void    flashlight(void) {}
+    void    systemButtons(void) {}
+    void    idle(void) {}
+    void    sendLCDCommand(uint8_t) {}
+    void    setRGBled(uint8_t, uint8_t, uint8_t) {}
+    void    digitalWriteRGB(uint8_t, uint8_t, uint8_t) {}
+    void    setFrameRate(uint8_t) {}
+    bool    nextFrame(void) { frameCount++; return hostNextFrame(); }
+    bool    everyXFrames(uint8_t frames) { return frameCount % frames == 0; }
+    int     cpuLoad(void) { return 0; }
+    uint8_t buttonsState(void) { return hostButtonsState(); }
+    bool    pressed(uint8_t buttons) { return (buttonsState() & buttons) == buttons; }
+    bool    notPressed(uint8_t buttons) { return (buttonsState() & buttons) == 0; }
+    bool    collide(int16_t x0, int16_t y0, int16_t w0, int16_t h0, int16_t x1, int16_t y1, int16_t w1, int16_t h1);
+
+    uint16_t frameCount;
+
+protected:
+    void    fillCircleHelper(int16_t x0, int16_t y0, uint8_t r, uint8_t sides, int16_t delta, uint8_t color);
+    static uint8_t sBuffer[WIDTH * HEIGHT / 8];
+    int16_t cursor_x, cursor_y;
+};
+
+inline void HostArduboy::drawPixel(int16_t x, int16_t y, uint8_t color)
+{
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+    uint8_t *p = &sBuffer[(y / 8) * WIDTH + x];
+    *p = (color) ? *p | _BV(y & 7) : *p & ~_BV(y & 7);
+}
+
+inline uint8_t HostArduboy::getPixel(uint8_t x, uint8_t y)
+{
+    return (x < WIDTH && y < HEIGHT) ? sBuffer[(y / 8) * WIDTH + x] >> (y & 7) & 1 : 0;
+}
+
+inline void HostArduboy::drawFastVLine(int16_t x, int16_t y, uint8_t h, uint8_t color)
+{
+    int end = y + h;
+    for (int a = max(0, (int) y); a < min(end, HEIGHT); a++) drawPixel(x, a, color);
+}
+
+inline void HostArduboy::drawFastHLine(int16_t x, int16_t y, uint8_t w, uint8_t color)
+{
+    int end = x + w;
+    for (int a = max(0, (int) x); a < min(end, WIDTH); a++) drawPixel(a, y, color);
+}
+
+inline void HostArduboy::drawRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color)
+{
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+inline void HostArduboy::fillRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color)
+{
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+/*  Bresenham's algorithm of Adafruit GFX, which both libraries inherit  */
+inline void HostArduboy::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t t;
+    if (steep) {
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int8_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            drawPixel(y0, x0, color);
+        } else {
+            drawPixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+inline void HostArduboy::drawCircle(int16_t x0, int16_t y0, uint8_t r, uint8_t color)
+{
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+    drawPixel(x0, y0 + r, color);
+    drawPixel(x0, y0 - r, color);
+    drawPixel(x0 + r, y0, color);
+    drawPixel(x0 - r, y0, color);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        drawPixel(x0 + x, y0 + y, color);
+        drawPixel(x0 - x, y0 + y, color);
+        drawPixel(x0 + x, y0 - y, color);
+        drawPixel(x0 - x, y0 - y, color);
+        drawPixel(x0 + y, y0 + x, color);
+        drawPixel(x0 - y, y0 + x, color);
+        drawPixel(x0 + y, y0 - x, color);
+        drawPixel(x0 - y, y0 - x, color);
+    }
+}
+
+inline void HostArduboy::fillCircle(int16_t x0, int16_t y0, uint8_t r, uint8_t color)
+{
+    drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+}
+
+inline void HostArduboy::fillCircleHelper(int16_t x0, int16_t y0, uint8_t r, uint8_t sides, int16_t delta, uint8_t color)
+{
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (sides & 0x1) {
+            drawFastVLine(x0 + x, y0 - y, 2 * y + 1 + delta, color);
+            drawFastVLine(x0 + y, y0 - x, 2 * x + 1 + delta, color);
+        }
+        if (sides & 0x2) {
+            drawFastVLine(x0 - x, y0 - y, 2 * y + 1 + delta, color);
+            drawFastVLine(x0 - y, y0 - x, 2 * x + 1 + delta, color);
+        }
+    }
+}
+
+/*  Same as drawBitmap() of Arduboy2 5.2.1, and of Arduboy 1.1.1 but INVERT  */
+inline void HostArduboy::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color)
+{
+    if (x + w <= 0 || x > WIDTH - 1 || y + h <= 0 || y > HEIGHT - 1) return;
+
+    int yOffset = abs(y) % 8;
+    int sRow = y / 8;
+    if (y < 0) {
+        sRow--;
+        yOffset = 8 - yOffset;
+    }
+    int rows = h / 8;
+    if (h % 8 != 0) rows++;
+    for (int a = 0; a < rows; a++) {
+        int bRow = sRow + a;
+        if (bRow > (HEIGHT / 8) - 1) break;
+        if (bRow > -2) {
+            for (int iCol = 0; iCol < w; iCol++) {
+                if (iCol + x > (WIDTH - 1)) break;
+                if (iCol + x >= 0) {
+                    if (bRow >= 0) {
+                        if (color == WHITE) {
+                            sBuffer[(bRow * WIDTH) + x + iCol] |= pgm_read_byte(bitmap + (a * w) + iCol) << yOffset;
+                        } else if (color == BLACK) {
+                            sBuffer[(bRow * WIDTH) + x + iCol] &= ~(pgm_read_byte(bitmap + (a * w) + iCol) << yOffset);
+                        } else {
+                            sBuffer[(bRow * WIDTH) + x + iCol] ^= pgm_read_byte(bitmap + (a * w) + iCol) << yOffset;
+                        }
+                    }
+                    if (yOffset && bRow < (HEIGHT / 8) - 1 && bRow > -2) {
+                        if (color == WHITE) {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] |= pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset);
+                        } else if (color == BLACK) {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] &= ~(pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset));
+                        } else {
+                            sBuffer[((bRow + 1) * WIDTH) + x + iCol] ^= pgm_read_byte(bitmap + (a * w) + iCol) >> (8 - yOffset);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline bool HostArduboy::collide(int16_t x0, int16_t y0, int16_t w0, int16_t h0, int16_t x1, int16_t y1, int16_t w1, int16_t h1)
+{
+    return !(x1 >= x0 + w0 || x1 + w1 <= x0 || y1 >= y0 + h0 || y1 + h1 <= y0);
+}
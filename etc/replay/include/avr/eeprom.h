@@ -0,0 +1,31 @@
+#pragma once
+
+/*
+ * EEPROM of avr-libc on the host. An address is given as a pointer, the same
+ * as on the AVR, and is the index of hostEeprom[], which the replayer defines
+ * in the erased state.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define E2END   1023
+
+extern uint8_t hostEeprom[E2END + 1];
+
+#define eeprom_busy_wait()
+
+static inline uint8_t *eepromAddr(const volatile void *p) { return &hostEeprom[(uintptr_t) p & E2END]; }
+
+static inline void eeprom_read_block(void *dst, const void *src, size_t n) { memcpy(dst, eepromAddr(src), n); }
+static inline void eeprom_update_block(const void *src, void *dst, size_t n) { memcpy(eepromAddr(dst), src, n); }
+static inline void eeprom_write_block(const void *src, void *dst, size_t n) { memcpy(eepromAddr(dst), src, n); }
+
+static inline uint8_t eeprom_read_byte(const uint8_t *p) { return *eepromAddr(p); }
+static inline uint16_t eeprom_read_word(const uint16_t *p) { uint16_t v; eeprom_read_block(&v, p, 2); return v; }
+static inline uint32_t eeprom_read_dword(const uint32_t *p) { uint32_t v; eeprom_read_block(&v, p, 4); return v; }
+static inline void eeprom_update_byte(uint8_t *p, uint8_t v) { *eepromAddr(p) = v; }
+static inline void eeprom_update_word(uint16_t *p, uint16_t v) { eeprom_update_block(&v, p, 2); }
+static inline void eeprom_update_dword(uint32_t *p, uint32_t v) { eeprom_update_block(&v, p, 4); }
+static inline void eeprom_write_byte(uint8_t *p, uint8_t v) { *eepromAddr(p) = v; }
@@ -0,0 +1,33 @@
+#pragma once
+
+/*
+ * Registers of ATmega32U4 which the sound players touch. They are defined by
+ * the replayer, and nothing runs the timers.
+ */
+
+#include <stdint.h>
+
+extern volatile uint8_t     PORTC, DDRC;
+extern volatile uint8_t     TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint8_t     TCCR3A, TCCR3B, TIMSK3;
+extern volatile uint8_t     TCCR4A, TCCR4B, TCCR4C, TCCR4D;
+extern volatile uint16_t    OCR1A, TCNT1, OCR3A, TCNT3;
+extern volatile uint8_t     OCR4A;
+
+/*  USB is never connected  */
+#define USBSTA  0
+#define VBUS    0
+
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define WGM12   3
+#define WGM13   4
+#define OCIE1A  1
+
+#define CS30    0
+#define CS31    1
+#define CS32    2
+#define WGM32   3
+#define WGM33   4
+#define OCIE3A  1
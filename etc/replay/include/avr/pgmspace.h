@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+ * PROGMEM is plain memory on the host. A word or a double word is read in the
+ * type of the table, so that tables of pointers work, and from a table of
+ * bytes it is put together in little endian as on the AVR.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)             (s)
+#define PGM_P               const char *
+#define pgm_read_byte(p)    (*(const uint8_t *) (p))
+#define pgm_read_word(p)    pgmReadWord(p)
+#define pgm_read_dword(p)   pgmReadDword(p)
+#define pgm_read_ptr(p)     (*(void * const *) (p))
+#define pgm_read_byte_near  pgm_read_byte
+#define pgm_read_word_near  pgm_read_word
+#define memcpy_P            memcpy
+#define memcmp_P            memcmp
+#define strcpy_P            strcpy
+#define strlen_P            strlen
+#define strnlen_P           strnlen
+#define strlen_PF(p)        strlen((const char *) (p))
+
+typedef uintptr_t   uint_farptr_t;
+
+template <typename T>
+inline T pgmReadWord(const T *p) { return *p; }
+inline uint16_t pgmReadWord(const uint8_t *p) { return p[0] | p[1] << 8; }
+inline uint16_t pgmReadWord(const char *p) { return pgmReadWord((const uint8_t *) p); }
+inline uint16_t pgmReadWord(const void *p) { return pgmReadWord((const uint8_t *) p); }
+
+template <typename T>
+inline T pgmReadDword(const T *p) { return *p; }
+inline uint32_t pgmReadDword(const uint8_t *p) { return pgmReadWord(p) | (uint32_t) pgmReadWord(p + 2) << 16; }
+inline uint32_t pgmReadDword(const void *p) { return pgmReadDword((const uint8_t *) p); }
@@ -0,0 +1,8 @@
+#pragma once
+
+#define power_timer0_enable()
+#define power_timer0_disable()
+#define power_timer1_enable()
+#define power_timer1_disable()
+#define power_timer3_enable()
+#define power_timer3_disable()
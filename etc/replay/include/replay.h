@@ -0,0 +1,14 @@
+#pragma once
+
+/*
+ * Stand-in of the "replay.h" which etc/inputlog.go generates. The replayer
+ * reads the stream from the log file instead and puts it in the same layout.
+ */
+
+#include <stdint.h>
+
+extern const uint8_t    *inputReplayData;
+extern const uint16_t   *inputReplayHashes;
+extern uint16_t         inputReplayHashCount;
+
+#define INPUT_REPLAY_HASHES inputReplayHashCount
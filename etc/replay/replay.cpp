@@ -0,0 +1,288 @@
+/*
+ * Host replayer of the input harness of the MyArduboy libraries.
+ *
+ * A game is built on the host against the stand-ins of include/ with
+ * INPUT_REPLAY defined, and the stream of a serial log of the harness, the
+ * same log as etc/inputlog.go reads, is loaded from the file at run time
+ * instead of being embedded as "replay.h". The game runs frame by frame on the
+ * stream through the unchanged harness, which checks the CRC-16 of the
+ * framebuffer of every frame against the log. The frames which differ are
+ * reported, and the exit status is 1 if any.
+ *
+ * Built with INPUT_RECORD defined instead, the game is played by random runs
+ * of the buttons and the log of the harness is written to the standard output,
+ * which is how the logs of replay.sh are made.
+ *
+ * The stand-ins draw the same pixels as the libraries and give the random
+ * numbers of avr-libc, but int is 32 bits on the host. A log recorded on the
+ * Arduboy is replayed as far as the game doesn't depend on the overflow of
+ * 16-bit int, and the frames after the first difference are reported as well.
+ *
+ * Build: c++ -O2 -std=gnu++11 -fpermissive -w -I etc/replay/include \
+ *            -iquote <game> -DINPUT_REPLAY -o replay etc/replay/replay.cpp \
+ *            <the .cpp files of the game> <the sketch converted to .cpp>
+ *        See replay.sh, which converts the sketch and builds every game.
+ *
+ * Usage: replay [-v] <log file>           (INPUT_REPLAY)
+ *        replay [-f frames] [-r seed]      (INPUT_RECORD)
+ */
+
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <Arduboy.h>
+#include <Arduboy2.h>
+
+/*  Defines  */
+
+#define FRAMES_DEFAULT  1200
+#define RUN_FRAMES_MAX  40
+#define LOOPS_PER_FRAME 8   // loop() may return without a frame, but not for ever
+#define ERRORS_SHOWN    10
+
+/*  Global Variables  */
+
+HardwareSerial  Serial;
+uint8_t         hostEeprom[E2END + 1];
+uint8_t         HostArduboy::sBuffer[WIDTH * HEIGHT / 8];
+bool            Arduboy2Audio::isEnabled;
+bool            ArduboyAudio::audio_enabled;
+
+volatile uint8_t    PORTC, DDRC;
+volatile uint8_t    TCCR1A, TCCR1B, TIMSK1;
+volatile uint8_t    TCCR3A, TCCR3B, TIMSK3;
+volatile uint8_t    TCCR4A, TCCR4B, TCCR4C, TCCR4D;
+volatile uint16_t   OCR1A, TCNT1, OCR3A, TCNT3;
+volatile uint8_t    OCR4A;
+
+#ifdef INPUT_REPLAY
+const uint8_t   *inputReplayData;
+const uint16_t  *inputReplayHashes;
+uint16_t        inputReplayHashCount;
+#endif
+
+extern uint16_t inputFrames;
+
+void    setup(void);
+void    loop(void);
+
+/*  Local Variables  */
+
+static uint32_t     randNext = 1, randomNext = 1;
+static std::string  line;
+static bool         isVerbose, isDone;
+static long         frames;
+
+#ifdef INPUT_REPLAY
+static std::vector<uint8_t>     replayData;
+static std::vector<uint16_t>    replayHashes;
+static long                     errors, replayedFrames = -1, reportedErrors = -1;
+#else
+static std::mt19937 rng;
+static uint8_t      runState, runFrames;
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*                           Stand-ins of the core                           */
+/*---------------------------------------------------------------------------*/
+
+unsigned long millis(void) { return (unsigned long) inputFrames << 4; }
+unsigned long micros(void) { return (unsigned long) inputFrames << 14; }
+
+/*  do_random() of avr-libc, the minimal standard generator of Park and Miller  */
+static int32_t doRandom(uint32_t *pCtx)
+{
+    int32_t x = *pCtx;
+    if (x == 0) x = 123459876L;
+    int32_t hi = x / 127773L, lo = x % 127773L;
+    x = 16807L * lo - 2836L * hi;
+    if (x < 0) x += 0x7FFFFFFFL;
+    *pCtx = x;
+    return x;
+}
+
+int hostRand(void) { return doRandom(&randNext) % ((uint16_t) RAND_MAX + 1); }
+void hostSrand(uint16_t seed) { randNext = seed; }
+long hostRandom(void) { return doRandom(&randomNext) % ((uint32_t) RANDOM_MAX + 1); }
+void hostSrandom(uint32_t seed) { randomNext = seed; }
+
+/*  random() of Arduino with the 32-bit long of the AVR  */
+long hostRandom(long howBig)
+{
+    if (howBig == 0) return 0;
+    return (int32_t) (hostRandom() % (int32_t) howBig);
+}
+
+long hostRandom(long howSmall, long howBig)
+{
+    if (howSmall >= howBig) return howSmall;
+    return hostRandom(howBig - howSmall) + howSmall;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                      Frames, buttons and the harness                      */
+/*---------------------------------------------------------------------------*/
+
+bool hostNextFrame(void)
+{
+#ifdef INPUT_RECORD
+    if (inputFrames == frames) {
+        runState ^= 0xFF; // Ends the last run to be logged
+    } else if (runFrames == 0) {
+        static const uint8_t states[] = {
+            0, 0, 0, 0, A_BUTTON, A_BUTTON, B_BUTTON, LEFT_BUTTON, RIGHT_BUTTON, UP_BUTTON,
+            DOWN_BUTTON, A_BUTTON | LEFT_BUTTON, A_BUTTON | RIGHT_BUTTON, A_BUTTON | B_BUTTON,
+        };
+        runState = states[rng() % sizeof(states)];
+        runFrames = rng() % RUN_FRAMES_MAX + 1;
+    }
+    runFrames--;
+#endif
+    return true;
+}
+
+uint8_t hostButtonsState(void)
+{
+#ifdef INPUT_RECORD
+    return runState;
+#else
+    return 0;
+#endif
+}
+
+/*  Lines written to Serial by the harness  */
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (c == '\r') return 1;
+    if (c != '\n') {
+        line += c;
+        return 1;
+    }
+#ifdef INPUT_RECORD
+    puts(line.c_str());
+#else
+    if (isVerbose) fprintf(stderr, "%s\n", line.c_str());
+    long frame, count;
+    if (sscanf(line.c_str(), "E %ld", &frame) == 1) {
+        if (errors++ < ERRORS_SHOWN) fprintf(stderr, "Frame %ld differs from the log\n", frame);
+    } else if (sscanf(line.c_str(), "R %ld %ld", &frame, &count) == 2) {
+        replayedFrames = frame;
+        reportedErrors = count;
+        isDone = true;
+    }
+#endif
+    line.clear();
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef INPUT_REPLAY
+
+/*  Reads the first session of a log as etc/inputlog.go does  */
+static bool loadLog(const char *pPath)
+{
+    FILE *fp = fopen(pPath, "r");
+    if (fp == NULL) {
+        perror(pPath);
+        return false;
+    }
+    unsigned long seed = 0, a, b;
+    bool isStarted = false;
+    char buf[80];
+    replayData.assign(4, 0);
+    for (int n = 1; fgets(buf, sizeof(buf), fp) != NULL; n++) {
+        if (sscanf(buf, "S %lx", &a) == 1) {
+            if (isStarted) break; // Only the first session is used
+            seed = a;
+            isStarted = true;
+        } else if (sscanf(buf, "I %lx %lu", &a, &b) == 2 && b > 0 && b <= 255) {
+            replayData.push_back(a);
+            replayData.push_back(b);
+            frames += b;
+        } else if (sscanf(buf, "H %lx", &a) == 1) {
+            replayHashes.push_back(a);
+        } else if (buf[strspn(buf, " \r\n")] != '\0') {
+            fprintf(stderr, "%s:%d: ignored %s", pPath, n, buf);
+        }
+    }
+    fclose(fp);
+    if (frames == 0) {
+        fprintf(stderr, "%s: no button runs found\n", pPath);
+        return false;
+    }
+
+    /*  Hashes after the last complete run can't be reproduced  */
+    if ((long) replayHashes.size() > frames) replayHashes.resize(frames);
+    for (int i = 0; i < 4; i++) replayData[i] = seed >> i * 8;
+    replayData.push_back(0x00); // Terminator
+    replayData.push_back(0);
+    inputReplayData = replayData.data();
+    inputReplayHashes = replayHashes.data();
+    inputReplayHashCount = replayHashes.size();
+    return true;
+}
+
+#endif
+
+int main(int argc, char *argv[])
+{
+    const char *pUsage;
+    int opt;
+#ifdef INPUT_REPLAY
+    pUsage = "[-v] <log file>";
+    while ((opt = getopt(argc, argv, "v")) != -1) {
+        switch (opt) {
+        case 'v': isVerbose = true; break;
+        default:  optind = argc + 1;  break;
+        }
+    }
+    if (optind != argc - 1 || !loadLog(argv[optind])) {
+        if (optind != argc - 1) fprintf(stderr, "Usage: %s %s\n", argv[0], pUsage);
+        return 2;
+    }
+#else
+    pUsage = "[-f frames] [-r seed]";
+    frames = FRAMES_DEFAULT;
+    unsigned seed = 1;
+    while ((opt = getopt(argc, argv, "f:r:")) != -1) {
+        switch (opt) {
+        case 'f': frames = atol(optarg);  break;
+        case 'r': seed = atoi(optarg);    break;
+        default:  optind = argc + 1;      break;
+        }
+    }
+    if (optind != argc || frames <= 0 || frames >= 0xFFFF) {
+        fprintf(stderr, "Usage: %s %s\n", argv[0], pUsage);
+        return 2;
+    }
+    rng.seed(seed);
+#endif
+
+    /*  The EEPROM is erased and the audio is off, as a new Arduboy  */
+    memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+    hostEeprom[EEPROM_AUDIO_ON_OFF] = 0;
+
+    setup();
+    for (long loops = 0; !isDone; loops++) {
+        if (loops > (frames + 1) * LOOPS_PER_FRAME) {
+            fprintf(stderr, "The game stopped calling nextFrame() at frame %u\n", inputFrames);
+            return 1;
+        }
+        loop();
+#ifdef INPUT_RECORD
+        if (inputFrames > frames) isDone = true;
+#endif
+    }
+
+#ifdef INPUT_REPLAY
+    printf("%ld frames replayed, %u hashes checked, %ld differ\n",
+            replayedFrames, inputReplayHashCount, reportedErrors);
+    return (replayedFrames != frames || reportedErrors != 0) ? 1 : 0;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+
+# Build every game on the host with the input harness, once to record and once
+# to replay, and replay the log of each game in the "logs" directory, which
+# must match frame by frame. The sketch is converted to C++ as the Arduino IDE
+# does, and its dispatch of the modules through 16-bit addresses of PROGMEM is
+# rewritten to read the table as it is.
+#
+# Usage: etc/replay/replay.sh [-u] [<project>...]
+#   -u  Record the logs anew by the recording build
+
+REPLAY_DIR=`dirname $0`
+BUILD_DIR="${REPLAY_DIR}/_build"
+LOG_DIR="${REPLAY_DIR}/logs"
+CXX=${CXX:-c++}
+CXXFLAGS='-O0 -std=gnu++11 -fpermissive -w'
+FRAMES=1200
+SEED=1
+
+update=0
+if [ "$1" = '-u' ]
+then
+	update=1
+	shift
+fi
+
+if [ $# -ge 1 ]
+then
+	projects=$@
+else
+	projects=`ls */*.ino | xargs -n 1 dirname`
+fi
+
+failed=0
+for project in ${projects}
+do
+	out="${BUILD_DIR}/${project}"
+	rm -rf ${out}
+	mkdir -p ${out} || exit 1
+	ino="${project}/${project}.ino"
+	(echo '#include <Arduino.h>'; echo "#line 1 \"${ino}\""; sed \
+			-e 's/((uint16_t) &moduleTable\[idx\]\.\([A-Za-z]*\))/(\&moduleTable[idx].\1)/' \
+			-e 's/((uint16_t) &moduleTable\[idx\])/(\&moduleTable[idx].initFunc)/' \
+			-e 's/((uint16_t) &moduleTable\[idx\] + 2)/(\&moduleTable[idx].updateFunc)/' \
+			-e 's/((uint16_t) &moduleTable\[idx\] + 4)/(\&moduleTable[idx].drawFunc)/' \
+			${ino}) > ${out}/${project}.ino.cpp || exit 1
+	sources=(${REPLAY_DIR}/replay.cpp ${out}/${project}.ino.cpp `ls ${project}/*.cpp`)
+	for mode in RECORD REPLAY
+	do
+		${CXX} ${CXXFLAGS} -I ${REPLAY_DIR}/include -iquote ${project} -Wa,-I,${project} -DINPUT_${mode} \
+				-o ${out}/${mode,,} "${sources[@]}" || exit 1
+	done
+
+	log="${LOG_DIR}/${project}.log"
+	if [ ${update} -eq 1 ]
+	then
+		mkdir -p ${LOG_DIR} && ${out}/record -f ${FRAMES} -r ${SEED} > ${log} || exit 1
+	fi
+	echo -n "${project}: "
+	if [ ! -f ${log} ]
+	then
+		echo "No log" >&2
+		failed=1
+	elif ! ${out}/replay ${log}
+	then
+		echo "--- ${project}: Replay differs from the log" >&2
+		failed=1
+	fi
+done
+
+[ ${failed} -eq 0 ] || exit 1
+echo "--- All replays match"
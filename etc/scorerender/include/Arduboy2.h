@@ -0,0 +1,38 @@
+#pragma once
+
+/*
+ * Arduboy2 stand-in for the score renderer: only the declarations which
+ * MyArduboy2.h needs, and the audio switch which is always on.
+ */
+
+#include <Arduino.h>
+
+#define ARDUBOY_LIB_VER 50201
+
+#define WIDTH   128
+#define HEIGHT  64
+#define BLACK   0
+#define WHITE   1
+
+#define PIN_SPEAKER_1   5
+#define PIN_SPEAKER_2   13
+
+class Arduboy2Audio
+{
+public:
+    static void begin(void) {}
+    static void on(void) {}
+    static void off(void) {}
+    static void toggle(void) {}
+    static void saveOnOff(void) {}
+    static bool enabled(void) { return true; }
+};
+
+class Arduboy2
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    void    setCursor(int16_t, int16_t) {}
+    template <typename T> size_t print(T) { return 0; }
+    Arduboy2Audio audio;
+};
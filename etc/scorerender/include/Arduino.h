@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build the sound players on the host. The
+ * registers of the timers and the speaker port are variables, which the
+ * renderer reads to run the timers and to sample the speaker pins.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define F_CPU   16000000UL
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+
+#define _BV(b)              (1 << (b))
+#define bitSet(v, b)        ((v) |= (1UL << (b)))
+#define bitClear(v, b)      ((v) &= ~(1UL << (b)))
+#define bitWrite(v, b, x)   ((x) ? bitSet(v, b) : bitClear(v, b))
+
+#define min(a, b)           ((a) < (b) ? (a) : (b))
+#define max(a, b)           ((a) > (b) ? (a) : (b))
+#define constrain(v, l, h)  ((v) < (l) ? (l) : ((v) > (h) ? (h) : (v)))
+
+/*  Only the speaker pins exist, both on port C  */
+#define PC  3
+#define digitalPinToPort(pin)       ((void) (pin), PC)
+#define digitalPinToBitMask(pin)    ((pin) == 13 ? _BV(7) : _BV(6))
+#define portOutputRegister(port)    ((void) (port), &PORTC)
+#define portModeRegister(port)      ((void) (port), &DDRC)
+
+inline void digitalWrite(uint8_t, uint8_t) {}
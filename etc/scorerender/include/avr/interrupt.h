@@ -0,0 +1,7 @@
+#pragma once
+
+/*  Interrupt service routines are plain functions which the renderer calls  */
+
+#define ISR(vector)     extern "C" void vector(void)
+#define cli()
+#define sei()
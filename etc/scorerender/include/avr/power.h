@@ -0,0 +1,6 @@
+#pragma once
+
+#define power_timer1_enable()
+#define power_timer1_disable()
+#define power_timer3_enable()
+#define power_timer3_disable()
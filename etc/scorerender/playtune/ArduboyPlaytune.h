@@ -0,0 +1,59 @@
+/**
+ * ArduboyPlaytune
+ *
+ * The score interpreter of the stock ArduboyPlaytune library
+ * https://github.com/Arduboy/ArduboyPlaytune
+ * for the score renderer, in which the games built on Arduboy 1.1.1 play their
+ * scores by the same interpreter as its ArduboyTunes. Give the "src" directory
+ * of the library by ARDUBOY_PLAYTUNE_DIR to scorerender.sh to render by the
+ * library itself instead.
+ *
+ * Based on work (c) Copyright 2016, Chris J. Martinez, Kevin Bates, Josh Goebel, Scott Allen
+ * Derived from Playtune by Len Shustek (c) Copyright 2011, 2015
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#define AVAILABLE_TIMERS 2
+
+#define TUNE_OP_PLAYNOTE  0x90  /* play a note: low nibble is generator #, note is next byte */
+#define TUNE_OP_STOPNOTE  0x80  /* stop a note: low nibble is generator # */
+#define TUNE_OP_RESTART   0xe0  /* restart the score from the beginning */
+#define TUNE_OP_STOP      0xf0  /* stop playing */
+
+class ArduboyPlaytune
+{
+public:
+    ArduboyPlaytune(boolean (*outEn)());
+    void initChannel(byte pin);
+    void playScore(const byte *score);
+    void stopScore();
+    boolean playing();
+    void tone(unsigned int frequency, unsigned long duration);
+    void toneMutesScore(boolean mute);
+    void closeChannels();
+
+    static void playNote(byte chan, byte note);
+    static void stopNote(byte chan);
+    static void step();
+};
@@ -0,0 +1,362 @@
+/*
+ * Renderer of the sound scores of a game to wave files on the host.
+ *
+ * The sound player of the game, its own MyArduboyPlaytune.cpp or
+ * ArduboyPlaytune.cpp of the stock library, is built into this file against
+ * the stand-ins of include/, so the scores are played by the same interpreter
+ * and interrupt routines as on the Arduboy. The timers 1 and 3 are run by CPU
+ * cycles from their registers, their ISRs are called at every compare match,
+ * and the levels of the speaker pins are integrated into 16-bit samples.
+ * Every "sound*[]" array in the given source files, each row of a
+ * two-dimensional one as well, is rendered to <dir>/<name>.wav.
+ *
+ * Build: c++ -O2 -std=gnu++11 -fpermissive -w -I etc/scorerender/include \
+ *            -DPLAYER='"../../<game>/MyArduboyPlaytune.cpp"' \
+ *            -o scorerender etc/scorerender/scorerender.cpp
+ *        For a game which uses the stock library, give -DSTOCK_PLAYER and
+ *        -I etc/scorerender/playtune, or -I <ArduboyPlaytune>/src, instead
+ *        of -DPLAYER.
+ *        See scorerender.sh, which builds and checks every game.
+ *
+ * Usage: scorerender [-r rate] [-m max sec] [-o dir] [-v] <source files...>
+ */
+
+#include <regex>
+#include <stdio.h>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+#include <vector>
+
+#include <Arduboy2.h>
+
+/*  Registers of include/avr/io.h  */
+
+volatile uint8_t    PORTC, DDRC;
+volatile uint8_t    TCCR1A, TCCR1B, TIMSK1;
+volatile uint8_t    TCCR3A, TCCR3B, TIMSK3;
+volatile uint8_t    TCCR4A, TCCR4B, TCCR4C, TCCR4D;
+volatile uint16_t   OCR1A, TCNT1, OCR3A, TCNT3;
+volatile uint8_t    OCR4A;
+
+/*  The player  */
+
+#ifdef STOCK_PLAYER
+
+#include <ArduboyPlaytune.cpp>
+
+static ArduboyPlaytune tunes(Arduboy2Audio::enabled);
+
+static void resetPlayer(void)
+{
+    static bool isInitialized = false;
+    if (!isInitialized) {
+        tunes.initChannel(PIN_SPEAKER_1);
+        isInitialized = true;
+    }
+    tunes.stopScore();
+}
+
+static void startScore(const byte *score) { tunes.playScore(score); }
+static bool isPlaying(void) { return tunes.playing(); }
+
+#else
+
+#include PLAYER
+
+size_t MyArduboy2::write(uint8_t) { return 0; }
+
+static MyArduboy2 arduboy;
+
+static void resetPlayer(void) { arduboy.initAudio(1); }
+static void startScore(const byte *score) { arduboy.playScore(score); }
+static bool isPlaying(void) { return isScorePlaying; }
+
+#endif
+
+/*  Defines  */
+
+#define RATE_DEFAULT    44100
+#define MAX_SEC_DEFAULT 30
+#define AMPLITUDE       0x3FFF
+#define NEVER           UINT64_MAX
+#define TCNT_UNTOUCHED  0xFFFF
+
+/*  Typedefs  */
+
+typedef struct {
+    volatile uint8_t    *pTccrB, *pTimsk;
+    volatile uint16_t   *pOcr, *pTcnt;
+    void                (*isr)(void);
+    uint64_t            next; // cycle of the next compare match
+} TIMER_T;
+
+typedef struct {
+    std::string             name;
+    std::vector<uint8_t>    bytes;
+} SCORE_T;
+
+/*  Local Variables  */
+
+/*  In the order of the priority of the interrupts  */
+static TIMER_T timers[] = {
+    { &TCCR1B, &TIMSK1, &OCR1A, &TCNT1, TIMER1_COMPA_vect },
+    { &TCCR3B, &TIMSK3, &OCR3A, &TCNT3, TIMER3_COMPA_vect },
+};
+
+static uint64_t             cycle, sampleStart;
+static int64_t              levelSum;
+static uint32_t             rate = RATE_DEFAULT;
+static std::vector<int16_t> samples;
+static bool                 isVerbose;
+
+/*---------------------------------------------------------------------------*/
+/*                                  Timers                                   */
+/*---------------------------------------------------------------------------*/
+
+static uint32_t getPeriod(const TIMER_T &t)
+{
+    static const uint16_t prescalers[] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+    return (uint32_t) (*t.pOcr + 1) * prescalers[*t.pTccrB & 7];
+}
+
+/*  Marks the counters to know which timers the player restarts  */
+static void touchTimers(void)
+{
+    for (TIMER_T &t : timers) *t.pTcnt = TCNT_UNTOUCHED;
+}
+
+/*  Schedules the timers after the player is called or the ISR of pFired is done  */
+static void updateTimers(const TIMER_T *pFired)
+{
+    for (TIMER_T &t : timers) {
+        uint32_t period = getPeriod(t);
+        if (!(*t.pTimsk & _BV(OCIE1A)) || period == 0) {
+            t.next = NEVER;
+        } else if (*t.pTcnt == 0 || &t == pFired || t.next == NEVER) {
+            t.next = cycle + period;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                 Rendering                                 */
+/*---------------------------------------------------------------------------*/
+
+/*  Integrates the level of the speaker, driven by two pins in push-pull, until the cycle  */
+static void advance(uint64_t to)
+{
+    int level = ((PORTC >> 6) & 1) - ((PORTC >> 7) & 1);
+    while (cycle < to) {
+        uint64_t sampleEnd = (samples.size() + 1) * F_CPU / rate;
+        uint64_t end = min(to, sampleEnd);
+        levelSum += level * (int64_t) (end - cycle);
+        cycle = end;
+        if (cycle == sampleEnd) {
+            samples.push_back(levelSum * AMPLITUDE / (int64_t) (sampleEnd - sampleStart));
+            sampleStart = sampleEnd;
+            levelSum = 0;
+        }
+    }
+}
+
+/*  Plays the score until it stops or the cycle reaches the limit, and returns true if it has stopped  */
+static bool render(const SCORE_T &score, uint64_t maxCycles)
+{
+    samples.clear();
+    cycle = sampleStart = 0;
+    levelSum = 0;
+    PORTC = 0;
+    for (TIMER_T &t : timers) t.next = NEVER;
+    resetPlayer();
+    touchTimers();
+    startScore(score.bytes.data());
+    updateTimers(NULL);
+
+    while (isPlaying() && cycle < maxCycles) {
+        TIMER_T *pFired = NULL;
+        for (TIMER_T &t : timers) {
+            if (t.next != NEVER && (pFired == NULL || t.next < pFired->next)) pFired = &t;
+        }
+        if (pFired == NULL) break;
+        advance(min(pFired->next, maxCycles));
+        if (cycle < pFired->next) break;
+        touchTimers();
+        pFired->isr();
+        updateTimers(pFired);
+    }
+    bool ret = !isPlaying();
+    if (cycle > sampleStart) advance((samples.size() + 1) * F_CPU / rate); // flush the last sample
+    return ret;
+}
+
+static bool writeWave(const std::string &path)
+{
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp == NULL) return false;
+    uint32_t size = samples.size() * 2;
+    uint32_t header[] = {
+        0x46464952, 36 + size, 0x45564157,         // "RIFF", size, "WAVE"
+        0x20746D66, 16, 0x00010001, rate, rate * 2, // "fmt ", linear PCM, mono
+        0x00100002, 0x61746164, size,               // 16 bits, "data", size
+    };
+    for (uint32_t v : header) {
+        for (int i = 0; i < 4; i++, v >>= 8) fputc(v & 0xFF, fp);
+    }
+    for (int16_t v : samples) {
+        fputc(v & 0xFF, fp);
+        fputc((uint16_t) v >> 8, fp);
+    }
+    return fclose(fp) == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Sources                                  */
+/*---------------------------------------------------------------------------*/
+
+/*  Removes the comments, leaving the string literals as they are  */
+static std::string stripComments(const std::string &src)
+{
+    std::string ret;
+    for (size_t i = 0; i < src.size(); i++) {
+        char c = src[i];
+        if (c == '"' || c == '\'') {
+            size_t j = i + 1;
+            while (j < src.size() && src[j] != c) j += (src[j] == '\\') ? 2 : 1;
+            ret.append(src, i, j + 1 - i);
+            i = j;
+        } else if (src.compare(i, 2, "//") == 0) {
+            i = src.find('\n', i) - 1;
+        } else if (src.compare(i, 2, "/*") == 0) {
+            i = min(src.find("*/", i + 2), src.size()) + 1;
+            ret += ' ';
+        } else {
+            ret += c;
+        }
+    }
+    return ret;
+}
+
+static bool parseBytes(const std::string &body, std::vector<uint8_t> &bytes)
+{
+    size_t pos = 0;
+    while (pos < body.size()) {
+        size_t end = body.find(',', pos);
+        if (end == std::string::npos) end = body.size();
+        std::string token = body.substr(pos, end - pos);
+        token.erase(0, token.find_first_not_of(" \t\r\n"));
+        token.erase(token.find_last_not_of(" \t\r\n") + 1);
+        if (!token.empty()) {
+            char *p;
+            long v = strtol(token.c_str(), &p, 0);
+            if (*p != '\0') return false;
+            bytes.push_back(v);
+        }
+        pos = end + 1;
+    }
+    return true;
+}
+
+/*  Finds the scores, making one of each row of a two-dimensional array  */
+static bool findScores(const char *path, std::vector<SCORE_T> &scores)
+{
+    static const std::regex reScore(
+            "const\\s+(?:byte|uint8_t)\\s+(sound\\w*)\\s*(\\[\\s*\\w*\\s*\\]\\s*)+(?:PROGMEM\\s*)?=\\s*\\{");
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        perror(path);
+        return false;
+    }
+    std::string src;
+    char buf[4096];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), fp)) > 0; ) src.append(buf, n);
+    fclose(fp);
+    src = stripComments(src);
+
+    for (std::sregex_iterator it(src.begin(), src.end(), reScore), last; it != last; ++it) {
+        std::string name = (*it)[1];
+        size_t start = it->position() + it->length(), end = start;
+        for (int depth = 1; depth > 0 && end < src.size(); end++) {
+            if (src[end] == '{') depth++;
+            if (src[end] == '}') depth--;
+        }
+        std::string body = src.substr(start, end - 1 - start);
+        std::vector<std::string> rows;
+        if (body.find('{') == std::string::npos) {
+            rows.push_back(body);
+        } else {
+            for (size_t pos = body.find('{'); pos != std::string::npos; pos = body.find('{', pos)) {
+                size_t rowEnd = body.find('}', pos);
+                rows.push_back(body.substr(pos + 1, rowEnd - pos - 1));
+                pos = rowEnd;
+            }
+        }
+        for (size_t i = 0; i < rows.size(); i++) {
+            SCORE_T score;
+            score.name = (rows.size() > 1) ? name + "_" + std::to_string(i) : name;
+            if (!parseBytes(rows[i], score.bytes)) {
+                fprintf(stderr, "%s: %s: Not a list of numbers\n", path, score.name.c_str());
+                return false;
+            }
+            score.bytes.push_back(0xF0); // a score which runs off the end of the array stops
+            scores.push_back(score);
+        }
+    }
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static double getSeconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    double maxSec = MAX_SEC_DEFAULT;
+    std::string outDir = ".";
+    int opt;
+    while ((opt = getopt(argc, argv, "r:m:o:v")) != -1) {
+        switch (opt) {
+        case 'r': rate = atoi(optarg);      break;
+        case 'm': maxSec = atof(optarg);    break;
+        case 'o': outDir = optarg;          break;
+        case 'v': isVerbose = true;         break;
+        default:
+            optind = argc;
+            break;
+        }
+    }
+    if (optind >= argc || rate == 0) {
+        fprintf(stderr, "Usage: %s [-r rate] [-m max sec] [-o dir] [-v] <source files...>\n", argv[0]);
+        return 2;
+    }
+
+    double playSec = 0, startSec = getSeconds();
+    int count = 0;
+    for (int i = optind; i < argc; i++) {
+        std::vector<SCORE_T> scores;
+        if (!findScores(argv[i], scores)) return 1;
+        for (const SCORE_T &score : scores) {
+            bool isStopped = render(score, maxSec * F_CPU);
+            std::string path = outDir + "/" + score.name + ".wav";
+            if (!writeWave(path)) {
+                perror(path.c_str());
+                return 1;
+            }
+            playSec += (double) samples.size() / rate;
+            count++;
+            if (isVerbose) {
+                printf("%s: %s %d bytes, %d ms%s\n", argv[i], score.name.c_str(), (int) score.bytes.size() - 1,
+                        (int) (samples.size() * 1000 / rate), (isStopped) ? "" : " (endless, cut)");
+            }
+        }
+    }
+    double elapsedSec = getSeconds() - startSec;
+    printf("%d scores, %.1f s rendered in %.3f s (%.0f times realtime)\n",
+            count, playSec, elapsedSec, playSec / max(elapsedSec, 0.001));
+    return 0;
+}
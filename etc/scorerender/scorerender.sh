@@ -0,0 +1,82 @@
+#!/usr/bin/env bash
+
+# Render every "sound*[]" array of the games by the sound player of each game
+# and compare the renders with the golden files. A game with its own
+# MyArduboyPlaytune.cpp is built with it. A game of the stock ArduboyPlaytune,
+# or of ArduboyTunes of Arduboy 1.1.1 which has the same interpreter, is built
+# with the copy of the interpreter in "playtune", or with the library found at
+# ARDUBOY_PLAYTUNE_DIR (its "src" directory) when it is given.
+#
+# Usage: etc/scorerender/scorerender.sh [-u] [<project>...]
+#   -u  Store the renders as the new golden files
+
+RENDER_DIR=`dirname $0`
+BUILD_DIR="${RENDER_DIR}/_build"
+GOLDEN_DIR="${RENDER_DIR}/golden"
+CXX=${CXX:-c++}
+CXXFLAGS='-O2 -std=gnu++11 -fpermissive -w'
+RATE=11025
+MAX_SEC=5
+
+update=0
+if [ "$1" = '-u' ]
+then
+	update=1
+	shift
+fi
+
+if [ $# -ge 1 ]
+then
+	projects=$@
+else
+	projects=`ls */*.ino | xargs -n 1 dirname`
+fi
+
+failed=0
+for project in ${projects}
+do
+	sources=`ls ${project}/*.ino ${project}/*.h ${project}/*.cpp 2>/dev/null | grep -v '/MyArduboy'`
+	grep -q 'const \(byte\|uint8_t\) sound' ${sources} || continue
+	if [ -f ${project}/MyArduboyPlaytune.cpp ]
+	then
+		player=("-DPLAYER=\"../../${project}/MyArduboyPlaytune.cpp\"")
+	elif [ -f "${ARDUBOY_PLAYTUNE_DIR:=${RENDER_DIR}/playtune}/ArduboyPlaytune.cpp" ]
+	then
+		player=(-DSTOCK_PLAYER -I "${ARDUBOY_PLAYTUNE_DIR}")
+	else
+		echo "--- ${project}: No ArduboyPlaytune.cpp in ${ARDUBOY_PLAYTUNE_DIR}" >&2
+		failed=1
+		continue
+	fi
+
+	out="${BUILD_DIR}/${project}"
+	rm -rf ${out}
+	mkdir -p ${out}/wav || exit 1
+	${CXX} ${CXXFLAGS} -I ${RENDER_DIR}/include "${player[@]}" \
+			-o ${out}/scorerender ${RENDER_DIR}/scorerender.cpp || exit 1
+	echo -n "${project}: "
+	${out}/scorerender -r ${RATE} -m ${MAX_SEC} -o ${out}/wav ${sources} || exit 1
+
+	golden="${GOLDEN_DIR}/${project}"
+	if [ ${update} -eq 1 ]
+	then
+		rm -rf ${golden}
+		mkdir -p ${GOLDEN_DIR} && cp -r ${out}/wav ${golden} || exit 1
+	elif [ ! -d ${golden} ]
+	then
+		echo "--- ${project}: No golden renders" >&2
+		failed=1
+	elif ! diff -r ${golden} ${out}/wav >&2
+	then
+		echo "--- ${project}: Renders differ from the golden files" >&2
+		failed=1
+	fi
+done
+
+[ ${failed} -eq 0 ] || exit 1
+if [ ${update} -eq 1 ]
+then
+	echo "--- Golden files updated"
+else
+	echo "--- All renders match"
+fi
@@ -0,0 +1,347 @@
+package main
+
+/*
+Pack lines of text into a corpus for MyCorpus.h.
+
+Each line of the text file is an entry, and lines beginning with '#' are
+ignored. The characters and the terminator of the entries are coded by a
+canonical Huffman code, limited to 12 bits so that a character is decoded in a
+bounded number of steps. With -kana, katakana are converted into the codes of
+morse (0x60 to 0x93 in iroha order), and voiced ones are split into the base
+and the sound mark.
+
+Layout (little endian):
+
+	uint16_t count          number of entries
+	uint8_t  shift          entries start at multiples of (1 << shift) bits
+	uint8_t  maxLength      longest code length
+	uint8_t  lengths[maxLength]   number of codes of each length
+	uint8_t  symbols[]      characters in the canonical order, '\0' ends an entry
+	uint16_t offsets[count] start bit of each entry >> shift
+	uint8_t  data[]         codes from the most significant bit
+
+Usage: go run textcorpus.go [-kana] [-maxlen n] [-o file.bin] <text file>
+*/
+
+import (
+	"bufio"
+	"container/heap"
+	"flag"
+	"fmt"
+	"os"
+	"sort"
+	"strings"
+)
+
+const codeLengthMax = 12
+
+const kanaIroha = "イロハニホヘトチリヌルヲワカヨタレソツネナラムウヰノオクヤマケフコエテアサキユメミシヱヒモセスン゛゜ー、"
+
+/*---------------------------------------------------------------------------*/
+/*                                   Text                                    */
+/*---------------------------------------------------------------------------*/
+
+func convertKana(line string) (string, error) {
+	codes := map[rune]byte{}
+	for i, r := range []rune(kanaIroha) {
+		codes[r] = byte(0x60 + i)
+	}
+	var sb strings.Builder
+	for _, r := range line {
+		switch {
+		case r < 0x80:
+			sb.WriteByte(byte(r))
+		case codes[r] != 0:
+			sb.WriteByte(codes[r])
+		case r == 'ヴ':
+			sb.WriteByte(codes['ウ'])
+			sb.WriteByte(codes['゛'])
+		case codes[r-1] != 0 && strings.ContainsRune("ガギグゲゴザジズゼゾダヂヅデドバビブベボ", r):
+			sb.WriteByte(codes[r-1])
+			sb.WriteByte(codes['゛'])
+		case codes[r-2] != 0 && strings.ContainsRune("パピプペポ", r):
+			sb.WriteByte(codes[r-2])
+			sb.WriteByte(codes['゜'])
+		default:
+			return "", fmt.Errorf("%q can't be converted", r)
+		}
+	}
+	return sb.String(), nil
+}
+
+func readEntries(path string, isKana bool) ([]string, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	var entries []string
+	scanner := bufio.NewScanner(f)
+	for line := 1; scanner.Scan(); line++ {
+		text := strings.TrimRight(scanner.Text(), "\r")
+		if text == "" || text[0] == '#' {
+			continue
+		}
+		if isKana {
+			if text, err = convertKana(text); err != nil {
+				return nil, fmt.Errorf("line %d: %v", line, err)
+			}
+		}
+		for i := 0; i < len(text); i++ {
+			if text[i] == 0 || text[i] >= 0x80 && !isKana {
+				return nil, fmt.Errorf("line %d: unsupported character %q", line, text[i])
+			}
+		}
+		entries = append(entries, text)
+	}
+	return entries, scanner.Err()
+}
+
+/*---------------------------------------------------------------------------*/
+/*                               Huffman Code                                */
+/*---------------------------------------------------------------------------*/
+
+type node struct {
+	freq   int
+	symbol int // -1 for an inner node
+	left   *node
+	right  *node
+}
+
+type nodeHeap []*node
+
+func (h nodeHeap) Len() int            { return len(h) }
+func (h nodeHeap) Less(i, j int) bool  { return h[i].freq < h[j].freq }
+func (h nodeHeap) Swap(i, j int)       { h[i], h[j] = h[j], h[i] }
+func (h *nodeHeap) Push(x interface{}) { *h = append(*h, x.(*node)) }
+func (h *nodeHeap) Pop() interface{} {
+	old := *h
+	n := old[len(old)-1]
+	*h = old[:len(old)-1]
+	return n
+}
+
+/*  Code lengths, halving the frequencies until the longest code fits  */
+func codeLengths(freqs map[byte]int) map[byte]int {
+	scaled := map[byte]int{}
+	for s, f := range freqs {
+		scaled[s] = f
+	}
+	for {
+		h := &nodeHeap{}
+		symbols := make([]int, 0, len(scaled))
+		for s := range scaled {
+			symbols = append(symbols, int(s))
+		}
+		sort.Ints(symbols)
+		for _, s := range symbols {
+			heap.Push(h, &node{freq: scaled[byte(s)], symbol: s})
+		}
+		for h.Len() > 1 {
+			a, b := heap.Pop(h).(*node), heap.Pop(h).(*node)
+			heap.Push(h, &node{freq: a.freq + b.freq, symbol: -1, left: a, right: b})
+		}
+		lengths := map[byte]int{}
+		var walk func(n *node, depth int)
+		walk = func(n *node, depth int) {
+			if n.symbol >= 0 {
+				lengths[byte(n.symbol)] = max(depth, 1)
+				return
+			}
+			walk(n.left, depth+1)
+			walk(n.right, depth+1)
+		}
+		walk(heap.Pop(h).(*node), 0)
+		maxLength := 0
+		for _, l := range lengths {
+			maxLength = max(maxLength, l)
+		}
+		if maxLength <= codeLengthMax {
+			return lengths
+		}
+		for s := range scaled {
+			scaled[s] = (scaled[s] + 1) / 2
+		}
+	}
+}
+
+type code struct {
+	bits, length int
+}
+
+/*  Symbols in the canonical order and their codes  */
+func canonicalCodes(lengths map[byte]int) ([]byte, map[byte]code) {
+	var symbols []byte
+	for s := range lengths {
+		symbols = append(symbols, s)
+	}
+	sort.Slice(symbols, func(i, j int) bool {
+		li, lj := lengths[symbols[i]], lengths[symbols[j]]
+		return li < lj || li == lj && symbols[i] < symbols[j]
+	})
+	codes := map[byte]code{}
+	bits, length := 0, 0
+	for _, s := range symbols {
+		bits <<= lengths[s] - length
+		length = lengths[s]
+		codes[s] = code{bits, length}
+		bits++
+	}
+	return symbols, codes
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Corpus                                   */
+/*---------------------------------------------------------------------------*/
+
+type bitWriter struct {
+	data []byte
+	bits int
+}
+
+func (w *bitWriter) write(c code) {
+	for i := c.length - 1; i >= 0; i-- {
+		if w.bits%8 == 0 {
+			w.data = append(w.data, 0)
+		}
+		if c.bits>>i&1 != 0 {
+			w.data[w.bits/8] |= 0x80 >> (w.bits % 8)
+		}
+		w.bits++
+	}
+}
+
+func (w *bitWriter) align(shift int) {
+	for w.bits%(1<<shift) != 0 {
+		if w.bits%8 == 0 {
+			w.data = append(w.data, 0)
+		}
+		w.bits++
+	}
+}
+
+func build(entries []string, symbols []byte, codes map[byte]code) ([]byte, int, error) {
+	for shift := 0; shift < 8; shift++ {
+		w := &bitWriter{}
+		var offsets []int
+		for _, e := range entries {
+			w.align(shift)
+			offsets = append(offsets, w.bits>>shift)
+			for i := 0; i < len(e); i++ {
+				w.write(codes[e[i]])
+			}
+			w.write(codes[0])
+		}
+		if offsets[len(offsets)-1] > 0xFFFF {
+			continue
+		}
+
+		maxLength := 0
+		for _, c := range codes {
+			maxLength = max(maxLength, c.length)
+		}
+		lengths := make([]byte, maxLength)
+		for _, c := range codes {
+			lengths[c.length-1]++
+		}
+		out := []byte{byte(len(entries)), byte(len(entries) >> 8), byte(shift), byte(maxLength)}
+		out = append(out, lengths...)
+		out = append(out, symbols...)
+		for _, o := range offsets {
+			out = append(out, byte(o), byte(o>>8))
+		}
+		return append(out, w.data...), shift, nil
+	}
+	return nil, 0, fmt.Errorf("too large")
+}
+
+/*  Same as MyCorpus::seek() and MyCorpus::next()  */
+func decode(corpus []byte, idx int) string {
+	count, shift, maxLength := int(corpus[0])|int(corpus[1])<<8, int(corpus[2]), int(corpus[3])
+	pLengths := 4
+	pSymbols := pLengths + maxLength
+	symbolsNum := 0
+	for i := 0; i < maxLength; i++ {
+		symbolsNum += int(corpus[pLengths+i])
+	}
+	pOffsets := pSymbols + symbolsNum
+	pData := pOffsets + count*2
+	bit := (int(corpus[pOffsets+idx*2]) | int(corpus[pOffsets+idx*2+1])<<8) << shift
+	var sb strings.Builder
+	for {
+		c, first, index, symbol := 0, 0, 0, -1
+		for length := 0; length < maxLength && symbol < 0; length++ {
+			if pData+bit/8 < len(corpus) && corpus[pData+bit/8]&(0x80>>(bit%8)) != 0 {
+				c |= 1
+			}
+			bit++
+			n := int(corpus[pLengths+length])
+			if c < first+n {
+				symbol = int(corpus[pSymbols+index+c-first])
+			}
+			index += n
+			first = (first + n) << 1
+			c <<= 1
+		}
+		if symbol <= 0 {
+			return sb.String()
+		}
+		sb.WriteByte(byte(symbol))
+	}
+}
+
+func main() {
+	isKana := flag.Bool("kana", false, "convert katakana into the codes of morse")
+	maxLen := flag.Int("maxlen", 0, "maximum characters of an entry (0: unlimited)")
+	out := flag.String("o", "corpus.bin", "output file")
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+	entries, err := readEntries(flag.Arg(0), *isKana)
+	if err == nil && len(entries) == 0 {
+		err = fmt.Errorf("%s: no entries", flag.Arg(0))
+	}
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	freqs := map[byte]int{0: len(entries)}
+	chars := 0
+	for i, e := range entries {
+		if *maxLen > 0 && len(e) > *maxLen {
+			fmt.Fprintf(os.Stderr, "entry %d is longer than %d characters\n", i+1, *maxLen)
+			os.Exit(1)
+		}
+		for j := 0; j < len(e); j++ {
+			freqs[e[j]]++
+		}
+		chars += len(e) + 1
+	}
+	symbols, codes := canonicalCodes(codeLengths(freqs))
+	corpus, shift, err := build(entries, symbols, codes)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	for i, e := range entries {
+		if decode(corpus, i) != e {
+			fmt.Fprintf(os.Stderr, "entry %d isn't decoded correctly\n", i+1)
+			os.Exit(1)
+		}
+	}
+	if err := os.WriteFile(*out, corpus, 0644); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	fixedBits := 1
+	for 1<<fixedBits < len(symbols) {
+		fixedBits++
+	}
+	fmt.Printf("%s: %d entries, %d characters, %d symbols, shift %d, %d bytes (%.2f bits/char, fixed %d bits: %d bytes)\n",
+		*out, len(entries), chars, len(symbols), shift, len(corpus),
+		float64(len(corpus)*8)/float64(chars), fixedBits, (chars*fixedBits+7)/8+len(entries)*2)
+}
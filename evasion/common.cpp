@@ -206,22 +206,7 @@ void drawTime(int16_t x, int16_t y, uint32_t frames)
 void drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h)
 {
     uint16_t size = w * ((h + 7) >> 3);
-    arduboy.drawBitmap(x, y, bitmap, w, h, BLACK);
-    arduboy.drawBitmap(x, y, bitmap + size, w, h);
-}
-
-void drawBitmapBordered(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h)
-{
-    for (int i = 0; i <= 4; i++) {
-        int16_t dx, dy;
-        if (i == 4) {
-            dx = dy = 0;
-        } else {
-            dx = (i * 2 + 1) % 3 - 1;
-            dy = (i * 2 + 1) / 3 - 1;
-        }
-        arduboy.drawBitmap(x + dx, y + dy, bitmap, w, h, (i == 4)); 
-    }
+    arduboy.drawBitmapWithMask(x, y, bitmap + size, bitmap, w, h);
 }
 
 SIMPLE_OP_T handleSimpleMode(void)
@@ -338,27 +323,27 @@ void eepReadBlock(void *p, size_t n)
 void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
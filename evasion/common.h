@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MyArduboy2.h"
+#include "MyRandom.h"
 
 /*  Defines  */
 
@@ -46,7 +47,6 @@ void    clearRecord(void);
 void    handleDPad(void);
 void    drawTime(int16_t x, int16_t y, uint32_t frames);
 void    drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
-void    drawBitmapBordered(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
 SIMPLE_OP_T handleSimpleMode(void);
 void    drawSimpleModeInstruction(void);
 
@@ -3,7 +3,7 @@
 
 /*  Defines  */
 
-#define PILLARS_NUM     16
+#define PILLARS_NUM     32
 #define DOTS_NUM        64
 
 #define OBJECT_X_MIN    -128
@@ -73,6 +73,7 @@ static void     drawPlayer(int16_t x, int16_t y, uint8_t idx);
 static void     drawDotsPlaying(void);
 static void     drawDotsDeath(void);
 static void     drawScore(void);
+static void     fillPillarSpans(uint8_t *pCoverage, int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t dither);
 static void     fillDitheredRect(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t dither);
 
 /*  Local Functions (macros)  */
@@ -97,6 +98,7 @@ static uint16_t score, accelInt;
 static uint8_t  pillarsTopIdx, pillarsSpeed, pillarsZOdd, dotsBaseX, dotsBaseZ;
 static int8_t   playerVx, nextDistance, shakeX, shakeY;
 static bool     isHiscore;
+static MyRandom pillarRandom, effectRandom;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -189,8 +191,8 @@ static void handlePlaying(void)
 static void handleDeath(void)
 {
     uint8_t shake = 5 - counter / 10;
-    shakeX = random(-shake, shake + 1);
-    shakeY = random(-shake, shake + 1);
+    shakeX = effectRandom.range(-shake, shake + 1);
+    shakeY = effectRandom.range(-shake, shake + 1);
     updateDotsDeath();
     if (++counter >= FPS) {
         counter = 0;
@@ -227,6 +229,8 @@ static void handleOver(void)
 static void initObjects(void)
 {
     /*  Init pillars  */
+    pillarRandom.setSeed(random());
+    effectRandom.setSeed(random());
     memset(pillars, 0, sizeof(pillars));
     pillarsTopIdx = 0;
     pillarsSpeed = (record.speed + 3) << 3;
@@ -239,8 +243,8 @@ static void initObjects(void)
 
     /*  Init dots  */
     for (DOT_T *p = dots; p < dots + DOTS_NUM; p++) {
-        p->rect.x = random(OBJECT_X_MIN, OBJECT_X_MAX);
-        p->rect.y = random(-HEIGHT / 2, HEIGHT / 2);
+        p->rect.x = effectRandom.range(OBJECT_X_MIN, OBJECT_X_MAX);
+        p->rect.y = effectRandom.range(-HEIGHT / 2, HEIGHT / 2);
     }
     dotsBaseX = 0;
     dotsBaseZ = 0;
@@ -274,9 +278,9 @@ static bool updateObjects(int8_t vx, uint8_t speed)
     /*  Append a pillar  */
     if (nextDistance <= 0 && !ret) {
         PILLAR_T *p = &pillars[pillarsTopIdx];
-        p->x = random(OBJECT_X_MIN, OBJECT_X_MAX);
+        p->x = pillarRandom.range(OBJECT_X_MIN, OBJECT_X_MAX);
         p->z = -nextDistance;
-        p->w = random(record.thickness) + record.thickness + 3;
+        p->w = pillarRandom.below(record.thickness) + record.thickness + 3;
         pillarsTopIdx = (pillarsTopIdx + 1) & (PILLARS_NUM - 1); // % PILLARS_NUM;
         nextDistance += 36 - record.density * 4;
     }
@@ -287,7 +291,7 @@ static void initDotsDeath(void)
 {
     for (DOT_T *p = dots; p < dots + DOTS_NUM; p++) {
         p->polar.r = 0;
-        p->polar.v = random(16, 45);
+        p->polar.v = effectRandom.range(16, 45);
     }
 }
 
@@ -384,7 +388,7 @@ static void drawOver(void)
         arduboy.printEx(0, 14, "HI:");
         arduboy.print(record.hiscore / 6);
     }
-    drawBitmapBordered((WIDTH - IMG_GAMEOVER_W) / 2, 16, imgGameOver,
+    arduboy.drawBitmapBordered((WIDTH - IMG_GAMEOVER_W) / 2, 16, imgGameOver,
             IMG_GAMEOVER_W, IMG_GAMEOVER_H); 
     if (record.simpleMode) drawSimpleModeInstruction();
 }
@@ -398,15 +402,25 @@ static void drawMenu(void)
 
 static void drawPillars(void)
 {
-    for (PILLAR_T *p = pillars; p < pillars + PILLARS_NUM; p++) {
+    /*
+     *  Pillars are appended far and move at the same speed, so the ring is already sorted by
+     *  depth and the oldest one is the nearest. A nearer pillar is taller and denser than any
+     *  farther one, so columns covered by it can be skipped entirely.
+     */
+    uint8_t coverage[WIDTH / 8];
+    memset(coverage, 0, sizeof(coverage));
+    uint8_t idx = pillarsTopIdx;
+    do {
+        PILLAR_T *p = &pillars[idx];
+        idx = (idx + 1) & (PILLARS_NUM - 1); // % PILLARS_NUM
         if (!p->w) continue;
-        int8_t h = (HEIGHT * CAM_F) / ((CAM_F + PILLAR_Z_MAX) - p->z);
+        int8_t h = pgm_read_byte(perspectiveTable + (PILLAR_Z_MAX - p->z));
         int16_t x = WIDTH / 2 + ((p->x - p->w) * h >> 6) + shakeX;
         int16_t y = ((HEIGHT - h) >> 1) + shakeY;
         uint8_t w = p->w * h >> 5;
         uint8_t dither = (p->z <= PILLAR_Z_MAX / 2) ? p->z >> 4 : 7;
-        fillDitheredRect(x, y, w, h, dither);
-    }
+        fillPillarSpans(coverage, x, y, w, h, dither);
+    } while (idx != pillarsTopIdx);
 }
 
 static void drawPlayer(int16_t x, int16_t y, uint8_t idx)
@@ -418,7 +432,7 @@ static void drawDotsPlaying(void)
 {
     DOT_T *p = dots;
     for (int i = 0; i < DOTS_NUM; i++, p++) {
-        int8_t s = (HEIGHT * CAM_F) / (CAM_F + ((i + dotsBaseZ) & (DOTS_NUM - 1))); // % DOTS_NUM
+        int8_t s = pgm_read_byte(perspectiveTable + ((i + dotsBaseZ) & (DOTS_NUM - 1))); // % DOTS_NUM
         int16_t x = WIDTH / 2 + ((int8_t)(p->rect.x + dotsBaseX) * s >> 6);
         int16_t y = HEIGHT / 2 + (p->rect.y * s >> 6);
         if (y < 24 || x < 48 || x >= 80) arduboy.drawPixel(x, y);
@@ -451,6 +465,30 @@ static void drawScore(void)
     }
 }
 
+static void fillPillarSpans(uint8_t *pCoverage, int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t dither)
+{
+    /*  Check parameters  */
+    int16_t x1 = x + w;
+    if (x < 0) x = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+
+    /*  Fill uncovered spans and mark them covered  */
+    int16_t spanX = -1;
+    for (int16_t i = x; i < x1; i++) {
+        uint8_t *pByte = pCoverage + (i >> 3);
+        if (*pByte == 0xFF && (i & 7) == 0 && spanX < 0) {
+            i += 7; // skip 8 covered columns at once
+        } else if (bitRead(*pByte, i & 7)) {
+            if (spanX >= 0) fillDitheredRect(spanX, y, i - spanX, h, dither);
+            spanX = -1;
+        } else {
+            if (spanX < 0) spanX = i;
+            bitSet(*pByte, i & 7);
+        }
+    }
+    if (spanX >= 0) fillDitheredRect(spanX, y, x1 - spanX, h, dither);
+}
+
 static void fillDitheredRect(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t dither)
 {
     /*  Check parameters  */
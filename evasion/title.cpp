@@ -4,7 +4,7 @@
 
 #define SPEED_MAX       9
 #define ACCEL_MAX       3
-#define DENSITY_MAX     5
+#define DENSITY_MAX     7
 #define THICKNESS_MAX   5
 
 enum STATE_T : uint8_t {
@@ -54,7 +54,7 @@ static void drawCredit(void);
 static void drawNotice(void);
 
 static void drawGuy(int16_t x);
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 
 /*  Local Functions (macros)  */
 
@@ -354,7 +354,7 @@ static void drawInit(void)
     if (counter >= FPS / 2) {
         int16_t tmp = FPS - counter;
         int16_t x = WIDTH - IMG_TITLE_W - tmp * tmp / 7;
-        drawBitmapBordered(x, 16, imgTitle, IMG_TITLE_W, IMG_TITLE_H);
+        arduboy.drawBitmapBordered(x, 16, imgTitle, IMG_TITLE_W, IMG_TITLE_H);
     }
 }
 
@@ -362,7 +362,7 @@ static void drawTop(void)
 {
     if (isInvalid) {
         drawGuy(0);
-        drawBitmapBordered(WIDTH - IMG_TITLE_W, 16, imgTitle, IMG_TITLE_W, IMG_TITLE_H);
+        arduboy.drawBitmapBordered(WIDTH - IMG_TITLE_W, 16, imgTitle, IMG_TITLE_W, IMG_TITLE_H);
         if (record.hiscore > 0) {
             arduboy.printEx(0, 50, F("HI:"));
             arduboy.print(record.hiscore / 6);
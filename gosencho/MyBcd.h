@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*  Counter of (N * 2) decimal digits in packed BCD, little endian, which never divides  */
+
+template <uint8_t N>
+class MyBcd
+{
+public:
+    void     clear(void) { memset(d, 0, N); }
+    void     set(uint32_t v, uint8_t pos = 0);
+    uint32_t get(uint8_t pos = 0) const;
+    bool     add(uint32_t bcd, uint8_t pos = 0);
+    int8_t   compare(const MyBcd<N> &a) const;
+    uint8_t  digit(uint8_t i) const { return (i & 1) ? d[i >> 1] >> 4 : d[i >> 1] & 0xF; }
+    uint8_t  digits(void) const;
+
+private:
+    static uint8_t addByte(uint8_t a, uint8_t b, uint8_t &carry);
+    uint8_t  d[N];
+};
+
+/*  Replaces the digits from byte pos with the binary value by double dabble, which must fit  */
+template <uint8_t N>
+inline void MyBcd<N>::set(uint32_t v, uint8_t pos)
+{
+    memset(d + pos, 0, N - pos);
+    for (uint8_t i = 0; i < 32; i++, v <<= 1) {
+        uint8_t carry = (v >> 31);
+        for (uint8_t j = pos; j < N; j++) d[j] = addByte(d[j], d[j], carry);
+    }
+}
+
+/*  Binary value of 8 digits from byte pos  */
+template <uint8_t N>
+inline uint32_t MyBcd<N>::get(uint8_t pos) const
+{
+    uint32_t v = 0;
+    uint8_t top = (pos + 4 < N) ? pos + 4 : N;
+    for (int8_t i = top * 2 - 1; i >= pos * 2; i--) {
+        v = (v << 3) + (v << 1) + digit(i);
+    }
+    return v;
+}
+
+/*  Adds a value in packed BCD at byte pos, and saturates to all nines on overflow  */
+template <uint8_t N>
+inline bool MyBcd<N>::add(uint32_t bcd, uint8_t pos)
+{
+    uint8_t carry = 0;
+    for (uint8_t i = pos; i < N && (bcd || carry); i++, bcd >>= 8) {
+        d[i] = addByte(d[i], bcd & 0xFF, carry);
+    }
+    if (carry || bcd) {
+        memset(d, 0x99, N);
+        return false;
+    }
+    return true;
+}
+
+template <uint8_t N>
+inline int8_t MyBcd<N>::compare(const MyBcd<N> &a) const
+{
+    for (int8_t i = N - 1; i >= 0; i--) {
+        if (d[i] != a.d[i]) return (d[i] > a.d[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+/*  Number of significant digits, at least one  */
+template <uint8_t N>
+inline uint8_t MyBcd<N>::digits(void) const
+{
+    uint8_t n = N * 2;
+    while (n > 1 && digit(n - 1) == 0) n--;
+    return n;
+}
+
+template <uint8_t N>
+inline uint8_t MyBcd<N>::addByte(uint8_t a, uint8_t b, uint8_t &carry)
+{
+    uint8_t lo = (a & 0xF) + (b & 0xF) + carry;
+    uint8_t hi = (a >> 4) + (b >> 4);
+    if (lo >= 10) {
+        lo -= 10;
+        hi++;
+    }
+    carry = (hi >= 10);
+    if (carry) hi -= 10;
+    return hi << 4 | lo;
+}
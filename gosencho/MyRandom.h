@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*  Fast generator for independent streams (xorshift32, no multiply/divide in stepping)  */
+
+class MyRandom
+{
+public:
+    MyRandom(uint32_t seed = 1) { setSeed(seed); }
+    void     setSeed(uint32_t seed) { state = (seed) ? seed : 0x2545F491UL; }
+    uint32_t next(void) { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+    int16_t  below(int16_t n) { return (uint32_t)(uint16_t)(next() >> 16) * n >> 16; }
+    int16_t  range(int16_t min, int16_t max) { return (min < max) ? min + below(max - min) : min; }
+
+private:
+    uint32_t state;
+};
+
+/*  Reproduces the sequence of Arduino's random() and randomSeed() for existing seeds  */
+
+class MyRandomCompat
+{
+public:
+    MyRandomCompat(uint32_t seed = 1) : state(seed) {}
+    void     setSeed(uint32_t seed) { if (seed) state = seed; }
+    uint32_t next(void);
+    long     below(long n) { return (n) ? next() % n : 0; }
+    long     range(long min, long max) { return (min < max) ? min + below(max - min) : min; }
+
+private:
+    uint32_t state;
+};
+
+inline uint32_t MyRandomCompat::next(void)
+{
+    /*  Park-Miller "minimal standard" by Schrage's method, same as avr-libc  */
+    long x = (state) ? state : 123459876L;
+    long hi = x / 127773L;
+    long lo = x % 127773L;
+    x = 16807L * lo - 2836L * hi;
+    if (x < 0) x += 0x7FFFFFFFL;
+    state = x;
+    return x;
+}
@@ -1,19 +1,16 @@
 #include "common.h"
+#include "MyRecordRing.h"
 
 /*  Defines  */
 
-#define EEPROM_ADDR_BASE    608 // TODO
+#define EEPROM_ADDR_BASE    608 // Also the record until v0.01
+#define EEPROM_ADDR_EXTRA   16  // See "EEPROM map" of README.md
 #define EEPROM_SIGNATURE    0x164E424FUL // "OBN\x16"
+#define EEPROM_SLOTS        2   // Each slot is 13 bytes within 16 bytes of the window
 
 #define PAD_REPEAT_DELAY    (FPS / 4)
 #define PAD_REPEAT_INTERVAL (FPS / 12)
 
-enum RECORD_STATE_T : uint8_t {
-    RECORD_NOT_READ = 0,
-    RECORD_INITIAL,
-    RECORD_STORED,
-};
-
 /*  Global Variables  */
 
 MyArduboy2  ab;
@@ -24,7 +21,8 @@ bool        isInvalid, isRecordDirty;
 
 /*  Local Functions  */
 
-static uint16_t calcCheckSum();
+static bool     readLegacyRecord(void);
+static uint16_t calcCheckSum(void);
 
 static void     eepSeek(int addr);
 static uint8_t  eepRead8(void);
@@ -38,7 +36,10 @@ static void     eepWriteBlock(const void *p, size_t n);
 
 /*  Local Variables  */
 
-static RECORD_STATE_T   recordState = RECORD_NOT_READ;
+/*  The first write goes to the extra slot, so a record of v0.01 at the base survives until it succeeds  */
+PROGMEM static const uint16_t eepromSlotAddrs[EEPROM_SLOTS] = { EEPROM_ADDR_EXTRA, EEPROM_ADDR_BASE };
+
+static MyRecordRing     recordRing(eepromSlotAddrs, EEPROM_SLOTS, EEPROM_SIGNATURE, &record, sizeof(record));
 static int16_t          eepAddr;
 static bool             isInvalidInst;
 
@@ -48,19 +49,10 @@ static bool             isInvalidInst;
 
 void readRecord(void)
 {
-    bool isVerified = false;
-    eepSeek(EEPROM_ADDR_BASE);
-    if (eepRead32() == EEPROM_SIGNATURE) {
-        eepReadBlock(&record, sizeof(record));
-        isVerified = (eepRead16() == calcCheckSum());
-    }
-
-    if (isVerified) {
-        recordState = RECORD_STORED;
+    if (recordRing.read()) {
         isRecordDirty = false;
     } else {
-        memset(&record, 0, sizeof(record));
-        recordState = RECORD_INITIAL;
+        if (!readLegacyRecord()) memset(&record, 0, sizeof(record));
         isRecordDirty = true;
     }
     setSound(ab.isAudioEnabled()); // Load Sound ON/OFF
@@ -69,20 +61,25 @@ void readRecord(void)
 void writeRecord(void)
 {
     if (!isRecordDirty) return;
-    if (recordState == RECORD_INITIAL) {
-        eepSeek(EEPROM_ADDR_BASE);
-        eepWrite32(EEPROM_SIGNATURE);
-    } else {
-        eepSeek(EEPROM_ADDR_BASE + 4);
-    }
-    eepWriteBlock(&record, sizeof(record));
-    eepWrite16(calcCheckSum());
+    recordRing.write();
     ab.audio.saveOnOff(); // Save Sound ON/OFF
-    recordState = RECORD_STORED;
     isRecordDirty = false;
 }
 
-static uint16_t calcCheckSum()
+void clearRecord(void)
+{
+    recordRing.clear();
+}
+
+static bool readLegacyRecord(void)
+{
+    eepSeek(EEPROM_ADDR_BASE);
+    if (eepRead32() != EEPROM_SIGNATURE) return false;
+    eepReadBlock(&record, sizeof(record));
+    return (eepRead16() == calcCheckSum());
+}
+
+static uint16_t calcCheckSum(void)
 {
     uint16_t checkSum = (EEPROM_SIGNATURE & 0xFFFF) + (EEPROM_SIGNATURE >> 16) * 3;
     uint16_t *p = (uint16_t *) &record;
@@ -92,15 +89,6 @@ static uint16_t calcCheckSum()
     return checkSum;
 }
 
-void clearRecord(void)
-{
-    eepSeek(EEPROM_ADDR_BASE);
-    for (int i = 0; i < (sizeof(record) + 6) / 4; i++) {
-        eepWrite32(0);
-    }
-    recordState = RECORD_INITIAL;
-}
-
 void handleDPad(void)
 {
     padX = padY = 0;
@@ -203,27 +191,27 @@ void eepReadBlock(void *p, size_t n)
 void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "MyArduboy2.h"
+#include "MyBcd.h"
+#include "MyRandom.h"
 
 /*  Defines  */
 
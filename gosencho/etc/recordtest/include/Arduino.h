@@ -0,0 +1,12 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build MyRecordRing on the host.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_word(p)    (*(const uint16_t *) (p))
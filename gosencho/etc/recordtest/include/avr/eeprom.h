@@ -0,0 +1,18 @@
+#pragma once
+
+/*
+ * EEPROM of avr-libc on the host, whose stand-in is in recordtest.cpp.
+ * An address is given as a pointer, the same as on the AVR.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define eeprom_busy_wait()
+
+uint8_t     eeprom_read_byte(const uint8_t *p);
+uint16_t    eeprom_read_word(const uint16_t *p);
+void        eeprom_read_block(void *dst, const void *src, size_t n);
+void        eeprom_update_byte(uint8_t *p, uint8_t value);
+void        eeprom_update_word(uint16_t *p, uint16_t value);
+void        eeprom_update_block(const void *src, void *dst, size_t n);
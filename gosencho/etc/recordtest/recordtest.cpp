@@ -0,0 +1,307 @@
+/*
+ * Power loss test of MyRecordRing on a host stand-in of the EEPROM.
+ *
+ * Records are written one after another in the layouts of gosencho and the
+ * skeleton, and for every write the power is cut at each byte programmed by
+ * it, leaving that byte torn. After a cut the ring is read as at boot, and the
+ * record must be the one written before or the new one. Writing goes on from
+ * one of the cut states after a reboot, and the sequence number wraps around
+ * several times. Bytes outside the slots must never be written, and the
+ * record of gosencho v0.01 at its old address must survive until the first
+ * write into the ring has completed. The bytes programmed per write and the
+ * wear of the most programmed byte are reported.
+ *
+ * Build: c++ -O2 -std=gnu++11 -w -I gosencho/etc/recordtest/include \
+ *            -o recordtest gosencho/etc/recordtest/recordtest.cpp
+ *
+ * Usage: recordtest [-n writes] [-r seed] [-v]
+ */
+
+#include <random>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "../../MyRecordRing.h"
+
+/*  Defines  */
+
+#define EEPROM_SIZE     1024
+#define RECORD_SIZE     10  // sizeof(RECORD_T) on the AVR
+#define WRITES_DEFAULT  1000
+#define SLOTS_MAX       4
+
+typedef struct {
+    const char  *name;
+    uint16_t    addrs[SLOTS_MAX];
+    uint8_t     slots;
+    uint32_t    signature;
+    int16_t     legacyAddr; // -1 if none
+} LAYOUT_T;
+
+struct PowerLoss {};
+
+/*  Local Constants  */
+
+/*  Same as eepromSlotAddrs[] of common.cpp of each  */
+static const LAYOUT_T layouts[] = {
+    { "gosencho", { 16, 608 }, 2, 0x164E424FUL, 608 },
+    { "skeleton", { 16, 29, 42, 55 }, 4, 0x004E424FUL, -1 },
+};
+
+/*  Local Variables  */
+
+static uint8_t      eeprom[EEPROM_SIZE];
+static bool         isWritable[EEPROM_SIZE];
+static uint32_t     wear[EEPROM_SIZE];
+static long         programs, cutAt;
+static std::mt19937 rng;
+static bool         isVerbose;
+static int          failures;
+
+/*---------------------------------------------------------------------------*/
+/*                             EEPROM Stand-in                               */
+/*---------------------------------------------------------------------------*/
+
+static uint16_t toAddr(const void *p)
+{
+    uintptr_t addr = (uintptr_t) p;
+    if (addr >= EEPROM_SIZE) {
+        fprintf(stderr, "Access out of the EEPROM: %lu\n", (unsigned long) addr);
+        exit(1);
+    }
+    return addr;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *p)
+{
+    return eeprom[toAddr(p)];
+}
+
+uint16_t eeprom_read_word(const uint16_t *p)
+{
+    uint16_t addr = toAddr(p);
+    return eeprom[addr] | eeprom[toAddr((const uint8_t *) p + 1)] << 8;
+}
+
+void eeprom_read_block(void *dst, const void *src, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        ((uint8_t *) dst)[i] = eeprom_read_byte((const uint8_t *) src + i);
+    }
+}
+
+/*  A byte being programmed when the power is lost is left erased or partly programmed  */
+void eeprom_update_byte(uint8_t *p, uint8_t value)
+{
+    uint16_t addr = toAddr(p);
+    if (!isWritable[addr]) {
+        fprintf(stderr, "Write out of the slots: %d\n", addr);
+        failures++;
+    }
+    if (eeprom[addr] == value) return;
+    if (programs++ == cutAt) {
+        eeprom[addr] = (rng() & 1) ? 0xFF : value | (rng() & ~value & 0xFF);
+        throw PowerLoss();
+    }
+    eeprom[addr] = value;
+    wear[addr]++;
+}
+
+void eeprom_update_word(uint16_t *p, uint16_t value)
+{
+    eeprom_update_byte((uint8_t *) p, value & 0xFF);
+    eeprom_update_byte((uint8_t *) p + 1, value >> 8);
+}
+
+void eeprom_update_block(const void *src, void *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        eeprom_update_byte((uint8_t *) dst + i, ((const uint8_t *) src)[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Records                                  */
+/*---------------------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t bytes[RECORD_SIZE];
+} RECORD_T;
+
+static uint32_t getValue(const RECORD_T &r, int pos, int n)
+{
+    uint32_t v = 0;
+    for (int i = n - 1; i >= 0; i--) v = v << 8 | r.bytes[pos + i];
+    return v;
+}
+
+static void setValue(RECORD_T &r, int pos, int n, uint32_t v)
+{
+    for (int i = 0; i < n; i++, v >>= 8) r.bytes[pos + i] = v & 0xFF;
+}
+
+/*  Like gosencho, the money grows and the play count is incremented now and then  */
+static RECORD_T nextRecord(const RECORD_T &r)
+{
+    RECORD_T ret = r;
+    uint64_t money = getValue(r, 0, 4) | (uint64_t) getValue(r, 4, 4) << 32;
+    money += rng() % ((rng() % 8 == 0) ? 100000000 : 50000);
+    setValue(ret, 0, 4, money & 0xFFFFFFFF);
+    setValue(ret, 4, 4, money >> 32);
+    if (rng() % 3 == 0) setValue(ret, 8, 2, getValue(r, 8, 2) + 1);
+    return ret;
+}
+
+/*  Same as calcCheckSum() of common.cpp of gosencho  */
+static uint16_t calcLegacyCheckSum(const RECORD_T &r, uint32_t signature)
+{
+    uint16_t checkSum = (signature & 0xFFFF) + (signature >> 16) * 3;
+    for (int i = 0; i < RECORD_SIZE / 2; i++) {
+        checkSum += getValue(r, i * 2, 2) * (i * 2 + 5);
+    }
+    return checkSum;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                   Tests                                   */
+/*---------------------------------------------------------------------------*/
+
+static void check(bool cond, const LAYOUT_T &l, long n, const char *what)
+{
+    if (!cond) {
+        fprintf(stderr, "%s: write %ld: %s\n", l.name, n, what);
+        failures++;
+    }
+}
+
+/*  Reads the ring as at boot  */
+static bool readAfterBoot(const LAYOUT_T &l, RECORD_T &r)
+{
+    MyRecordRing ring(l.addrs, l.slots, l.signature, &r, sizeof(r));
+    return ring.read();
+}
+
+/*  Writes the record after a boot, and returns false if the power is cut at the program  */
+static bool writeAfterBoot(const LAYOUT_T &l, const RECORD_T &r, long cut)
+{
+    RECORD_T work;
+    MyRecordRing ring(l.addrs, l.slots, l.signature, &work, sizeof(work));
+    ring.read();
+    work = r;
+    programs = 0;
+    cutAt = cut;
+    bool ret = true;
+    try {
+        ring.write();
+    } catch (PowerLoss &e) {
+        ret = false;
+    }
+    cutAt = -1;
+    return ret;
+}
+
+static void testLayout(const LAYOUT_T &l, long writesNum)
+{
+    /*  Other games and garbage around the slots  */
+    for (int i = 0; i < EEPROM_SIZE; i++) eeprom[i] = rng();
+    memset(isWritable, 0, sizeof(isWritable));
+    memset(wear, 0, sizeof(wear));
+    for (int i = 0; i < l.slots; i++) {
+        memset(isWritable + l.addrs[i], true, RECORD_SIZE + 3);
+    }
+
+    /*  A record of the old format  */
+    RECORD_T live, r;
+    memset(&live, 0, sizeof(live));
+    uint8_t legacyBytes[RECORD_SIZE + 6];
+    if (l.legacyAddr >= 0) {
+        live = nextRecord(nextRecord(live));
+        for (int i = 0; i < 4; i++) legacyBytes[i] = l.signature >> (i * 8);
+        memcpy(legacyBytes + 4, live.bytes, RECORD_SIZE);
+        uint16_t checkSum = calcLegacyCheckSum(live, l.signature);
+        legacyBytes[RECORD_SIZE + 4] = checkSum & 0xFF;
+        legacyBytes[RECORD_SIZE + 5] = checkSum >> 8;
+        memcpy(eeprom + l.legacyAddr, legacyBytes, sizeof(legacyBytes));
+    }
+    check(!readAfterBoot(l, r), l, 0, "garbage is taken as a record");
+
+    /*  The record of the game and its ring live across writes unless the power is lost  */
+    MyRecordRing ring(l.addrs, l.slots, l.signature, &live, sizeof(live));
+    long programsTotal = 0, programsMax = 0;
+    for (long n = 1; n <= writesNum && failures == 0; n++) {
+        RECORD_T prev = live, next = nextRecord(live);
+        uint8_t snapshot[EEPROM_SIZE], resumed[EEPROM_SIZE];
+        memcpy(snapshot, eeprom, sizeof(eeprom));
+        uint32_t wearSnapshot[EEPROM_SIZE];
+        memcpy(wearSnapshot, wear, sizeof(wear));
+        writeAfterBoot(l, next, -1);
+        long programsNum = programs, resumeAt = rng() % programsNum;
+
+        /*  Cut the power at each byte to be programmed  */
+        for (long cut = 0; cut < programsNum; cut++) {
+            memcpy(eeprom, snapshot, sizeof(eeprom));
+            check(!writeAfterBoot(l, next, cut), l, n, "the power isn't cut");
+            bool isRead = readAfterBoot(l, r);
+            bool isNew = isRead && memcmp(&r, &next, sizeof(r)) == 0;
+            bool isOld = (n > 1) ? isRead && memcmp(&r, &prev, sizeof(r)) == 0 : !isRead;
+            check(isNew || isOld, l, n, "neither the previous nor the new record after a power loss");
+            if (l.legacyAddr >= 0 && !isRead) {
+                check(memcmp(eeprom + l.legacyAddr, legacyBytes, sizeof(legacyBytes)) == 0, l, n,
+                        "the old record is broken before the ring has a record");
+            }
+            if (cut == resumeAt) memcpy(resumed, eeprom, sizeof(eeprom));
+        }
+        memcpy(wear, wearSnapshot, sizeof(wear));
+
+        /*  Go on as the game, or reboot after one of the cuts and write again  */
+        if (rng() % 2) {
+            memcpy(eeprom, snapshot, sizeof(eeprom));
+        } else {
+            memcpy(eeprom, resumed, sizeof(eeprom));
+            ring = MyRecordRing(l.addrs, l.slots, l.signature, &live, sizeof(live));
+            if (!ring.read()) live = prev;
+        }
+        live = next;
+        programs = 0;
+        ring.write();
+        programsTotal += programs;
+        programsMax = std::max(programsMax, programs);
+        check(readAfterBoot(l, r) && memcmp(&r, &live, sizeof(r)) == 0, l, n, "the record isn't read back");
+        if (isVerbose) {
+            printf("%s: write %ld into slot %d, %ld bytes programmed\n", l.name, n, ring.getSlot(), programs);
+        }
+    }
+
+    uint32_t wearMax = 0;
+    for (int i = 0; i < EEPROM_SIZE; i++) wearMax = std::max(wearMax, wear[i]);
+    ring.clear();
+    check(!readAfterBoot(l, r), l, writesNum, "a record remains after clear()");
+    printf("%-10s %5ld writes into %d slots, %5.2f bytes programmed per write (max %ld), "
+            "most programmed byte %u times\n", l.name, writesNum, l.slots,
+            (double) programsTotal / writesNum, programsMax, wearMax);
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+    long writesNum = WRITES_DEFAULT;
+    unsigned seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:v")) != -1) {
+        switch (opt) {
+        case 'n': writesNum = atol(optarg); break;
+        case 'r': seed = atoi(optarg);      break;
+        case 'v': isVerbose = true;         break;
+        default:
+            fprintf(stderr, "Usage: %s [-n writes] [-r seed] [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng.seed(seed);
+    for (const LAYOUT_T &l : layouts) {
+        testLayout(l, writesNum);
+    }
+    printf((failures) ? "--- %d failures\n" : "--- OK\n", failures);
+    return (failures) ? 1 : 0;
+}
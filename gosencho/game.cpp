@@ -4,6 +4,10 @@
 /*  Defines  */
 
 #define MONEY_MAX       48
+#define MONEY_NONE      0xFF
+
+#define BAND_SHIFT      5
+#define BAND_NUM        8
 
 #define SCROLL_MAX      250
 #define SCROLL_SHIFT    8
@@ -27,12 +31,13 @@ typedef struct {
     int16_t x;
     uint8_t y;
     uint8_t type;
+    uint8_t w, h;
 } OBJECT_T;
 
 typedef struct {
     uint8_t         w, h;
     uint8_t const   *bitmap;
-    uint16_t        value;
+    uint32_t        value; // packed BCD
     uint8_t const   *sound;
     uint8_t         color;
 } OBJECT_INFO_T;
@@ -42,9 +47,14 @@ typedef struct {
 static void     handlePlaying(void);
 static void     updateMoney(int16_t v);
 static void     appendMoney(int16_t v, uint8_t typeMin, uint8_t typeMax, bool isStrict);
-static bool     removeMoneyIfNeeded(OBJECT_T &m, int16_t v);
+static bool     removeMoneyIfNeeded(uint8_t idx, int16_t v);
+static bool     isCollidingInBand(uint8_t idx, uint8_t band);
+static uint8_t  moneyBand(OBJECT_T &m);
+static void     linkMoney(uint8_t idx);
+static void     unlinkMoney(uint8_t idx);
 static bool     isColliding(OBJECT_T &obj1, OBJECT_T &obj2, int16_t v = 0);
-static void     addScore(uint16_t p);
+static void     addScore(uint32_t bcd);
+static void     storeScore(void);
 static void     updateLED(uint8_t type);
 static void     kakushiwaza(void);
 
@@ -62,7 +72,7 @@ static void     drawScore(void);
 #define objectWidth(idx)    ((uint8_t) pgm_read_byte(&objectInfo[idx].w))
 #define objectHeight(idx)   ((uint8_t) pgm_read_word(&objectInfo[idx].h))
 #define objectBitmap(idx)   ((uint8_t *) pgm_read_word(&objectInfo[idx].bitmap))
-#define objectValue(idx)    ((uint16_t) pgm_read_word(&objectInfo[idx].value))
+#define objectValue(idx)    ((uint32_t) pgm_read_dword(&objectInfo[idx].value))
 #define objectSound(idx)    ((uint8_t *) pgm_read_word(&objectInfo[idx].sound))
 #define objectColor(idx)    ((uint8_t) pgm_read_word(&objectInfo[idx].color))
 #define colorInfo(r, g, b)  ((r) * 36 + (g) * 6 + (b))
@@ -70,25 +80,28 @@ static void     drawScore(void);
 /*  Local Constants  */
 
 PROGMEM static const OBJECT_INFO_T objectInfo[] = {
-    { 0, 0,   NULL,        0,     NULL,          0                  }, // none
-    { 7, 7,   img1Yen,     1,     sound1Yen,     colorInfo(2, 3, 3) },
-    { 7, 7,   img5Yen,     5,     sound5Yen,     colorInfo(4, 4, 0) },
-    { 9, 9,   img10Yen,    10,    sound10Yen,    colorInfo(6, 1, 0) },
-    { 9, 9,   img50Yen,    50,    sound50Yen,    colorInfo(3, 3, 4) },
-    { 9, 9,   img100Yen,   100,   sound100Yen,   colorInfo(3, 4, 3) },
-    { 11, 11, img500Yen,   500,   sound500Yen,   colorInfo(4, 3, 3) },
-    { 19, 11, img1000Yen,  1000,  sound1000Yen,  colorInfo(2, 2, 5) },
-    { 19, 11, img5000Yen,  5000,  sound5000Yen,  colorInfo(3, 1, 4) },
-    { 21, 11, img10000Yen, 10000, sound10000Yen, colorInfo(5, 2, 2) },
-    { 15, 16, NULL,        0,     NULL,          0                  }, // player
+    { 0, 0,   NULL,        0x0,     NULL,          0                  }, // none
+    { 7, 7,   img1Yen,     0x1,     sound1Yen,     colorInfo(2, 3, 3) },
+    { 7, 7,   img5Yen,     0x5,     sound5Yen,     colorInfo(4, 4, 0) },
+    { 9, 9,   img10Yen,    0x10,    sound10Yen,    colorInfo(6, 1, 0) },
+    { 9, 9,   img50Yen,    0x50,    sound50Yen,    colorInfo(3, 3, 4) },
+    { 9, 9,   img100Yen,   0x100,   sound100Yen,   colorInfo(3, 4, 3) },
+    { 11, 11, img500Yen,   0x500,   sound500Yen,   colorInfo(4, 3, 3) },
+    { 19, 11, img1000Yen,  0x1000,  sound1000Yen,  colorInfo(2, 2, 5) },
+    { 19, 11, img5000Yen,  0x5000,  sound5000Yen,  colorInfo(3, 1, 4) },
+    { 21, 11, img10000Yen, 0x10000, sound10000Yen, colorInfo(5, 2, 2) },
+    { 15, 16, NULL,        0x0,     NULL,          0                  }, // player
 };
 
 /*  Local Variables  */
 
 static STATE_T  state;
 static OBJECT_T player, money[MONEY_MAX];
-static uint16_t progress, holdCount;
+static uint16_t progress, holdCount, scrollPos;
+static uint8_t  bandHead[BAND_NUM], nextInBand[MONEY_MAX];
 static uint8_t  nextMoneyIdx, capturedMoneyType, ledR, ledG, ledB, ledV;
+static MyRandom moneyRandom;
+static MyBcd<8> wallet;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -99,14 +112,21 @@ void initGame(void)
     ab.playScore(soundStart, SND_PRIO_START);
     record.playCount++;
     isRecordDirty = true;
+    wallet.set(record.score[0]);
+    wallet.set(record.score[1], 4);
 
     for (uint8_t i = 0; i < MONEY_MAX; i++) {
         money[i].type = OBJECT_TYPE_NONE;
     }
+    memset(bandHead, MONEY_NONE, BAND_NUM);
     nextMoneyIdx = 0;
+    scrollPos = 0;
+    moneyRandom.setSeed(random());
     player.x = 8;
     player.y = 27;
     player.type = OBJECT_TYPE_PLAYER;
+    player.w = objectWidth(OBJECT_TYPE_PLAYER);
+    player.h = objectHeight(OBJECT_TYPE_PLAYER);
     counter = 0;
     progress = 0;
     holdCount = 0;
@@ -178,6 +198,7 @@ static void handlePlaying(void)
         addMenuItem(F("BACK TO TITLE"), onQuit);
         setMenuCoords(10, 23, 107, 17, true, true);
         setMenuItemPos(0);
+        storeScore();
         writeRecord();
         ab.setRGBled(0, 0, 0);
         state = STATE_MENU;
@@ -189,11 +210,12 @@ static void handlePlaying(void)
 
 static void updateMoney(int16_t v)
 {
-    for (int i = 0; i < MONEY_MAX; i++) {
+    scrollPos += v;
+    for (uint8_t i = 0; i < MONEY_MAX; i++) {
         OBJECT_T &m = money[i];
         if (m.type == OBJECT_TYPE_NONE) continue;
         m.x -= v;
-        removeMoneyIfNeeded(m, v);
+        removeMoneyIfNeeded(i, v);
     }
 }
 
@@ -202,58 +224,94 @@ static void appendMoney(int16_t v, uint8_t typeMin, uint8_t typeMax, bool isStri
     OBJECT_T &next = money[nextMoneyIdx];
     if (next.type != OBJECT_TYPE_NONE) return;
 
-    next.type = random(typeMin, typeMax + 1);
-    next.x = WIDTH - v + random(8);
-    next.y = random(6, HEIGHT - objectHeight(next.type) + 1);
-    if (removeMoneyIfNeeded(next, v)) return;
+    uint8_t type = moneyRandom.range(typeMin, typeMax + 1);
+    next.type = type;
+    next.w = objectWidth(type);
+    next.h = objectHeight(type);
+    next.x = WIDTH - v + moneyRandom.below(8);
+    next.y = moneyRandom.range(6, HEIGHT - next.h + 1);
+    linkMoney(nextMoneyIdx);
+    if (removeMoneyIfNeeded(nextMoneyIdx, v)) return;
 
+    /*  A band is wider than any money, so only the neighbour bands matter  */
     bool c = false;
     if (isStrict) {
-        for (int i = 0; i < MONEY_MAX && !c; i++) {
-            OBJECT_T &m = money[i];
-            if (i != nextMoneyIdx && m.type != OBJECT_TYPE_NONE) c = isColliding(m, next);
-        }
+        uint8_t band = moneyBand(next);
+        c = isCollidingInBand(nextMoneyIdx, band) ||
+                isCollidingInBand(nextMoneyIdx, (band - 1) & (BAND_NUM - 1)) ||
+                isCollidingInBand(nextMoneyIdx, (band + 1) & (BAND_NUM - 1));
     }
     if (c) {
+        unlinkMoney(nextMoneyIdx);
         next.type = OBJECT_TYPE_NONE;
     } else {
         nextMoneyIdx = circulate(nextMoneyIdx, 1, MONEY_MAX);
     }
 }
 
-static bool removeMoneyIfNeeded(OBJECT_T &m, int16_t v)
+static bool removeMoneyIfNeeded(uint8_t idx, int16_t v)
 {
-    bool isOut = (-m.x >= objectWidth(m.type));
+    OBJECT_T &m = money[idx];
+    bool isOut = (-m.x >= m.w);
     if (isOut || isColliding(m, player, v)) {
         addScore(objectValue(m.type));
         if (!isOut) capturedMoneyType = m.type;
+        unlinkMoney(idx);
         m.type = OBJECT_TYPE_NONE;
         return true;
     }
     return false;
 }
 
+static bool isCollidingInBand(uint8_t idx, uint8_t band)
+{
+    for (uint8_t i = bandHead[band]; i != MONEY_NONE; i = nextInBand[i]) {
+        if (i != idx && isColliding(money[i], money[idx])) return true;
+    }
+    return false;
+}
+
 static bool isColliding(OBJECT_T &obj1, OBJECT_T &obj2, int16_t v)
 {
-    return obj2.x - obj1.x < objectWidth(obj1.type) + 1 + v &&
-           obj1.x - obj2.x < objectWidth(obj2.type) + 1 &&
-           obj2.y - obj1.y < objectHeight(obj1.type) + 1 &&
-           obj1.y - obj2.y < objectHeight(obj2.type) + 1;
+    return obj2.x - obj1.x < obj1.w + 1 + v &&
+           obj1.x - obj2.x < obj2.w + 1 &&
+           obj2.y - obj1.y < obj1.h + 1 &&
+           obj1.y - obj2.y < obj2.h + 1;
 }
 
-static void addScore(uint16_t p)
+/*  Bands are fixed to the scrolled field, so that money never moves to another band  */
+static uint8_t moneyBand(OBJECT_T &m)
 {
-    record.score[0] += p;
-    while (record.score[0] >= 100000000UL) {
-        record.score[1]++;
-        record.score[0] -= 100000000UL;
-    }
-    if (record.score[1] >= 100000000UL) {
-        record.score[0] = record.score[1] = 99999999UL;
-    }
+    return (uint16_t) (m.x + scrollPos) >> BAND_SHIFT & (BAND_NUM - 1);
+}
+
+static void linkMoney(uint8_t idx)
+{
+    uint8_t band = moneyBand(money[idx]);
+    nextInBand[idx] = bandHead[band];
+    bandHead[band] = idx;
+}
+
+static void unlinkMoney(uint8_t idx)
+{
+    uint8_t *p = &bandHead[moneyBand(money[idx])];
+    while (*p != MONEY_NONE && *p != idx) p = &nextInBand[*p];
+    if (*p == idx) *p = nextInBand[idx];
+}
+
+static void addScore(uint32_t bcd)
+{
+    wallet.add(bcd);
     isRecordDirty = true;
 }
 
+/*  The record keeps the wallet as two binary halves of 8 digits  */
+static void storeScore(void)
+{
+    record.score[0] = wallet.get(0);
+    record.score[1] = wallet.get(4);
+}
+
 static void updateLED(uint8_t type)
 {
     if (type != OBJECT_TYPE_NONE) {
@@ -274,7 +332,7 @@ static void kakushiwaza(void)
     for (uint8_t i = 2; i <= 7; i++) {
         if (ab.buttonDown(bit(i))) z = z * 6UL % 0346522000UL + i - 2;
     }
-    if (z == 0342666371UL) *((long *)&record + 1) = 0x2FAF07F;
+    if (z == 0342666371UL) wallet.set(49999999UL, 4);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -297,7 +355,8 @@ static void onConfirmReset(void)
 static void onReset(void)
 {
     ab.playScore(soundOver, SND_PRIO_OVER);
-    record.score[0] = record.score[1] = 0UL;
+    wallet.clear();
+    storeScore();
     isRecordDirty = true;
     writeRecord();
     state = STATE_PLAYING;
@@ -323,7 +382,7 @@ static void drawPlaying(void)
     }
     ab.drawBitmap(player.x, player.y, imgPlayer[counter / 4 & 3], IMG_PLAYER_W, IMG_PLAYER_H);
     drawScore();
-    if (record.score[1] >= 50000000UL) {
+    if (wallet.digit(15) >= 5) {
         ab.fillRect(0, 24, WIDTH, 15, WHITE);
         if (counter & 16) {
             ab.setTextColor(BLACK);
@@ -336,19 +395,14 @@ static void drawPlaying(void)
 
 static void drawObject(OBJECT_T &obj)
 {
-    uint8_t t = obj.type;
-    ab.drawBitmap(obj.x, obj.y, objectBitmap(t), objectWidth(t), objectHeight(t));
+    ab.drawBitmap(obj.x, obj.y, objectBitmap(obj.type), obj.w, obj.h);
 }
 
 static void drawScore(void)
 {
     uint8_t x = 122;
-    uint32_t v = record.score[0];
-    do {
-        ab.printEx(x, 0, (char)('0' + v % 10));
-        v /= 10UL;
-        x -= 6;
-        if (x == 74) v = record.score[1];
-    } while (v > 0 || record.score[1] > 0 && x > 74);
+    for (uint8_t i = 0, n = wallet.digits(); i < n; i++, x -= 6) {
+        ab.printEx(x, 0, (char)('0' + wallet.digit(i)));
+    }
     ab.printEx(x, 0, '$');
 }
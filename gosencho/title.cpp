@@ -23,7 +23,7 @@ static void drawInit(void);
 static void drawTop(void);
 static void drawCredit(void);
 static void drawTitleLogo(int16_t x, int16_t y);
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 
 /*  Local Functions (macros)  */
 
@@ -2,7 +2,7 @@
 
 /*  Defines  */
 
-#define PI 3.141592653589793
+#define PHASE_QUARTER   256
 
 /*  Typedefs  */
 
@@ -21,9 +21,9 @@ typedef struct {
 static bool isHollow(void);
 static void setColumn(COLUMN &newColumn, uchar top, uchar bottom);
 static void growColumn(COLUMN &newColumn, bool isSpace, COLUMN &lastColumn);
+static int  calcCaveGap(int phase);
 static int  calcDotY(int i);
-static void drawCaveTop(uchar ptn, int x, int height, int edge, int offset);
-static void drawCaveBottom(uchar ptn, int x, int height, int edge, int offset);
+static uchar calcSpanMask(int from, int to, int y);
 static void drawPlayer(int x, int y, bool dir, int anim);
 static void drawScoreFigure(int x, int y, int value);
 
@@ -40,6 +40,43 @@ PROGMEM static const uint8_t imgPlayer[] = {
     0x10, 0xC4, 0x5A, 0x5A, 0xD2, 0xD8, 0x06, 0x20, // right 3
 };
 
+/*  (1 - cos(phase * PI / 512)) / 2 * 65536 for the first quarter of cavePhase  */
+PROGMEM static const uint16_t caveGapTable[PHASE_QUARTER + 1] = {
+        0,     1,     2,     6,    10,    15,    22,    30,
+       39,    50,    62,    75,    89,   104,   121,   139,
+      158,   178,   200,   222,   246,   272,   298,   326,
+      355,   385,   416,   449,   482,   517,   554,   591,
+      630,   669,   710,   753,   796,   841,   887,   934,
+      982,  1031,  1082,  1134,  1187,  1241,  1297,  1353,
+     1411,  1470,  1530,  1591,  1654,  1718,  1782,  1848,
+     1915,  1984,  2053,  2124,  2196,  2269,  2343,  2418,
+     2494,  2572,  2650,  2730,  2811,  2893,  2976,  3061,
+     3146,  3233,  3320,  3409,  3499,  3590,  3682,  3775,
+     3869,  3965,  4061,  4158,  4257,  4357,  4457,  4559,
+     4662,  4766,  4871,  4977,  5084,  5192,  5301,  5411,
+     5522,  5635,  5748,  5862,  5977,  6094,  6211,  6329,
+     6448,  6569,  6690,  6812,  6935,  7060,  7185,  7311,
+     7438,  7566,  7695,  7825,  7956,  8088,  8220,  8354,
+     8489,  8624,  8760,  8898,  9036,  9175,  9315,  9456,
+     9598,  9740,  9884, 10028, 10173, 10319, 10466, 10614,
+    10762, 10912, 11062, 11213, 11365, 11517, 11671, 11825,
+    11980, 12136, 12293, 12450, 12608, 12767, 12927, 13087,
+    13248, 13410, 13573, 13736, 13900, 14065, 14230, 14396,
+    14563, 14731, 14899, 15068, 15237, 15407, 15578, 15750,
+    15922, 16095, 16268, 16442, 16617, 16792, 16968, 17144,
+    17321, 17499, 17677, 17856, 18035, 18215, 18395, 18576,
+    18758, 18940, 19122, 19305, 19489, 19673, 19858, 20043,
+    20228, 20414, 20601, 20788, 20975, 21163, 21351, 21540,
+    21729, 21918, 22108, 22299, 22489, 22680, 22872, 23064,
+    23256, 23449, 23641, 23835, 24028, 24222, 24417, 24611,
+    24806, 25001, 25197, 25392, 25588, 25785, 25981, 26178,
+    26375, 26573, 26770, 26968, 27166, 27364, 27563, 27761,
+    27960, 28159, 28358, 28557, 28757, 28956, 29156, 29356,
+    29556, 29756, 29957, 30157, 30357, 30558, 30759, 30959,
+    31160, 31361, 31562, 31763, 31964, 32165, 32366, 32567,
+    32768
+};
+
 PROGMEM static const uint8_t imgCave[] = {
     0x90, 0x06, 0x4E, 0xE4, 0xC0, 0x88, 0x18, 0x99
 };
@@ -175,7 +212,7 @@ bool updateGame(void)
     if (cavePhase == 976) {
         arduboy.playScore2(soundCrush, 2);
     }
-    caveGap = (0.5 - cos(cavePhase * PI / 512.0) / 2.0) * caveMaxGap;
+    caveGap = calcCaveGap(cavePhase);
     caveBaseTop = -(caveGap + 1) / 2;
     caveBaseBottom = caveGap / 2;
 
@@ -268,42 +305,63 @@ bool updateGame(void)
 
 void drawGame(void)
 {
-    arduboy.clear();
-
     int shake = (cavePhase > 976) ? cavePhase % 4 / 2 : 0;
     int offsetTop = caveBaseTop + shake;
     int offsetBottom = caveBaseBottom + shake;
 
-    /*  Cave & Debris  */
-    for (int i = 0; i < 128; i++) {
-        int pos = (i + caveOffset + 8) % 144;
+    /*  Cave & Debris, written to every page of each column instead of clearing  */
+    uchar ptnTop[8], ptnBottom[8];
+    int shiftTop = offsetTop & 7, shiftBottom = -offsetBottom & 7;
+    for (int i = 0; i < 8; i++) {
+        uchar ptn = pgm_read_byte(imgCave + i);
+        ptnTop[i] = (ptn << shiftTop) | (ptn >> (8 - shiftTop));
+        ptnBottom[i] = (ptn >> shiftBottom) | (ptn << (8 - shiftBottom));
+    }
+    uchar *pBuf = arduboy.getBuffer();
+    int pos = (caveOffset + 8) % 144;
+    for (int i = 0; i < 128; i++, pBuf++, pos = (pos == 143) ? 0 : pos + 1) {
         int col = pos / 8;
         int odd = pos & 7;
-        int height, edge; 
-        uchar ptn = pgm_read_byte(imgCave + ((i + caveOffset) & 7));
-
-        height = caveColumn[col].top;
-        if (odd == 0) {
-            edge = height - caveColumn[mod(col - 1, 18)].top + 1;
-        } else if (odd == 7) {
-            edge = height - caveColumn[mod(col + 1, 18)].top + 1;
-        } else {
+        int prevCol = (col == 0) ? 17 : col - 1;
+        int nextCol = (col == 17) ? 0 : col + 1;
+        int height, edge;
+
+        /*  Rows [0, topSolid) are the pattern and [topSolid, topEnd) are the edge  */
+        int topEnd = 0, topSolid = 0;
+        height = caveColumn[col].top + offsetTop;
+        if (height >= 0) {
             edge = 1;
+            if (odd == 0) edge = caveColumn[col].top - caveColumn[prevCol].top + 1;
+            if (odd == 7) edge = caveColumn[col].top - caveColumn[nextCol].top + 1;
+            topEnd = height;
+            topSolid = height - min(max(edge, 1), height);
         }
-        drawCaveTop(ptn, i, height, edge, -offsetTop);
 
-        height = caveColumn[col].bottom;
-        if (odd == 0) {
-            edge = caveColumn[mod(col - 1, 18)].bottom - height + 1;
-        } else if (odd == 7) {
-            edge = caveColumn[mod(col + 1, 18)].bottom - height + 1;
-        } else {
+        /*  Rows [bottomStart, bottomSolid) are the edge and [bottomSolid, 64) are the pattern  */
+        int bottomStart = HEIGHT, bottomSolid = HEIGHT;
+        height = HEIGHT - caveColumn[col].bottom - offsetBottom;
+        if (height >= 0) {
             edge = 1;
+            if (odd == 0) edge = caveColumn[prevCol].bottom - caveColumn[col].bottom + 1;
+            if (odd == 7) edge = caveColumn[nextCol].bottom - caveColumn[col].bottom + 1;
+            bottomStart = HEIGHT - height;
+            bottomSolid = bottomStart + min(max(edge, 1), height);
         }
-        drawCaveBottom(ptn, i, 64 - height, edge, offsetBottom);
 
-        if (debris[pos].t > 0) {
-            arduboy.drawPixel(i, calcDotY(pos) + shake, WHITE);
+        int dotY = (debris[pos].t > 0) ? calcDotY(pos) + shake : -1;
+        uchar pt = ptnTop[(i + caveOffset) & 7], pb = ptnBottom[(i + caveOffset) & 7];
+        for (int y = 0; y < HEIGHT; y += 8) {
+            uchar data = 0, mask;
+            if (y < topEnd) { // Pages of the gap only are left blank
+                mask = calcSpanMask(0, topSolid, y);
+                data = (pt & mask) | (calcSpanMask(0, topEnd, y) & ~mask);
+            }
+            if (y + 8 > bottomStart) {
+                mask = calcSpanMask(bottomSolid, HEIGHT, y);
+                data |= (pb & mask) | (calcSpanMask(bottomStart, HEIGHT, y) & ~mask);
+            }
+            if (dotY >= y && dotY < y + 8) data |= 1 << (dotY - y);
+            pBuf[y / 8 * WIDTH] = data;
         }
     }
 
@@ -373,43 +431,29 @@ static void growColumn(COLUMN &newColumn, bool isSpace, COLUMN &lastColumn)
     newColumn.bottom = bottom; 
 }
 
-static int calcDotY(int i)
+static int calcCaveGap(int phase)
 {
-    return debris[i].base + (debris[i].t * debris[i].t >> 6);
+    if (phase > PHASE_QUARTER * 2) phase = PHASE_QUARTER * 4 - phase;
+    uint32_t ratio = (phase <= PHASE_QUARTER) ? pgm_read_word(caveGapTable + phase) :
+            65536UL - pgm_read_word(caveGapTable + PHASE_QUARTER * 2 - phase);
+    return ratio * caveMaxGap >> 16;
 }
 
-static void drawCaveTop(uchar ptn, int x, int height, int edge, int offset)
+static int calcDotY(int i)
 {
-    height -= offset;
-    if (height < 0) return;
-    edge = min(max(edge, 1), height);
-    arduboy.drawFastVLine2(x, height - edge, edge, WHITE);
-    height -= edge;
-
-    int shift = -offset & 7;
-    ptn = (ptn << shift) | (ptn >> (8 - shift));
-    uchar *pBuf = arduboy.getBuffer() + x;
-    for (; height > 0; pBuf += WIDTH, height -= 8) {
-        uchar mask = (height < 8) ? 0xFF >> (8 - height) : 0xFF;
-        *pBuf |= ptn & mask;
-    }
+    return debris[i].base + (debris[i].t * debris[i].t >> 6);
 }
 
-static void drawCaveBottom(uchar ptn, int x, int height, int edge, int offset)
+/*  Bits of rows [from, to) in the page which begins at row y  */
+static uchar calcSpanMask(int from, int to, int y)
 {
-    height -= offset;
-    if (height < 0) return;
-    edge = min(max(edge, 1), height);
-    arduboy.drawFastVLine2(x, 64 - height, edge, WHITE);
-    height -= edge;
-
-    int shift = -offset & 7;
-    ptn = (ptn >> shift) | (ptn << (8 - shift));
-    uchar *pBuf = arduboy.getBuffer() + WIDTH * 7 + x;
-    for (; height > 0; pBuf -= WIDTH, height -= 8) {
-        uchar mask = (height < 8) ? 0xFF << (8 - height) : 0xFF;
-        *pBuf |= ptn & mask;
-    }
+    from -= y;
+    to -= y;
+    if (from >= 8 || to <= 0 || from >= to) return 0;
+    uchar mask = 0xFF;
+    if (from > 0) mask <<= from;
+    if (to < 8) mask &= 0xFF >> (8 - to);
+    return mask;
 }
 
 static void drawPlayer(int x, int y, bool dir, int anim)
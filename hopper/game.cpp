@@ -10,7 +10,7 @@ enum {
     STATE_PAUSE,
 };
 
-#define FLOORS_MANAGE   10
+#define FLOORS_MANAGE   16
 #define FLOORS_LEVEL    50
 
 enum {
@@ -23,9 +23,11 @@ enum {
 };
 
 #define FLOOR_Z_MAX     4096
+#define FLOOR_Z_FAR     6144
 
-#define CHIPS           64
-#define CHIP_ZRANGE     1024
+#define CHIPS           96
+#define CHIP_ZRANGE     1536
+#define CHIP_ZSTEP      (CHIP_ZRANGE / CHIPS)
 
 #define CENTER_X        64
 #define CENTER_Y        32
@@ -65,6 +67,9 @@ static void moveFloors(int scrollX, int scrollY, int scrollZ);
 static void addFloor(uint8_t type, uint8_t pos, int16_t x, int16_t y, int16_t z);
 static void initChips(void);
 static void moveChips(int scrollX, int scrollY, int scrollZ);
+static uint16_t perspective(uint16_t q);
+static int16_t  project(int16_t v, uint16_t r);
+static int16_t  sinScaled(uint8_t a, int16_t r);
 
 static void drawPlayer(void);
 static void drawFloors(void);
@@ -153,6 +158,51 @@ PROGMEM static const uint8_t imgOver[] = { // 76x10 "Game Over"
     0x01, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00
 };
 
+/*  2^23 / q for q of 256 to 511  */
+PROGMEM static const uint16_t recipTable[256] = {
+    32768, 32640, 32514, 32388, 32264, 32140, 32018, 31896,
+    31775, 31655, 31536, 31418, 31301, 31184, 31069, 30954,
+    30840, 30728, 30615, 30504, 30394, 30284, 30175, 30067,
+    29959, 29853, 29747, 29642, 29537, 29434, 29331, 29229,
+    29127, 29026, 28926, 28827, 28728, 28630, 28533, 28436,
+    28340, 28244, 28150, 28056, 27962, 27869, 27777, 27685,
+    27594, 27504, 27414, 27324, 27236, 27148, 27060, 26973,
+    26887, 26801, 26715, 26631, 26546, 26462, 26379, 26297,
+    26214, 26133, 26052, 25971, 25891, 25811, 25732, 25653,
+    25575, 25497, 25420, 25343, 25267, 25191, 25116, 25041,
+    24966, 24892, 24818, 24745, 24672, 24600, 24528, 24457,
+    24385, 24315, 24245, 24175, 24105, 24036, 23967, 23899,
+    23831, 23764, 23697, 23630, 23564, 23498, 23432, 23367,
+    23302, 23237, 23173, 23109, 23046, 22982, 22920, 22857,
+    22795, 22733, 22672, 22611, 22550, 22490, 22429, 22370,
+    22310, 22251, 22192, 22134, 22075, 22017, 21960, 21902,
+    21845, 21789, 21732, 21676, 21620, 21565, 21509, 21454,
+    21400, 21345, 21291, 21237, 21183, 21130, 21077, 21024,
+    20972, 20919, 20867, 20815, 20764, 20713, 20662, 20611,
+    20560, 20510, 20460, 20410, 20361, 20311, 20262, 20214,
+    20165, 20117, 20068, 20021, 19973, 19925, 19878, 19831,
+    19784, 19738, 19692, 19645, 19600, 19554, 19508, 19463,
+    19418, 19373, 19329, 19284, 19240, 19196, 19152, 19108,
+    19065, 19022, 18979, 18936, 18893, 18851, 18809, 18766,
+    18725, 18683, 18641, 18600, 18559, 18518, 18477, 18437,
+    18396, 18356, 18316, 18276, 18236, 18197, 18157, 18118,
+    18079, 18040, 18001, 17963, 17924, 17886, 17848, 17810,
+    17772, 17735, 17697, 17660, 17623, 17586, 17549, 17513,
+    17476, 17440, 17404, 17368, 17332, 17296, 17261, 17225,
+    17190, 17155, 17120, 17085, 17050, 17015, 16981, 16947,
+    16913, 16878, 16845, 16811, 16777, 16744, 16710, 16677,
+    16644, 16611, 16578, 16546, 16513, 16481, 16448, 16416,
+};
+
+/*  sin(a * PI / 128) * 256 for the first quarter, 256 is rounded to 255  */
+PROGMEM static const uint8_t sinTable[65] = {
+      0,   6,  13,  19,  25,  31,  38,  44,  50,  56,  62,  68,  74,  80,  86,  92,
+     98, 104, 109, 115, 121, 126, 132, 137, 142, 147, 152, 157, 162, 167, 172, 177,
+    181, 185, 190, 194, 198, 202, 206, 209, 213, 216, 220, 223, 226, 229, 231, 234,
+    237, 239, 241, 243, 245, 247, 248, 250, 251, 252, 253, 254, 255, 255, 255, 255,
+    255,
+};
+
 PROGMEM static const byte soundStart[] = {
     0x90, 72, 0, 100, 0x80, 0, 25,
     0x90, 74, 0, 100, 0x80, 0, 25,
@@ -201,7 +251,7 @@ static uint8_t  floorIdxFirst, floorIdxLast;
 static uint8_t  flrTypes[4], flrTypesNum;
 static FLOOR    *pFloorBlur;
 static CHIP     chipAry[CHIPS];
-static uint16_t chipBaseZ;
+static int16_t  chipBaseZ;
 static bool     isBlink;
 
 /*---------------------------------------------------------------------------*/
@@ -403,7 +453,7 @@ static void moveFloors(int scrollX, int scrollY, int scrollZ)
     }
 
     pFloor = &floorAry[floorIdxFirst];
-    if (pFloor->z > FLOOR_Z_MAX) {
+    if (pFloor->z > FLOOR_Z_FAR) {
         pFloor->type = FLRTYPE_NONE;
         floorIdxFirst = nextFloorIdx(floorIdxFirst);
         dprint("floorIdxFirst=");
@@ -438,10 +488,10 @@ static void addFloor(uint8_t type, uint8_t pos, int16_t x, int16_t y, int16_t z)
     pFloor->y = y;
     pFloor->z = z;
 
-    double vd = random(256) * PI / 128.0;
+    uint8_t vd = random(256);
     int vr = (type == FLRTYPE_MOVE) ? 256 + level * 16 : 0;
-    pFloor->vx = cos(vd) * vr;
-    pFloor->vy = sin(vd) * vr;
+    pFloor->vx = sinScaled(vd + 64, vr);
+    pFloor->vy = sinScaled(vd, vr);
 
     uint8_t size = (type == FLRTYPE_SMALL) ? 36 - level : 64 - level * 3;
     pFloor->size = max(size, 16);
@@ -471,7 +521,31 @@ static void moveChips(int scrollX, int scrollY, int scrollZ)
         pChip->y += scrollY;
     }
     chipBaseZ += scrollZ;
-    chipBaseZ %= CHIP_ZRANGE;
+    if (chipBaseZ < 0) chipBaseZ += CHIP_ZRANGE;
+    if (chipBaseZ >= CHIP_ZRANGE) chipBaseZ -= CHIP_ZRANGE;
+}
+
+/*  Reciprocal of q (256 to 8191) scaled by 2^23, so that project() multiplies instead of dividing  */
+static uint16_t perspective(uint16_t q)
+{
+    uint8_t k = 0;
+    for (; q >= 512; q >>= 1) k++;
+    return pgm_read_word(recipTable + q - 256) >> k;
+}
+
+/*  v * r / 2^23, rounding the magnitude so that both sides of the center are drawn alike  */
+static int16_t project(int16_t v, uint16_t r)
+{
+    int16_t ret = (uint32_t) abs(v) * r >> 23;
+    return (v < 0) ? -ret : ret;
+}
+
+static int16_t sinScaled(uint8_t a, int16_t r)
+{
+    uint8_t i = a & 63;
+    if (a & 64) i = 64 - i;
+    int16_t v = (int32_t) r * pgm_read_byte(sinTable + i) >> 8;
+    return (a & 128) ? -v : v;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -502,10 +576,10 @@ static void drawFloors(void)
         uint8_t type = pFloor->type;
         if (pFloor->type == FLRTYPE_NONE) break;
         if (pFloor->z < 0 || pFloor->size == 0) continue;
-        int16_t q = 256 + pFloor->z;
-        uint8_t s = pFloor->size * 256 / q;
-        int16_t x = pFloor->x / q + CENTER_X - s / 2;
-        int16_t y = pFloor->y / q + CENTER_Y - s / 2;
+        uint16_t r = perspective(256 + pFloor->z);
+        uint8_t s = (uint32_t) pFloor->size * r >> 15;
+        int16_t x = project(pFloor->x, r) + CENTER_X - s / 2;
+        int16_t y = project(pFloor->y, r) + CENTER_Y - s / 2;
         if (pFloor == pFloorBlur) {
             int blur = (playerJump + 16) / 32;
             x += blur * random(-1, 2);
@@ -522,14 +596,16 @@ static void drawFloors(void)
 
 static void drawChips(void)
 {
-    for (int i = 0; i < CHIPS; i++) {
+    int16_t z = chipBaseZ;
+    for (int i = 0; i < CHIPS; i++, z += CHIP_ZSTEP) {
         CHIP *pChip = &chipAry[i];
-        int16_t q1 = 256 + (chipBaseZ + i * (CHIP_ZRANGE / CHIPS)) % CHIP_ZRANGE;
-        int16_t x1 = pChip->x / q1 + CENTER_X;
-        int16_t y1 = pChip->y / q1 + CENTER_Y;
-        int16_t q2 = q1 + abs(playerJump);
-        int16_t x2 = pChip->x / q2 + CENTER_X;
-        int16_t y2 = pChip->y / q2 + CENTER_Y;
+        if (z >= CHIP_ZRANGE) z -= CHIP_ZRANGE;
+        uint16_t r1 = perspective(256 + z);
+        int16_t x1 = project(pChip->x, r1) + CENTER_X;
+        int16_t y1 = project(pChip->y, r1) + CENTER_Y;
+        uint16_t r2 = perspective(256 + z + abs(playerJump));
+        int16_t x2 = project(pChip->x, r2) + CENTER_X;
+        int16_t y2 = project(pChip->y, r2) + CENTER_Y;
         arduboy.drawLine(x1, y1, x2, y2, WHITE);
     }
 }
@@ -582,15 +658,22 @@ static void fillPatternedRect(int16_t x, int16_t y, uint8_t w, int8_t h, const u
     if (x + w > WIDTH) w = WIDTH - x;
     if (y + h > HEIGHT) h = HEIGHT - y;
 
-    /*  Draw a patterned rectangle  */
+    /*  Draw a patterned rectangle, storing whole bytes where the rows are aligned  */
     uint8_t yOdd = y & 7;
     uchar d = 0xFF << yOdd;
     y -= yOdd;
     h += yOdd;
-    for (uchar *p = arduboy.getBuffer() + x + (y / 8) * WIDTH; h > 0; h -= 8, p += WIDTH - w) {
+    uchar *p = arduboy.getBuffer() + x + (y / 8) * WIDTH;
+    uint8_t ptnBuf[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        ptnBuf[i] = pgm_read_byte(ptn + ((uintptr_t) p + i) % 4);
+    }
+    for (; h > 0; h -= 8, p += WIDTH - w) {
         if (h < 8) d &= 0xFF >> (8 - h);
-        for (uint8_t i = w; i > 0; i--, p++) {
-            *p = *p & ~d | pgm_read_byte(ptn + (int) p % 4) & d;
+        if (d == 0xFF) {
+            for (uint8_t i = 0; i < w; i++) *p++ = ptnBuf[i & 3];
+        } else {
+            for (uint8_t i = 0; i < w; i++, p++) *p = *p & ~d | ptnBuf[i & 3] & d;
         }
         d = 0xFF;
     }
@@ -86,12 +86,100 @@ void MyArduboy::beginNoLogo(void)
 
 /*----------------------------------------------------------------------------*/
 
+#ifdef INPUT_HARNESS
+
+#include <util/crc16.h>
+#ifdef INPUT_REPLAY
+#include "replay.h" // Generated by etc/inputlog.go
+#endif
+
+uint16_t inputFrames;
+
+static uint8_t  inputRunState, inputRunCount;
+#ifdef INPUT_REPLAY
+static uint16_t inputReplayIdx, inputErrors;
+static bool     isInputReplaying;
+#endif
+
+static uint8_t updateInput(uint8_t state, const uint8_t *pBuffer)
+{
+    if (inputFrames == 0) {
+        while (!Serial) { ; } // Wait for the serial monitor
+#ifdef INPUT_REPLAY
+        uint32_t seed = pgm_read_dword(inputReplayData);
+        inputReplayIdx = 4;
+        isInputReplaying = true;
+#else
+        uint32_t seed = INPUT_SEED;
+#endif
+        Serial.print(F("S "));
+        Serial.println(seed, HEX);
+        srand(seed);
+        randomSeed(seed);
+    } else {
+        /*  Hash of the frame which has been drawn since the last call  */
+        uint16_t hash = 0xFFFF;
+        for (int i = 0; i < WIDTH * HEIGHT / 8; i++) {
+            hash = _crc16_update(hash, pBuffer[i]);
+        }
+#ifdef INPUT_REPLAY
+        if (isInputReplaying && inputFrames <= INPUT_REPLAY_HASHES &&
+                hash != pgm_read_word(&inputReplayHashes[inputFrames - 1])) {
+            inputErrors++;
+            Serial.print(F("E "));
+            Serial.println(inputFrames - 1);
+        }
+#else
+        Serial.print(F("H "));
+        Serial.println(hash, HEX);
+#endif
+    }
+
+#ifdef INPUT_REPLAY
+    if (isInputReplaying && inputRunCount == 0) {
+        inputRunCount = pgm_read_byte(inputReplayData + inputReplayIdx + 1);
+        if (inputRunCount > 0) {
+            inputRunState = pgm_read_byte(inputReplayData + inputReplayIdx);
+            inputReplayIdx += 2;
+        } else {
+            isInputReplaying = false; // Back to the real buttons
+            Serial.print(F("R "));
+            Serial.print(inputFrames);
+            Serial.print(' ');
+            Serial.println(inputErrors);
+        }
+    }
+    if (isInputReplaying) {
+        state = inputRunState;
+        inputRunCount--;
+    }
+#else
+    if (inputRunCount > 0 && (state != inputRunState || inputRunCount == 255)) {
+        Serial.print(F("I "));
+        Serial.print(inputRunState, HEX);
+        Serial.print(' ');
+        Serial.println(inputRunCount);
+        inputRunCount = 0;
+    }
+    inputRunState = state;
+    inputRunCount++;
+#endif
+    inputFrames++;
+    return state;
+}
+
+#endif
+
 bool MyArduboy::nextFrame(void)
 {
     bool ret = ARDUBOY_LIB_CLASS::nextFrame();
     if (ret) {
         lastButtonState = currentButtonState;
+#ifdef INPUT_HARNESS
+        currentButtonState = updateInput(buttonsState(), getBuffer());
+#else
         currentButtonState = buttonsState();
+#endif
     }
     return ret;
 }
@@ -288,6 +376,54 @@ void MyArduboy::fillBeltWhite(buffer_t *p, uint8_t d, uint8_t w)
 
 /*----------------------------------------------------------------------------*/
 
+void MyArduboy::drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h)
+{
+    drawMaskedBitmap(x, y, bitmap, mask, w, h);
+}
+
+void MyArduboy::drawMaskedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h)
+{
+    /*  Check parameters  */
+    uint8_t pages = (h + 7) >> 3;
+    int16_t x0 = x, x1 = x + w;
+    int16_t y0 = y, y1 = y + pages * 8;
+    if (x0 >= WIDTH || x1 <= 0 || y0 >= HEIGHT || y1 <= 0) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+    if (y0 < 0) y0 = 0;
+    if (y1 > HEIGHT) y1 = HEIGHT;
+
+    /*  Draw a bitmap with mask column by column, reading each byte of them and
+        writing each byte of the buffer only once  */
+    uint8_t rows = ((y1 - 1) >> 3) - (y0 >> 3) + 1;
+    int16_t r = (y0 & ~7) - y;
+    uint8_t shift = r & 7;
+    buffer_t *p = getBuffer() + x0 + (y0 >> 3) * WIDTH;
+    for (int16_t i = x0 - x; i < x1 - x; i++, p++) {
+        int8_t page = r >> 3;
+        const uint8_t *pBitmap = bitmap + page * w + i, *pMask = mask + page * w + i;
+        uint16_t d = 0, m = 0;
+        if (page >= 0) {
+            d = pgm_read_byte(pBitmap);
+            m = pgm_read_byte(pMask);
+        }
+        buffer_t *q = p;
+        for (uint8_t j = 0; j < rows; j++, q += WIDTH) {
+            pBitmap += w;
+            pMask += w;
+            if (++page < pages) {
+                d |= pgm_read_byte(pBitmap) << 8;
+                m |= pgm_read_byte(pMask) << 8;
+            }
+            *q = (*q & ~(m >> shift)) | d >> shift;
+            d >>= 8;
+            m >>= 8;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
 bool MyArduboy::isAudioEnabled(void)
 {
     return myAudio.enabled();
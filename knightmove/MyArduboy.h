@@ -23,6 +23,16 @@ public:
 };
 #endif
 
+//#define INPUT_RECORD  // Log button states and frame hashes to Serial
+//#define INPUT_REPLAY  // Replay button states of "replay.h" and verify frame hashes
+
+#if defined(INPUT_RECORD) || defined(INPUT_REPLAY)
+#define INPUT_HARNESS
+#define INPUT_SEED      0x4F424E00UL
+#define micros()        ((unsigned long) inputFrames << 14) // Deterministic time
+#define millis()        ((unsigned long) inputFrames << 4)
+extern uint16_t inputFrames;
+#endif
 
 class MyArduboy : public ARDUBOY_LIB_CLASS
 {
@@ -44,6 +54,7 @@ public:
     void    drawFastVLine2(int16_t x, int16_t y, int8_t h, uint8_t color);
     void    drawFastHLine2(int16_t x, int16_t y, uint8_t w, uint8_t color);
     void    fillRect2(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color);
+    void    drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h);
     bool    isAudioEnabled(void);
     void    setAudioEnabled(bool on);
     void    saveAudioOnOff(void);
@@ -54,6 +65,7 @@ private:
     void    myDrawChar(int16_t x, int16_t y, unsigned char c, uint8_t color, uint8_t bg, uint8_t size);
     void    fillBeltBlack(buffer_t *p, uint8_t d, uint8_t w);
     void    fillBeltWhite(buffer_t *p, uint8_t d, uint8_t w);
+    void    drawMaskedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h);
     uint8_t textcolor = WHITE;
     uint8_t textbg = BLACK;
     uint8_t lastButtonState;
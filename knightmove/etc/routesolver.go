@@ -0,0 +1,309 @@
+package main
+
+/*
+Find the longest chain of holes which the knight can open in a row.
+
+The chain of game.cpp grows while every jump lands on a floor of 1, which
+opens it, and a jump to an open floor falls. So the best chain from a field is
+the longest path of knight moves from the knight over floors of 1, visiting
+each at most once. It is searched exactly by depth-first search, pruned by the
+number of floors of 1 still reachable. The steering is assumed to be in time
+for any of the 8 jumps.
+
+A field is 4 lines of 8 digits (the floor, 0 is open) and the knight is put
+with 'K' after the digit of its cell. Lines beginning with '#' are ignored and
+a blank line separates fields. With -r, random fields are made instead and the
+distribution of the best chains is shown with the points of getPoint(), to
+calibrate them.
+
+Usage: go run routesolver.go [-r n] [-ones ratio] [-seed n] [<field file>]
+*/
+
+import (
+	"bufio"
+	"flag"
+	"fmt"
+	"math/bits"
+	"math/rand"
+	"os"
+	"strings"
+)
+
+const (
+	fieldW = 8
+	fieldH = 4
+)
+
+var velocityTable = [8][2]int{
+	{1, -2}, {2, -1}, {2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2},
+}
+
+type field struct {
+	floors           [fieldH][fieldW]int
+	knightX, knightY int
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Solver                                   */
+/*---------------------------------------------------------------------------*/
+
+type solver struct {
+	neighbors [fieldW * fieldH]uint32
+	best      []int
+	path      []int
+	nodes     int64
+}
+
+/*  Floors of 1 which can be reached from the cell without passing visited ones  */
+func (s *solver) reachable(cell int, ones uint32) uint32 {
+	visited, frontier := uint32(0), uint32(1)<<cell
+	for frontier != 0 {
+		next := uint32(0)
+		for b := frontier; b != 0; b &= b - 1 {
+			next |= s.neighbors[bits.TrailingZeros32(b)]
+		}
+		frontier = next & ones &^ visited
+		visited |= frontier
+	}
+	return visited
+}
+
+func (s *solver) search(cell int, ones uint32) {
+	s.nodes++
+	if len(s.path) > len(s.best) {
+		s.best = append(s.best[:0], s.path...)
+	}
+	if len(s.path)+bits.OnesCount32(s.reachable(cell, ones)) <= len(s.best) {
+		return
+	}
+	for b := s.neighbors[cell] & ones; b != 0; b &= b - 1 {
+		next := bits.TrailingZeros32(b)
+		s.path = append(s.path, next)
+		s.search(next, ones&^(1<<next))
+		s.path = s.path[:len(s.path)-1]
+	}
+}
+
+func solve(f *field) ([]int, int64) {
+	s := &solver{}
+	for c := 0; c < fieldW*fieldH; c++ {
+		x, y := c%fieldW, c/fieldW
+		for _, v := range velocityTable {
+			nx, ny := x+v[0], y+v[1]
+			if nx >= 0 && nx < fieldW && ny >= 0 && ny < fieldH {
+				s.neighbors[c] |= 1 << (ny*fieldW + nx)
+			}
+		}
+	}
+	var ones uint32
+	for y := 0; y < fieldH; y++ {
+		for x := 0; x < fieldW; x++ {
+			if f.floors[y][x] == 1 {
+				ones |= 1 << (y*fieldW + x)
+			}
+		}
+	}
+	start := f.knightY*fieldW + f.knightX
+	s.search(start, ones&^(1<<start))
+	return s.best, s.nodes
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Points                                   */
+/*---------------------------------------------------------------------------*/
+
+/*  Same as getPoint() of game.cpp  */
+func getPoint(n int) int {
+	switch {
+	case n <= 7:
+		return 100 * n
+	case n <= 14:
+		return 1000 + 200*(n-8)
+	case n <= 21:
+		return 3000 + 500*(n-15)
+	case n <= 28:
+		return 10000 + 2000*(n-22)
+	case n <= 31:
+		return 30000 + 10000*(n-29)
+	default:
+		return 100000
+	}
+}
+
+/*  Same as evaluate() of game.cpp  */
+func evalLabel(n int) string {
+	switch {
+	case n <= 7:
+		return ""
+	case n <= 14:
+		return "COOL"
+	case n <= 21:
+		return "VERY GOOD"
+	case n <= 28:
+		return "WONDERFUL"
+	case n <= 31:
+		return "EXCELLENT!"
+	default:
+		return "PERFECT!!"
+	}
+}
+
+func chainPoints(n int) int {
+	p := 0
+	for i := 1; i <= n; i++ {
+		p += getPoint(i)
+	}
+	return p
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Fields                                   */
+/*---------------------------------------------------------------------------*/
+
+func readFields(path string) ([]field, error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer file.Close()
+	var fields []field
+	var rows []string
+	flush := func(line int) error {
+		if len(rows) == 0 {
+			return nil
+		}
+		f, err := parseField(rows)
+		if err != nil {
+			return fmt.Errorf("line %d: %v", line, err)
+		}
+		fields = append(fields, f)
+		rows = nil
+		return nil
+	}
+	scanner := bufio.NewScanner(file)
+	line := 1
+	for ; scanner.Scan(); line++ {
+		text := strings.TrimSpace(scanner.Text())
+		if strings.HasPrefix(text, "#") {
+			continue
+		}
+		if text == "" {
+			if err := flush(line); err != nil {
+				return nil, err
+			}
+			continue
+		}
+		rows = append(rows, text)
+	}
+	if err := flush(line); err != nil {
+		return nil, err
+	}
+	return fields, scanner.Err()
+}
+
+func parseField(rows []string) (field, error) {
+	f := field{knightX: -1}
+	if len(rows) != fieldH {
+		return f, fmt.Errorf("a field must have %d lines", fieldH)
+	}
+	for y, row := range rows {
+		x := 0
+		for _, c := range row {
+			switch {
+			case c >= '0' && c <= '3' && x < fieldW:
+				f.floors[y][x] = int(c - '0')
+				x++
+			case c == 'K' && x > 0 && f.knightX < 0:
+				f.knightX, f.knightY = x-1, y
+			default:
+				return f, fmt.Errorf("unexpected %q", c)
+			}
+		}
+		if x != fieldW {
+			return f, fmt.Errorf("a line must have %d floors", fieldW)
+		}
+	}
+	if f.knightX < 0 {
+		return f, fmt.Errorf("no knight")
+	}
+	return f, nil
+}
+
+func randomField(r *rand.Rand, ones float64) field {
+	var f field
+	for y := 0; y < fieldH; y++ {
+		for x := 0; x < fieldW; x++ {
+			if r.Float64() < ones {
+				f.floors[y][x] = 1
+			} else {
+				f.floors[y][x] = []int{0, 2, 3}[r.Intn(3)]
+			}
+		}
+	}
+	f.knightX, f.knightY = r.Intn(fieldW), r.Intn(fieldH)
+	return f
+}
+
+func (f *field) String() string {
+	var sb strings.Builder
+	for y := 0; y < fieldH; y++ {
+		for x := 0; x < fieldW; x++ {
+			sb.WriteByte(byte('0' + f.floors[y][x]))
+			if x == f.knightX && y == f.knightY {
+				sb.WriteByte('K')
+			}
+		}
+		sb.WriteByte('\n')
+	}
+	return sb.String()
+}
+
+func main() {
+	num := flag.Int("r", 0, "number of random fields instead of the field file")
+	ones := flag.Float64("ones", 0.5, "ratio of floors of 1 in random fields")
+	seed := flag.Int64("seed", 1, "random seed of the fields")
+	flag.Parse()
+
+	if *num > 0 {
+		r := rand.New(rand.NewSource(*seed))
+		var hist [fieldW * fieldH]int
+		var nodes int64
+		for i := 0; i < *num; i++ {
+			f := randomField(r, *ones)
+			best, n := solve(&f)
+			hist[len(best)]++
+			nodes += n
+		}
+		fmt.Printf("%d fields, ratio of 1 %.2f, %.1f nodes/field\n",
+			*num, *ones, float64(nodes)/float64(*num))
+		fmt.Println("chain  fields  ratio    point  total  label")
+		for n, c := range hist {
+			if c > 0 {
+				fmt.Printf("%5d %7d %6.2f%% %6d %6d  %s\n", n, c, float64(c)*100/float64(*num),
+					getPoint(n), chainPoints(n), evalLabel(n))
+			}
+		}
+		return
+	}
+
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+	fields, err := readFields(flag.Arg(0))
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	for i, f := range fields {
+		best, nodes := solve(&f)
+		fmt.Printf("Field %d\n%s", i+1, f.String())
+		fmt.Printf("chain %d, %d points %s (%d nodes)\n", len(best), chainPoints(len(best)),
+			evalLabel(len(best)), nodes)
+		route := make([]string, len(best))
+		for j, c := range best {
+			route[j] = fmt.Sprintf("(%d,%d)", c%fieldW, c/fieldW)
+		}
+		fmt.Printf("route %s\n\n", strings.Join(route, " "))
+	}
+}
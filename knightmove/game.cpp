@@ -10,6 +10,7 @@
 
 #define FLOOR_DEFAULT   3
 #define FLOOR_OPEN      0
+#define FLOOR_ALL       0xFFFFFFFFUL
 
 #define KNIGHT_DIR_MAX  8
 #define KNIGHT_RAD_FAST 64
@@ -52,6 +53,9 @@ static void     openMenu(void);
 static void     steerKnight(int8_t vd);
 static void     setHeartParams(int8_t n, bool isB);
 static void     placeNewHeart(void);
+static uint32_t reachableCells(uint8_t jumps);
+static uint32_t knightMoves(uint32_t b);
+static uint8_t  countBits(uint32_t b);
 static uint32_t getPoint(int8_t n);
 static void     evaluate(int8_t n);
 static void     setCongratsParams(bool isMulti);
@@ -77,6 +81,7 @@ static void     drawLargeLabelBitmap(int16_t y, const uint8_t *bitmap, uint8_t w
 /*  Local Functions (macros)  */
 
 #define circulate(n, v, m)  (((n) + (v) + (m)) % (m))
+#define cellBit(x, y)       (1UL << ((y) * FIELD_W + (x)))
 #define callStateHandler(n) ((void (*)(void)) pgm_read_ptr(handlerFuncTable + n))()
 
 /*  Local Variables  */
@@ -91,6 +96,7 @@ PROGMEM static void(*const handlerFuncTable[])(void) = {
 
 static STATE_T  state;
 static int8_t   field[FIELD_H][FIELD_W];
+static uint32_t floorBits; // bits of cells which aren't open, in the order of field[][]
 static uint32_t score, point;
 static uint16_t holes, knightRad, heartLife, heartLifeMax;
 static int8_t   knightX, knightY, knightVx, knightVy, knightDir, knightVDir, knightWait;
@@ -173,6 +179,7 @@ static void initGameParams(void)
         }
     }
     floors = FIELD_H * FIELD_W;
+    floorBits = FLOOR_ALL;
     knightX = random(FIELD_W);
     knightY = random(FIELD_H);
     knightRad = 0;
@@ -263,6 +270,7 @@ static void handleMoving(void)
                 if (holes < HOLES_MAX) holes++;
                 if (record.maxHoles < holes) record.maxHoles = holes;
                 floors--;
+                floorBits &= ~cellBit(knightX, knightY);
                 uint8_t idx = (continuous - 1) % 7;
                 arduboy.playScore2((continuous <= 7) ? soundPointLow[idx] : soundPointHigh[idx],
                         SND_PRIO_BOUND);
@@ -308,12 +316,14 @@ static void handleMoving(void)
         int8_t x = knightX + knightVx, y = knightY + knightVy;
         if (field[y][x] == FLOOR_OPEN) floors++;
         field[y][x] = 1;
+        floorBits |= cellBit(x, y);
     }
     if (dbgRecvChar == 'x') {
         heartX = knightX + knightVx;
         heartY = knightY + knightVy;
         if (field[heartY][heartX] == FLOOR_OPEN) floors++;
         field[heartY][heartX] = FLOOR_DEFAULT;
+        floorBits |= cellBit(heartX, heartY);
     }
     if (dbgRecvChar == 'q') setCongratsParams(false);
     if (dbgRecvChar == 'w') setCongratsParams(true);
@@ -326,6 +336,7 @@ static void handleLevelUp(void)
     if (counter == 8) {
         if (field[heartY][heartX] == FLOOR_OPEN) {
             field[heartY][heartX] = FLOOR_DEFAULT;
+            floorBits |= cellBit(heartX, heartY);
             floors++;
         }
         if (++heartY >= FIELD_H) {
@@ -406,19 +417,53 @@ static void setHeartParams(int8_t n, bool isB)
 
 static void placeNewHeart(void)
 {
-    if (floors < 1) {
+    uint32_t cells = floorBits & ~cellBit(knightX, knightY);
+    if (cells == 0) {
         heartX = -1;
         heartLife = 0;
         dprintln(F("No place for heart..."));
         return;
     }
-    do {
-        heartX = random(FIELD_W);
-        heartY = random(FIELD_H);
-    } while (field[heartY][heartX] == FLOOR_OPEN || heartX == knightX && heartY == knightY);
+
+    /*  Prefer the cells which the knight can reach before the heart expires  */
+    uint32_t reachable = cells & reachableCells((isBMode) ? heartNormMax : FIELD_W * FIELD_H);
+    if (reachable) cells = reachable;
+    uint8_t n = random(countBits(cells));
+    for (uint8_t i = 0; ; i++, cells >>= 1) {
+        if ((cells & 1) && n-- == 0) {
+            heartX = i % FIELD_W;
+            heartY = i / FIELD_W;
+            break;
+        }
+    }
     heartLife = heartLifeMax;
 }
 
+/*  Cells within the given number of jumps from the knight, over floors which aren't open  */
+static uint32_t reachableCells(uint8_t jumps)
+{
+    uint32_t visited = cellBit(knightX, knightY), frontier = visited;
+    for (uint8_t i = 0; i < jumps && frontier; i++) {
+        frontier = knightMoves(frontier) & floorBits & ~visited;
+        visited |= frontier;
+    }
+    return visited;
+}
+
+/*  Destinations of all knight moves from the cells, masking columns which wrap around (FIELD_W is 8)  */
+static uint32_t knightMoves(uint32_t b)
+{
+    return (b << 17 | b >> 15) & 0xFEFEFEFEUL | (b << 15 | b >> 17) & 0x7F7F7F7FUL |
+           (b << 10 | b >> 6)  & 0xFCFCFCFCUL | (b << 6 | b >> 10)  & 0x3F3F3F3FUL;
+}
+
+static uint8_t countBits(uint32_t b)
+{
+    uint8_t n = 0;
+    for (; b; b &= b - 1) n++;
+    return n;
+}
+
 static uint32_t getPoint(int8_t n)
 {
     if (n <= 7) {
@@ -581,8 +626,7 @@ static void drawHeart(void)
         dx += random(-1, 2);
         dy += random(-1, 2);
     }
-    arduboy.drawBitmap(dx, dy, imgHeartMask, IMG_HEART_W, IMG_HEART_H, BLACK);
-    arduboy.drawBitmap(dx, dy, imgHeart, IMG_HEART_W, IMG_HEART_H, WHITE);
+    arduboy.drawBitmapWithMask(dx, dy, imgHeart, imgHeartMask, IMG_HEART_W, IMG_HEART_H);
 }
 
 static void drawKnight(void)
@@ -607,18 +651,18 @@ static void drawKnight(void)
             arduboy.drawBitmap(dx + 18, dy + 19, imgShadow, IMG_SHADOW_W, IMG_SHADOW_H, BLACK);
         }
         if (state == STATE_MOVING && knightWait == 0) drawCursor();
-        arduboy.drawBitmap(dx + 14, dy - h + 7, imgKnightMask[idx],
-                IMG_KNIGHT_W, IMG_KNIGHT_H, BLACK);
+        arduboy.drawBitmapWithMask(dx + 14, dy - h + 7, imgKnight[idx], imgKnightMask[idx],
+                IMG_KNIGHT_W, IMG_KNIGHT_H);
+    } else {
+        arduboy.drawBitmap(dx + 14, dy - h + 7, imgKnight[idx], IMG_KNIGHT_W, IMG_KNIGHT_H, WHITE);
     }
-    arduboy.drawBitmap(dx + 14, dy - h + 7, imgKnight[idx], IMG_KNIGHT_W, IMG_KNIGHT_H, WHITE);
 }
 
 static void drawCursor(void)
 {
     int16_t dx = (knightX + knightVx) * FLOOR_W + 14;
     int16_t dy = (knightY + knightVy) * FLOOR_H + 13;
-    arduboy.drawBitmap(dx, dy, imgCursorMask, IMG_CURSOR_W, IMG_CURSOR_H, BLACK);
-    arduboy.drawBitmap(dx, dy, imgCursor, IMG_CURSOR_W, IMG_CURSOR_H, WHITE);
+    arduboy.drawBitmapWithMask(dx, dy, imgCursor, imgCursorMask, IMG_CURSOR_W, IMG_CURSOR_H);
 }
 
 static void drawCongrats(void)
@@ -631,8 +675,11 @@ static void drawCongrats(void)
     }
     int16_t dy = petitY * FLOOR_H + 17 + petitH;
     uint8_t idx = bitRead(petitH, 1);
-    if (petitH < 0) arduboy.drawBitmap(dx, dy, imgPetitMask[idx], IMG_PETIT_W, IMG_PETIT_H, BLACK);
-    arduboy.drawBitmap(dx, dy, imgPetit[idx], IMG_PETIT_W, IMG_PETIT_H, WHITE);
+    if (petitH < 0) {
+        arduboy.drawBitmapWithMask(dx, dy, imgPetit[idx], imgPetitMask[idx], IMG_PETIT_W, IMG_PETIT_H);
+    } else {
+        arduboy.drawBitmap(dx, dy, imgPetit[idx], IMG_PETIT_W, IMG_PETIT_H, WHITE);
+    }
 }
 
 static void drawStatus(void)
@@ -29,7 +29,7 @@ static void handleAnyButton(void);
 static void drawTitleImage(void);
 static void drawRecord(void);
 static void drawCredit(void);
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 
 /*  Local Variables  */
 
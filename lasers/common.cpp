@@ -168,6 +168,7 @@ void clearScreenGray(void)
     uint8_t *sBuffer = arduboy.getBuffer();
     uint8_t b1 = (isBlink) ? 0x55 : 0xaa;
     uint8_t b2 = ~b1;
+#ifdef __AVR__
     asm volatile (
         // load sBuffer pointer into Z
         "movw r30, %0\n\t"
@@ -190,6 +191,12 @@ void clearScreenGray(void)
         :
         : "r" (sBuffer), "r" (b1), "r" (b2)
     );
+#else
+    for (int i = 0; i < WIDTH * HEIGHT / 8; i += 2) {
+        sBuffer[i] = b1;
+        sBuffer[i + 1] = b2;
+    }
+#endif
     isBlink = !isBlink;
 }
 
@@ -255,27 +262,27 @@ void eepReadBlock(void *p, size_t n)
 void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
@@ -118,6 +118,7 @@ static int8_t   scoreX, scoreY, powerY;
 static int8_t   hitSound, lastHitSound, sparkIdx;
 static bool     isPlayerWhite, isHiscore;
 static const byte *pSound;
+static MyRandom laserRandom, sparkRandom;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -129,6 +130,8 @@ void initGame(void)
     isRecordDirty = true;
     writeRecord();
 
+    laserRandom.setSeed(random());
+    sparkRandom.setSeed(random());
     score = 0;
     scoreX = 0;
     scoreY = -9;
@@ -320,14 +323,14 @@ static void moveLaser(LASER_T *p)
 
 static void newLaser(LASER_T *p)
 {
-    p->x = random(2) * (LASER_X_MAX + LASER_DIAM * 2) - LASER_DIAM;
-    p->vx = random(6, 11) * ((p->x <= 0) * 2 - 1);
-    p->b = random(HEIGHT);
-    p->a = random(HEIGHT) - p->b;
-    p->d = random(DEG_MAX) * DEG_TO_RAD;
-    p->vd = random(RAY_VD_MIN, RAY_VD_MAX + 1) * (random(2) * 2 - 1);
+    p->x = laserRandom.below(2) * (LASER_X_MAX + LASER_DIAM * 2) - LASER_DIAM;
+    p->vx = laserRandom.range(6, 11) * ((p->x <= 0) * 2 - 1);
+    p->b = laserRandom.below(HEIGHT);
+    p->a = laserRandom.below(HEIGHT) - p->b;
+    p->d = laserRandom.below(DEG_MAX) * DEG_TO_RAD;
+    p->vd = laserRandom.range(RAY_VD_MIN, RAY_VD_MAX + 1) * (laserRandom.below(2) * 2 - 1);
     p->r = 0;
-    p->isWhite = (random(8) >= colorBias);
+    p->isWhite = (laserRandom.below(8) >= colorBias);
     colorBias += p->isWhite * 2 - 1; 
     pSound = (p->isWhite) ? soundLaserWhite : soundLaserBlack;
 }
@@ -347,9 +350,9 @@ static void moveSparks(void)
 static void newSpark(int16_t d, uint8_t s, bool isWhite)
 {
     SPARK_T *p = &sparks[sparkIdx];
-    p->d = d + random(-SPARK_D_DEVI, SPARK_D_DEVI);
+    p->d = d + sparkRandom.range(-SPARK_D_DEVI, SPARK_D_DEVI);
     p->r = SPARK_R_MIN;
-    p->s = s + random(s);
+    p->s = s + sparkRandom.below(s);
     p->isWhite = isWhite;
     sparkIdx = (sparkIdx + 1) % SPARKS_MAX;
 }
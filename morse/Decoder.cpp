@@ -3,6 +3,10 @@
 /*  Defines  */
 
 #define COUNTER_MAX     0xFF
+#define UNIT_FRAMES16_MIN   24  // 1.5 frames
+#define UNIT_FRAMES16_MAX   240 // 15 frames
+#define UNIT_WEIGHT_SHIFT   5   // Moving average over 32 elements
+#define UNIT_MARGIN256_MIN  64  // 0.25 frames
 
 /*  Typedefs  */
 
@@ -13,8 +17,8 @@ typedef struct {
 
 /*  Local Functions (macros)  */
 
-#define thresholdLong(f)    ((f) * 5 / 2)
-#define thresholdBreak(f)   ((f) * 13 / 2)
+#define thresholdLong(f16)  ((f16) * 5 / 32)     // 2.5 units
+#define thresholdBreak(f16) ((f16) * 13 / 32)    // 6.5 units
 
 /*  Local Constants  */
 
@@ -51,9 +55,15 @@ PROGMEM static const CODE_T extendedTableJA[] = {
 
 /*---------------------------------------------------------------------------*/
 
-void Decoder::reset(uint8_t frames, uint8_t mode)
+void Decoder::reset(uint8_t frames, uint8_t mode, bool adaptive)
 {
-    unitFrames = frames;
+    /*  The unit learned in the adaptive mode is kept until the speed setting is changed  */
+    if (!adaptive || !isAdaptive || frames != settingFrames) {
+        unitFrames16 = frames * 16;
+        unitFrames256 = unitFrames16 * 16;
+    }
+    settingFrames = frames;
+    isAdaptive = adaptive;
     isJapanese = (mode == DECODE_MODE_JA);
     isParenthesisOpen = false;
     forceStable();
@@ -72,6 +82,14 @@ char Decoder::appendSignal(bool isSignalOn)
     char ret = '\0';
 
     if (isSignalOn != isLastSignalOn) {
+        if (isAdaptive && stateCounter < COUNTER_MAX) {
+            uint16_t frames16 = (stateCounter + 1) * 16;
+            if (isLastSignalOn) {
+                adaptUnit((frames16 >= unitFrames16 * 2) ? frames16 / 3 : frames16); // Dash or dot
+            } else if (currentCode != CODE_INITIAL) {
+                adaptUnit(frames16); // Gap between elements
+            }
+        }
         isLastSignalOn = isSignalOn;
         stateCounter = 0;
     } else {
@@ -81,17 +99,17 @@ char Decoder::appendSignal(bool isSignalOn)
     if (isSignalOn) {
         if (stateCounter == 0) {
             if (!(currentCode & 0x100)) currentCode <<= 1;
-        } else if (stateCounter == thresholdLong(unitFrames)) {
+        } else if (stateCounter == thresholdLong(unitFrames16)) {
             currentCode |= 0x01;
         }
     } else {
-        if (stateCounter == thresholdLong(unitFrames)) {
+        if (stateCounter == thresholdLong(unitFrames16)) {
             ret = getCandidate();
             if (isNonGraph(ret)) stateCounter = COUNTER_MAX;
             if (ret == '(') isParenthesisOpen = true;
             if (ret == ')') isParenthesisOpen = false;
             currentCode = CODE_INITIAL;
-        } else if (stateCounter == thresholdBreak(unitFrames)) {
+        } else if (stateCounter == thresholdBreak(unitFrames16)) {
             ret = ' ';
         }
     }
@@ -100,6 +118,11 @@ char Decoder::appendSignal(bool isSignalOn)
     return ret;
 }
 
+uint8_t Decoder::getUnitFrames16(void)
+{
+    return unitFrames16;
+}
+
 uint16_t Decoder::getCurrentCode(void)
 {
     return currentCode;
@@ -129,3 +152,16 @@ char Decoder::getCandidate(void)
 
     return ret;
 }
+
+/*  Follows the unit length of the operator by the moving average of elements in 1/256 frames.
+    Elements which are too short or too long to tell a unit surely are ignored, and the unit for
+    the thresholds moves only when the average leaves it by 1/16, so it stays at a steady speed.  */
+void Decoder::adaptUnit(uint16_t frames16)
+{
+    if (frames16 < unitFrames16 / 2 || frames16 > unitFrames16 * 3 / 2) return;
+    int16_t diff = frames16 * 16 - unitFrames256;
+    unitFrames256 += (diff + (1 << (UNIT_WEIGHT_SHIFT - 1))) >> UNIT_WEIGHT_SHIFT;
+    unitFrames256 = constrain(unitFrames256, UNIT_FRAMES16_MIN * 16, UNIT_FRAMES16_MAX * 16);
+    uint8_t margin = (unitFrames16 > UNIT_MARGIN256_MIN) ? unitFrames16 : UNIT_MARGIN256_MIN;
+    if (abs(unitFrames256 - unitFrames16 * 16) > margin) unitFrames16 = (unitFrames256 + 8) >> 4;
+}
@@ -11,14 +11,17 @@
 class Decoder
 {
 public:
-    void        reset(uint8_t frames, uint8_t mode);
+    void        reset(uint8_t frames, uint8_t mode, bool adaptive = false);
     char        appendSignal(bool isSignalOn);
     void        forceStable(bool isResetParenthesis = false);
     uint16_t    getCurrentCode(void);
     char        getCandidate(void);
+    uint8_t     getUnitFrames16(void);
 
 private:
-    uint8_t     unitFrames, stateCounter;
-    uint16_t    currentCode;
-    bool        isLastSignalOn, isJapanese, isParenthesisOpen;
+    void        adaptUnit(uint16_t frames16);
+
+    uint8_t     settingFrames, unitFrames16, stateCounter;
+    uint16_t    currentCode, unitFrames256;
+    bool        isLastSignalOn, isJapanese, isParenthesisOpen, isAdaptive;
 };
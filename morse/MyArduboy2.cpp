@@ -37,12 +37,100 @@ void MyArduboy2::beginNoLogo(void)
 /*                               Buttons status                              */
 /*---------------------------------------------------------------------------*/
 
+#ifdef INPUT_HARNESS
+
+#include <util/crc16.h>
+#ifdef INPUT_REPLAY
+#include "replay.h" // Generated by etc/inputlog.go
+#endif
+
+uint16_t inputFrames;
+
+static uint8_t  inputRunState, inputRunCount;
+#ifdef INPUT_REPLAY
+static uint16_t inputReplayIdx, inputErrors;
+static bool     isInputReplaying;
+#endif
+
+static uint8_t updateInput(uint8_t state, const uint8_t *pBuffer)
+{
+    if (inputFrames == 0) {
+        while (!Serial) { ; } // Wait for the serial monitor
+#ifdef INPUT_REPLAY
+        uint32_t seed = pgm_read_dword(inputReplayData);
+        inputReplayIdx = 4;
+        isInputReplaying = true;
+#else
+        uint32_t seed = INPUT_SEED;
+#endif
+        Serial.print(F("S "));
+        Serial.println(seed, HEX);
+        srand(seed);
+        randomSeed(seed);
+    } else {
+        /*  Hash of the frame which has been drawn since the last call  */
+        uint16_t hash = 0xFFFF;
+        for (int i = 0; i < WIDTH * HEIGHT / 8; i++) {
+            hash = _crc16_update(hash, pBuffer[i]);
+        }
+#ifdef INPUT_REPLAY
+        if (isInputReplaying && inputFrames <= INPUT_REPLAY_HASHES &&
+                hash != pgm_read_word(&inputReplayHashes[inputFrames - 1])) {
+            inputErrors++;
+            Serial.print(F("E "));
+            Serial.println(inputFrames - 1);
+        }
+#else
+        Serial.print(F("H "));
+        Serial.println(hash, HEX);
+#endif
+    }
+
+#ifdef INPUT_REPLAY
+    if (isInputReplaying && inputRunCount == 0) {
+        inputRunCount = pgm_read_byte(inputReplayData + inputReplayIdx + 1);
+        if (inputRunCount > 0) {
+            inputRunState = pgm_read_byte(inputReplayData + inputReplayIdx);
+            inputReplayIdx += 2;
+        } else {
+            isInputReplaying = false; // Back to the real buttons
+            Serial.print(F("R "));
+            Serial.print(inputFrames);
+            Serial.print(' ');
+            Serial.println(inputErrors);
+        }
+    }
+    if (isInputReplaying) {
+        state = inputRunState;
+        inputRunCount--;
+    }
+#else
+    if (inputRunCount > 0 && (state != inputRunState || inputRunCount == 255)) {
+        Serial.print(F("I "));
+        Serial.print(inputRunState, HEX);
+        Serial.print(' ');
+        Serial.println(inputRunCount);
+        inputRunCount = 0;
+    }
+    inputRunState = state;
+    inputRunCount++;
+#endif
+    inputFrames++;
+    return state;
+}
+
+#endif
+
 bool MyArduboy2::nextFrame(void)
 {
     bool ret = Arduboy2::nextFrame();
     if (ret) {
         lastButtonState = currentButtonState;
+#ifdef INPUT_HARNESS
+        currentButtonState = updateInput(buttonsState(), getBuffer());
+#else
         currentButtonState = buttonsState();
+#endif
     }
     return ret;
 }
@@ -60,9 +60,15 @@ typedef struct {
     uint32_t    imeMode:1;
     uint8_t     led:2;
     uint8_t     ledColor:4;
+    uint8_t     isAdaptive:1;
     uint8_t     toneFreq;
 } RECORD_T; // sizeof(RECORD_T) is 10 bytes
 
+typedef struct {
+    const char  *label; // in PROGMEM, or NULL for a separator
+    void        (*func)(void);
+} MENU_ITEM_T;
+
 /*  Global Functions (Common)  */
 
 void    readRecord(void);
@@ -83,13 +89,12 @@ void    playSoundClick(void);
 
 /*  Global Functions (Menu)  */
 
-void    clearMenuItems(void);
-void    addMenuItem(const __FlashStringHelper *label, void (*func)(void));
+void    setMenu(const MENU_ITEM_T *pItems, int8_t count);
 int8_t  getMenuItemPos(void);
 int8_t  getMenuItemCount(void);
 void    setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f);
 void    setMenuItemPos(int8_t pos);
-void    setConfirmMenu(int8_t y, void (*funcOk)(), void (*funcCancel)());
+void    setConfirmMenu(int8_t y, const MENU_ITEM_T *pItems);
 void    handleMenu(void);
 void    drawMenuItems(bool isForced);
 
@@ -118,10 +123,12 @@ void    drawCredit(void);
 /*  Global Functions (macros)  */
 
 #define IMPORT_BIN_FILE(file, sym) asm (    \
+    ".pushsection .progmem.data,\"a\",@progbits\n" \
     ".global " #sym "\n"                    \
     #sym ":\n"                              \
     ".incbin \"" file "\"\n"                \
-    ".set _sizeof_" #sym ", . - " #sym "\n")
+    ".set _sizeof_" #sym ", . - " #sym "\n" \
+    ".popsection\n")
 
 #define circulate(n, v, m)  (((n) + (v) + (m)) % (m))
 
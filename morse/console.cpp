@@ -4,10 +4,10 @@
 #include "Encoder.h"
 #include "FakeKeyboard.h"
 
-IMPORT_BIN_FILE("fortuneDataEN.bin", fortuneDataEN);
-IMPORT_BIN_FILE("fortuneDataJP.bin", fortuneDataJP);
-IMPORT_BIN_FILE("fortuneOffsetEN.bin", fortuneOffsetEN);
-IMPORT_BIN_FILE("fortuneOffsetJP.bin", fortuneOffsetJP);
+#include "MyCorpus.h"
+
+IMPORT_BIN_FILE("fortuneEN.bin", fortuneEN);
+IMPORT_BIN_FILE("fortuneJP.bin", fortuneJP);
 
 /*  Defines  */
 
@@ -21,8 +21,7 @@ IMPORT_BIN_FILE("fortuneOffsetJP.bin", fortuneOffsetJP);
 #define RECENT_FRAMES_SOME  (FPS * 60 * 3)
 #define RECENT_LETTERS_MAX  200
 
-#define FORTUNE_EN_IDX_MAX  250
-#define FORTUNE_JP_IDX_MAX  100
+#define ANY_BUTTONS     (LEFT_BUTTON | RIGHT_BUTTON | UP_BUTTON | DOWN_BUTTON | A_BUTTON | B_BUTTON)
 
 /*  Local Functions  */
 
@@ -67,16 +66,36 @@ PROGMEM static const uint8_t imgComputer[120] = { // 40x24
     0x56, 0x72, 0x28, 0x14, 0x0A, 0x05, 0x03, 0x00
 };
 
+PROGMEM static const char menuLabelContinue[] = "CONTINUE";
+PROGMEM static const char menuLabelFortune[] = "FORTUNE WORDS";
+PROGMEM static const char menuLabelClear[] = "CLEAR CONSOLE";
+PROGMEM static const char menuLabelList[] = "CODE LIST";
+PROGMEM static const char menuLabelSettings[] = "SETTINGS";
+PROGMEM static const char menuLabelCredit[] = "CREDIT";
+PROGMEM static const char menuLabelOk[] = "OK";
+PROGMEM static const char menuLabelCancel[] = "CANCEL";
+
+PROGMEM static const MENU_ITEM_T menuItems[] = {
+    { menuLabelContinue,    onContinue },
+    { menuLabelFortune,     onFortune },
+    { menuLabelClear,       onConfirmClear },
+    { menuLabelList,        onList },
+    { menuLabelSettings,    onSettings },
+    { menuLabelCredit,      onCredit },
+};
+
+PROGMEM static const MENU_ITEM_T confirmClearItems[] = {
+    { menuLabelOk,          onClear },
+    { menuLabelCancel,      onContinue },
+};
+
 PROGMEM static const char welcomeEN[] = APP_TITLE "\0(A) MENU\0(B) SIGNAL ON\0";
 PROGMEM static const char welcomeJP[] =
         "\x8C\x92\x6A\x8E \x7F\x80\x90\x77 \x70\x8F\x89\x86\x77\x85\0"
         "(A) \x87\x63\x86\x92\0(B) \x89\x8F\x80\x90\x77 \x7A\x8F\0";
 
-extern const uint8_t fortuneDataEN[];
-extern const uint8_t fortuneDataJP[];
-extern const uint16_t fortuneOffsetEN[];
-extern const uint16_t fortuneOffsetJP[];
-PROGMEM static const char fortuneGraphsEN[] = { ' ', '\'', ',', '-', '?', '.' };
+extern const uint8_t fortuneEN[];
+extern const uint8_t fortuneJP[];
 
 /*  Local Variables  */
 
@@ -84,11 +103,11 @@ static Iambic       iambic;
 static Decoder      decoder;
 static Encoder      encoder;
 static FakeKeyboard fakeKeyboard;
+static MyCorpus     fortuneCorpus;
 
 static MODE_T   nextMode;
-static uint16_t recentFrames, fortuneData;
-static uint8_t  consoleX, consoleY, recentLetters, fortuneDataBits;
-static const uint8_t *pFortune;
+static uint16_t recentFrames;
+static uint8_t  consoleX, consoleY, recentLetters;
 static char     letters[CONSOLE_H][CONSOLE_W + 1], lastLetter, fortuneLetter;
 static bool     isFirst = true, isKeyboardActive, isIgnoreButton, isLastSignalOn, isMenuActive;
 
@@ -141,7 +160,7 @@ MODE_T updateConsole(void)
         }
     } else {
         if (isIgnoreButton) {
-            isIgnoreButton = (arduboy.buttonsState() != 0);
+            isIgnoreButton = arduboy.buttonPressed(ANY_BUTTONS);
         } else {
             handleSignal();
             handleExtraButtons();
@@ -169,7 +188,7 @@ static void applySettings(void)
 {
     uint8_t unitFrames = record.unitFrames + 2;
     iambic.reset(unitFrames);
-    decoder.reset(unitFrames, record.decodeMode);
+    decoder.reset(unitFrames, record.decodeMode, record.isAdaptive);
     encoder.reset(unitFrames, record.decodeMode);
     fakeKeyboard.reset(record.decodeMode, record.keyboard, record.imeMode);
 }
@@ -227,7 +246,7 @@ static bool handleSignalByFortune(void)
 static void handleExtraButtons(void)
 {
     if (fortuneLetter) {
-        if (arduboy.buttonsState() != 0) {
+        if (arduboy.buttonPressed(ANY_BUTTONS)) {
             if (isLastSignalOn) {
                 indicateSignalOff();
                 isLastSignalOn = false;
@@ -287,25 +306,7 @@ static void dealDecodedLetter(char letter)
 
 static void updateFortuneLetter(void)
 {
-    uint8_t bits = (record.decodeMode == DECODE_MODE_JA) ? 6 : 5;
-    if (fortuneDataBits < bits) {
-        fortuneData |= pgm_read_byte(pFortune++) << fortuneDataBits;
-        fortuneDataBits += 8;
-    }
-    uint8_t data = fortuneData & (1 << bits) - 1;
-    if (record.decodeMode == DECODE_MODE_JA) {
-        fortuneLetter = (data == 0x3F) ? '\0' : data + 0x60;
-    } else {
-        if (fortuneLetter == '.') {
-            fortuneLetter = '\0';
-        } else if (data < 26) {
-            fortuneLetter = data + 'A';
-        } else {
-            fortuneLetter = pgm_read_byte(&fortuneGraphsEN[data - 26]);
-        }
-    }
-    fortuneData >>= bits;
-    fortuneDataBits -= bits;
+    fortuneLetter = fortuneCorpus.next();
 }
 
 static void flushFortuneLetters(void)
@@ -365,13 +366,7 @@ static void setupMenu(void)
         recentLetters = 0;
         recentFrames = 0;
     }
-    clearMenuItems();
-    addMenuItem(F("CONTINUE"), onContinue);
-    addMenuItem(F("FORTUNE WORDS"), onFortune);
-    addMenuItem(F("CLEAR CONSOLE"), onConfirmClear);
-    addMenuItem(F("CODE LIST"), onList);
-    addMenuItem(F("SETTINGS"), onSettings);
-    addMenuItem(F("CREDIT"), onCredit);
+    setMenu(menuItems, sizeof(menuItems) / sizeof(*menuItems));
     setMenuCoords(18, 14, 91, 35, true);
     setMenuItemPos(0);
     playSoundClick();
@@ -389,27 +384,17 @@ static void onContinue(void)
 
 static void onFortune(void)
 {
-    uint16_t bitOffset;
-    if (record.decodeMode == DECODE_MODE_JA) {
-        bitOffset = pgm_read_word(&fortuneOffsetJP[random(FORTUNE_JP_IDX_MAX)]) * 6;
-        pFortune = fortuneDataJP;
-    } else {
-        bitOffset = pgm_read_word(&fortuneOffsetEN[random(FORTUNE_EN_IDX_MAX)]) * 5;
-        pFortune = fortuneDataEN;
-    }
-    pFortune += bitOffset >> 3;   // bitOffset / 8
-    uint8_t bits = bitOffset & 7; // bitOffset % 8
-    fortuneData = pgm_read_byte(pFortune++) >> bits;
-    fortuneDataBits = 8 - bits;
+    fortuneCorpus.setup((record.decodeMode == DECODE_MODE_JA) ? fortuneJP : fortuneEN);
+    fortuneCorpus.seek(random(fortuneCorpus.getCount()));
     updateFortuneLetter();
     encoder.setLetter(fortuneLetter);
-    decoder.forceStable(true);
+    decoder.reset(record.unitFrames + 2, record.decodeMode, record.isAdaptive);
     onContinue();
 }
 
 static void onConfirmClear(void)
 {
-    setConfirmMenu(34, onClear, onContinue);
+    setConfirmMenu(34, confirmClearItems);
 }
 
 static void onClear(void)
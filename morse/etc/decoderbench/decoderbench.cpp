@@ -0,0 +1,409 @@
+/*
+ * Offline test bench of Decoder and Iambic of morse.
+ *
+ * Keying timelines are made from the fortunes (fortuneEN.bin or fortuneJP.bin)
+ * by a simulated operator, with jitter of every element and gap and the speed
+ * drifting from the start to the end, or replayed from a log of the input
+ * harness ("I state frames" lines, see etc/inputlog.go). The signal is fed
+ * frame by frame to the real Decoder in the fixed and the adaptive speed mode,
+ * and the character error rate and the latency from the end of the last
+ * element to the committed letter are reported. With -a, the operator keys at
+ * several steady speeds, and the bench fails if the adaptive mode makes more
+ * errors than the fixed one at any of them.
+ *
+ * Build: c++ -O2 -std=gnu++11 -Wno-narrowing -I morse/etc/decoderbench/include \
+ *            -o decoderbench morse/etc/decoderbench/decoderbench.cpp
+ *
+ * Usage: decoderbench [-j] [-i] [-w wpm] [-s wpm] [-e wpm] [-x jitter]
+ *                     [-n entries] [-r seed] [-c corpus.bin] [-v]
+ *        decoderbench -a [-j] [-i] [-n entries] [-c corpus.bin]
+ *        decoderbench [-j] [-w wpm] [-t "expected text"] -l <log file>
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../../Decoder.cpp"
+#include "../../Encoder.cpp"
+#include "../../Iambic.cpp"
+#include "../../MyCorpus.h"
+
+/*  Defines  */
+
+#define FRAMES_PER_SEC  60
+#define PAUSE_UNITS     14
+
+/*  Typedefs  */
+
+struct STEADY_T {
+    int     wpm;
+    double  jitter;
+};
+
+struct RESULT_T {
+    std::string         decoded;
+    long                errors, letters;
+    std::vector<int>    latencies; // in frames
+    int                 unitFrames16;
+};
+
+/*  Local Constants  */
+
+/*  The operator keys at the setting, where the adaptive mode must not lose to the fixed one  */
+static const STEADY_T steadyCases[] = {
+    { 14, 0.0 }, { 14, 0.1 }, { 24, 0.05 }, { 10, 0.1 }, { 18, 0.05 },
+};
+
+/*  Global Variables (referred by common.h)  */
+
+RECORD_T    record;
+
+/*  Local Variables  */
+
+static Decoder      decoders[2]; // Fixed and adaptive
+static bool         isJapanese, isIambic, isSteadyCheck, isVerbose;
+static int          settingFrames = 5;
+static double       startUnit, endUnit, jitter = 0.1;
+static std::mt19937 rng(1);
+
+/*---------------------------------------------------------------------------*/
+/*                                 Keying                                    */
+/*---------------------------------------------------------------------------*/
+
+static double unitOfWPM(double wpm)
+{
+    return (double) FRAMES_PER_SEC * 6 / 5 / wpm; // "PARIS" is 50 units
+}
+
+/*  Same as the speed setting, 72 / (unitFrames + 2) WPM  */
+static void setSpeed(int wpm, int startWPM, int endWPM)
+{
+    settingFrames = constrain((72 + wpm / 2) / wpm, 2, UNIT_FRAMES_MAX + 1);
+    startUnit = unitOfWPM((startWPM > 0) ? startWPM : 72.0 / settingFrames);
+    endUnit = (endWPM > 0) ? unitOfWPM(endWPM) : startUnit;
+}
+
+static double jittered(double v)
+{
+    std::normal_distribution<double> dist(1.0, jitter);
+    return v * std::max(dist(rng), 0.2);
+}
+
+/*  Elements of a letter from the most significant one, true for a dash  */
+static std::vector<bool> elementsOf(Encoder &encoder, char letter)
+{
+    std::vector<bool> ret;
+    uint16_t code = encoder.getMorseCode(letter);
+    if (code <= 1) return ret;
+    uint16_t mask = 0x100;
+    while (!(code & mask)) mask >>= 1;
+    for (mask >>= 1; mask > 0; mask >>= 1) ret.push_back(code & mask);
+    return ret;
+}
+
+/*  Straight key: the operator makes every element and gap  */
+static std::vector<bool> keyStraight(Encoder &encoder, const std::string &text, double from, double to)
+{
+    std::vector<double> edges; // Times of turning on and off in frames
+    double t = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        double unit = from + (to - from) * i / text.size();
+        std::vector<bool> elements = elementsOf(encoder, text[i]);
+        if (elements.empty()) {
+            t += jittered(unit * 4); // Word gap is 7 units after letter gap
+            continue;
+        }
+        for (size_t j = 0; j < elements.size(); j++) {
+            if (j > 0) t += jittered(unit);
+            edges.push_back(t);
+            t += jittered(unit * (elements[j] ? 3 : 1));
+            edges.push_back(t);
+        }
+        t += jittered(unit * 3);
+    }
+    std::vector<bool> ret((size_t) t + 1 + (size_t) (to * PAUSE_UNITS), false);
+    for (size_t i = 0; i < edges.size(); i += 2) {
+        for (size_t f = (size_t) ceil(edges[i] - 0.5); f + 0.5 < edges[i + 1] && f < ret.size(); f++) ret[f] = true;
+    }
+    return ret;
+}
+
+/*  Iambic paddles: the operator presses a paddle, and releases it after the
+ *  keyer starts the element. The keyer makes the elements at the setting.  */
+static std::vector<bool> keyIambic(Encoder &encoder, const std::string &text, double from, double to)
+{
+    struct PRESS_T { bool isLong; double at; };
+    std::vector<PRESS_T> presses;
+    std::vector<double> gaps; // Gap before each press, in units of the operator
+    double pendingGap = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        std::vector<bool> elements = elementsOf(encoder, text[i]);
+        if (elements.empty()) {
+            pendingGap += 4;
+            continue;
+        }
+        for (size_t j = 0; j < elements.size(); j++) {
+            presses.push_back({ elements[j], (double) i / text.size() });
+            gaps.push_back((j > 0) ? 0 : pendingGap + 3);
+            pendingGap = 0;
+        }
+    }
+
+    Iambic iambic;
+    iambic.reset(settingFrames);
+    std::vector<bool> ret;
+    std::uniform_real_distribution<double> holdDist(0.3, 0.8);
+    std::normal_distribution<double> leadDist(0.5, jitter);
+    size_t idx = 0;
+    double pressAt = 0;
+    int releaseAt = -1, riseFrame = -1;
+    bool isPressed = false, isLastOn = false;
+    for (int f = 0; f < 0x100000; f++) {
+        if (!isPressed && idx < presses.size() && f >= pressAt) {
+            isPressed = true;
+            riseFrame = releaseAt = -1;
+        }
+        bool isLong = (idx < presses.size()) && presses[idx].isLong;
+        bool isOn = iambic.isSignalOn(isPressed && !isLong, isPressed && isLong);
+        ret.push_back(isOn);
+        if (isPressed && isOn && !isLastOn) {
+            int frames = settingFrames * (isLong ? 3 : 1);
+            riseFrame = f;
+            releaseAt = f + std::max((int) (frames * holdDist(rng)), 1);
+        }
+        if (isPressed && riseFrame >= 0 && f >= releaseAt) {
+            isPressed = false;
+            double end = riseFrame + settingFrames * (isLong ? 3 : 1);
+            if (++idx < presses.size()) {
+                double unit = from + (to - from) * presses[idx].at;
+                pressAt = end + ((gaps[idx] > 0) ? jittered(unit * gaps[idx]) : leadDist(rng) * settingFrames);
+            }
+        }
+        isLastOn = isOn;
+        if (idx == presses.size() && !isPressed && !isOn) break;
+    }
+    ret.resize(ret.size() + (size_t) (to * PAUSE_UNITS), false);
+    return ret;
+}
+
+/*  Button states of the input harness log, keyed as the console does  */
+static bool readLog(const char *path, std::vector<bool> &signal)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp) return false;
+    Iambic iambic;
+    iambic.reset(settingFrames);
+    char line[256];
+    unsigned int state, frames;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "I %x %u", &state, &frames) != 2) continue;
+        while (frames-- > 0) {
+            bool isOn = iambic.isSignalOn(state & LEFT_BUTTON, state & RIGHT_BUTTON);
+            signal.push_back(isOn || (state & B_BUTTON));
+        }
+    }
+    fclose(fp);
+    signal.resize(signal.size() + settingFrames * PAUSE_UNITS, false);
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Decode                                   */
+/*---------------------------------------------------------------------------*/
+
+static std::string normalize(const std::string &s)
+{
+    std::string ret;
+    for (char c : s) {
+        if (c == ' ' && (ret.empty() || ret.back() == ' ')) continue;
+        ret += c;
+    }
+    while (!ret.empty() && ret.back() == ' ') ret.pop_back();
+    return ret;
+}
+
+static long editDistance(const std::string &a, const std::string &b)
+{
+    std::vector<long> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); j++) row[j] = j;
+    for (size_t i = 1; i <= a.size(); i++) {
+        long diag = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= b.size(); j++) {
+            long next = std::min({ row[j] + 1, row[j - 1] + 1, diag + (a[i - 1] != b[j - 1]) });
+            diag = row[j];
+            row[j] = next;
+        }
+    }
+    return row[b.size()];
+}
+
+/*  Each decoder lives across the entries as in the console, which keeps the unit learned  */
+static void decode(const std::vector<bool> &signal, bool isAdaptive, const std::string &expected, RESULT_T *pResult)
+{
+    Decoder &decoder = decoders[isAdaptive];
+    decoder.reset(settingFrames, (isJapanese) ? DECODE_MODE_JA : DECODE_MODE_EN, isAdaptive);
+    std::string decoded;
+    int lastOff = -1;
+    bool isLastOn = false;
+    for (size_t f = 0; f < signal.size(); f++) {
+        if (isLastOn && !signal[f]) lastOff = f;
+        isLastOn = signal[f];
+        char letter = decoder.appendSignal(signal[f]);
+        if (letter == '\0') continue;
+        decoded += letter;
+        if (letter != ' ' && lastOff >= 0) pResult->latencies.push_back(f - lastOff);
+    }
+    decoded = normalize(decoded);
+    pResult->decoded += decoded + '\n';
+    pResult->errors += editDistance(normalize(expected), decoded);
+    pResult->letters += normalize(expected).size();
+    pResult->unitFrames16 = decoder.getUnitFrames16();
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Report                                   */
+/*---------------------------------------------------------------------------*/
+
+static double percentile(const std::vector<int> &sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    return sorted[std::min((size_t) (p * sorted.size()), sorted.size() - 1)] * 1000.0 / FRAMES_PER_SEC;
+}
+
+static void report(RESULT_T *results)
+{
+    printf("%-9s %8s %8s %9s %9s %9s %9s %7s\n",
+            "decoder", "letters", "CER", "avg ms", "p50 ms", "p90 ms", "max ms", "unit");
+    for (int i = 0; i < 2; i++) {
+        RESULT_T &r = results[i];
+        std::sort(r.latencies.begin(), r.latencies.end());
+        double sum = 0;
+        for (int l : r.latencies) sum += l;
+        size_t n = std::max(r.latencies.size(), (size_t) 1);
+        printf("%-9s %8ld %7.2f%% %9.1f %9.1f %9.1f %9.1f %7.2f\n",
+                (i == 0) ? "fixed" : "adaptive", r.letters, 100.0 * r.errors / std::max(r.letters, 1L),
+                sum / n * 1000.0 / FRAMES_PER_SEC, percentile(r.latencies, 0.5),
+                percentile(r.latencies, 0.9), percentile(r.latencies, 1.0), r.unitFrames16 / 16.0);
+    }
+}
+
+/*  Keys the entries of the corpus and decodes them in the both modes  */
+static void benchCorpus(MyCorpus &corpus, int entries, RESULT_T *results)
+{
+    Encoder encoder;
+    encoder.reset(settingFrames, (isJapanese) ? DECODE_MODE_JA : DECODE_MODE_EN);
+
+    int count = (entries > 0) ? std::min(entries, (int) corpus.getCount()) : corpus.getCount();
+    for (int idx = 0; idx < count; idx++) {
+        std::string text;
+        corpus.seek(idx);
+        for (char c; (c = corpus.next()); ) {
+            if (c == ' ' || encoder.getMorseCode(c) > 0) text += c;
+        }
+        double from = startUnit + (endUnit - startUnit) * idx / count;
+        double to = startUnit + (endUnit - startUnit) * (idx + 1) / count;
+        std::vector<bool> signal = (isIambic) ? keyIambic(encoder, text, from, to) : keyStraight(encoder, text, from, to);
+        for (int i = 0; i < 2; i++) decode(signal, i == 1, text, &results[i]);
+        if (isVerbose) {
+            printf("expected: %s\n", text.c_str());
+            for (int i = 0; i < 2; i++) {
+                std::string &d = results[i].decoded;
+                size_t pos = d.rfind('\n', d.size() - 2);
+                printf("%-9s %s", (i == 0) ? "fixed:" : "adaptive:", d.c_str() + ((pos == std::string::npos) ? 0 : pos + 1));
+            }
+        }
+    }
+    printf("%s, %s, setting %.0f WPM, operator %.1f -> %.1f WPM, jitter %.2f\n",
+            (isJapanese) ? "JA" : "EN", (isIambic) ? "iambic" : "straight", 72.0 / settingFrames,
+            FRAMES_PER_SEC * 1.2 / startUnit, FRAMES_PER_SEC * 1.2 / endUnit, jitter);
+    report(results);
+}
+
+int main(int argc, char *argv[])
+{
+    int wpm = 14, startWPM = 0, endWPM = 0, entries = 0;
+    const char *corpusPath = NULL, *logPath = NULL, *expected = "";
+    int opt;
+    while ((opt = getopt(argc, argv, "ajiw:s:e:x:n:r:c:l:t:v")) != -1) {
+        switch (opt) {
+        case 'a': isSteadyCheck = true; break;
+        case 'j': isJapanese = true; break;
+        case 'i': isIambic = true; break;
+        case 'w': wpm = atoi(optarg); break;
+        case 's': startWPM = atoi(optarg); break;
+        case 'e': endWPM = atoi(optarg); break;
+        case 'x': jitter = atof(optarg); break;
+        case 'n': entries = atoi(optarg); break;
+        case 'r': rng.seed(strtoul(optarg, NULL, 0)); break;
+        case 'c': corpusPath = optarg; break;
+        case 'l': logPath = optarg; break;
+        case 't': expected = optarg; break;
+        case 'v': isVerbose = true; break;
+        default: optind = argc + 1; break;
+        }
+    }
+    if (optind != argc || wpm <= 0) {
+        fprintf(stderr, "Usage: %s [-j] [-i] [-w wpm] [-s wpm] [-e wpm] [-x jitter] "
+                "[-n entries] [-r seed] [-c corpus.bin] [-v]\n"
+                "       %s -a [-j] [-i] [-n entries] [-c corpus.bin]\n"
+                "       %s [-j] [-w wpm] [-t \"expected text\"] -l <log file>\n", argv[0], argv[0], argv[0]);
+        return 2;
+    }
+
+    setSpeed(wpm, startWPM, endWPM);
+    RESULT_T results[2] = {};
+
+    if (logPath) {
+        std::vector<bool> signal;
+        if (!readLog(logPath, signal)) {
+            perror(logPath);
+            return 1;
+        }
+        for (int i = 0; i < 2; i++) {
+            decode(signal, i == 1, expected, &results[i]);
+            printf("%s: %s", (i == 0) ? "fixed" : "adaptive", results[i].decoded.c_str());
+        }
+        report(results);
+        return 0;
+    }
+
+    std::string path = __FILE__;
+    path = path.substr(0, path.rfind('/') + 1) + "../../" + ((isJapanese) ? "fortuneJP.bin" : "fortuneEN.bin");
+    if (corpusPath) path = corpusPath;
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+        perror(path.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> blob(1 << 16);
+    blob.resize(fread(blob.data(), 1, blob.size(), fp));
+    fclose(fp);
+    MyCorpus corpus;
+    corpus.setup(blob.data());
+
+    if (isSteadyCheck) {
+        bool isLost = false;
+        for (const STEADY_T &c : steadyCases) {
+            setSpeed(c.wpm, 0, 0);
+            jitter = c.jitter;
+            rng.seed(1);
+            decoders[0] = decoders[1] = Decoder();
+            RESULT_T caseResults[2] = {};
+            benchCorpus(corpus, entries, caseResults);
+            if (caseResults[1].errors > caseResults[0].errors) {
+                printf("--- The adaptive mode loses at %d WPM, jitter %.2f\n", c.wpm, c.jitter);
+                isLost = true;
+            }
+        }
+        return (isLost) ? 1 : 0;
+    }
+    benchCorpus(corpus, entries, results);
+    return 0;
+}
+
@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+ * Arduboy2 stand-in for the bench: only the declarations which MyArduboy2.h
+ * needs, as nothing is drawn.
+ */
+
+#include <Arduino.h>
+
+#define ARDUBOY_LIB_VER 50201
+
+#define WIDTH   128
+#define HEIGHT  64
+#define BLACK   0
+#define WHITE   1
+
+#define LEFT_BUTTON     _BV(5)
+#define RIGHT_BUTTON    _BV(6)
+#define UP_BUTTON       _BV(7)
+#define DOWN_BUTTON     _BV(4)
+#define A_BUTTON        _BV(3)
+#define B_BUTTON        _BV(2)
+
+class Arduboy2
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    void    setCursor(int16_t, int16_t) {}
+    template <typename T> size_t print(T) { return 0; }
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build Decoder, Encoder, Iambic and MyCorpus
+ * on the host.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t     byte;
+
+class __FlashStringHelper;
+#define F(s)                ((const __FlashStringHelper *) (s))
+#define PROGMEM
+#define pgm_read_byte(p)    (*(const uint8_t *) (p))
+#define pgm_read_word(p)    (*(const uint16_t *) (p))
+#define _BV(b)              (1 << (b))
+
+#define constrain(v, l, h)  ((v) < (l) ? (l) : ((v) > (h) ? (h) : (v)))
@@ -1,43 +1,28 @@
 #include "common.h"
 
-/*  Defines  */
-
-#define MENU_COUNT_MAX  9
-
-/*  Typedefs  */
-
-typedef struct {
-    void (*func)(void);
-    const __FlashStringHelper *label;
-} ITEM_T;
-
 /*  Local Variables  */
 
+static const MENU_ITEM_T *pMenuItems;
 static int8_t   menuX, menuY, menuW, menuH;
 static int8_t   menuItemCount;
-static ITEM_T   menuItemAry[MENU_COUNT_MAX];
-static int8_t   menuItemPos;
+static int8_t   menuItemPos, drawnItemPos;
 static bool     isFramed, isInvalidMenu;
 
-/*---------------------------------------------------------------------------*/
+/*  Local Functions  */
 
-void clearMenuItems(void)
-{
-    menuItemCount = 0;
-    dprintln(F("Clear menu items"));
-}
+static void drawMenuItem(int8_t pos, int8_t y);
+static int8_t getMenuItemY(int8_t pos);
 
-void addMenuItem(const __FlashStringHelper *label, void (*func)(void))
+/*---------------------------------------------------------------------------*/
+
+/*  Items are read from the table in PROGMEM, where an item without label is a separator  */
+void setMenu(const MENU_ITEM_T *pItems, int8_t count)
 {
-    if (menuItemCount >= MENU_COUNT_MAX) return;
-    ITEM_T *pItem = &menuItemAry[menuItemCount];
-    pItem->label = label;
-    pItem->func = func;
-    menuItemCount++;
-    if (label != NULL) {
-        dprint(F("Add menu items: "));
-        dprintln(label);
-    }
+    pMenuItems = pItems;
+    menuItemCount = count;
+    isInvalidMenu = true;
+    dprint(F("Set menu items: "));
+    dprintln(count);
 }
 
 int8_t getMenuItemPos(void)
@@ -57,25 +42,22 @@ void setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f)
     menuW = w;
     menuH = h;
     isFramed = f;
+    isInvalidMenu = true;
 }
 
 void setMenuItemPos(int8_t pos)
 {
     menuItemPos = pos;
-    isInvalidMenu = true;
     dprint(F("menuItemPos="));
     dprintln(menuItemPos);
 }
 
-void setConfirmMenu(int8_t y, void (*funcOk)(), void (*funcCancel)())
+void setConfirmMenu(int8_t y, const MENU_ITEM_T *pItems)
 {
     playSoundClick();
-    clearMenuItems();
-    addMenuItem(F("OK"), funcOk);
-    addMenuItem(F("CANCEL"), funcCancel);
+    setMenu(pItems, 2);
     setMenuCoords(40, y, 47, 11, true);
     setMenuItemPos(1);
-    isInvalidMenu = true;
 }
 
 void handleMenu(void)
@@ -83,34 +65,61 @@ void handleMenu(void)
     if (padY != 0) {
         do {
             menuItemPos = circulate(menuItemPos, padY, menuItemCount);
-        } while (menuItemAry[menuItemPos].func == NULL);
+        } while (pgm_read_ptr(&pMenuItems[menuItemPos].func) == NULL);
         playSoundTick();
-        isInvalidMenu = true;
         dprint(F("menuItemPos="));
         dprintln(menuItemPos);
     }
     if (arduboy.buttonDown(B_BUTTON)) {
-        menuItemAry[menuItemPos].func();
+        ((void (*)(void)) pgm_read_ptr(&pMenuItems[menuItemPos].func))();
     }
 }
 
+/*  Only the items whose cursor has moved are redrawn unless forced  */
 void drawMenuItems(bool isForced)
 {
-    if (!isInvalidMenu && !isForced) return;
-    arduboy.fillRect(menuX - 1, menuY - 1, menuW + 2, menuH + 2, BLACK);
-    if (isFramed) {
-        arduboy.drawRect(menuX - 2, menuY - 2, menuW + 4, menuH + 4, WHITE);
+    if (isInvalidMenu || isForced) {
+        arduboy.fillRect(menuX - 1, menuY - 1, menuW + 2, menuH + 2, BLACK);
+        if (isFramed) {
+            arduboy.drawRect(menuX - 2, menuY - 2, menuW + 4, menuH + 4, WHITE);
+        }
+        int8_t y = menuY;
+        for (int8_t i = 0; i < menuItemCount; i++) {
+            if (pgm_read_ptr(&pMenuItems[i].label) != NULL) {
+                drawMenuItem(i, y);
+                y += 6;
+            } else {
+                y += 2;
+            }
+        }
+        isInvalidMenu = false;
+    } else if (drawnItemPos != menuItemPos) {
+        int8_t lastPos = drawnItemPos;
+        drawnItemPos = menuItemPos;
+        drawMenuItem(lastPos, getMenuItemY(lastPos));
+        drawMenuItem(menuItemPos, getMenuItemY(menuItemPos));
     }
-    ITEM_T *pItem = menuItemAry;
+    drawnItemPos = menuItemPos;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                              Local Functions                              */
+/*---------------------------------------------------------------------------*/
+
+static void drawMenuItem(int8_t pos, int8_t y)
+{
+    bool isSelected = (pos == menuItemPos);
+    arduboy.fillRect(menuX, y, menuW, 5, BLACK);
+    arduboy.printEx(menuX + 12 - isSelected * 4, y,
+            (const __FlashStringHelper *) pgm_read_ptr(&pMenuItems[pos].label));
+    if (isSelected) arduboy.fillRect(menuX, y, 5, 5, WHITE);
+}
+
+static int8_t getMenuItemY(int8_t pos)
+{
     int8_t y = menuY;
-    for (int i = 0; i < menuItemCount; i++, pItem++) {
-        if (pItem->label != NULL) {
-            arduboy.printEx(menuX + 12 - (i == menuItemPos) * 4, y, pItem->label);
-            if (i == menuItemPos) arduboy.fillRect(menuX, y, 5, 5, WHITE);
-            y += 6;
-        } else {
-            y += 2;
-        }
+    for (int8_t i = 0; i < pos; i++) {
+        y += (pgm_read_ptr(&pMenuItems[i].label) != NULL) ? 6 : 2;
     }
-    isInvalidMenu = false;
+    return y;
 }
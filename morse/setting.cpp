@@ -11,6 +11,7 @@ static void changeSettingCommon(void);
 static bool isIMEModeAvailable(void);
 static void onExit(void);
 static void onDecodeMode(void);
+static void onSpeed(void);
 static void onTestSignal(void);
 static void onKeyboard(void);
 static void onIMEMode(void);
@@ -29,6 +30,28 @@ PROGMEM static const char keyboardLabels[][6] = { "NONE", "US101", "JP106" };
 PROGMEM static const char imeModeLabels[][6] = { "ROMAN", "KANA" };
 PROGMEM static const char notAvailableLabel[] = "(N/A)";
 
+PROGMEM static const char menuLabelExit[] = "EXIT";
+PROGMEM static const char menuLabelMode[] = "MODE";
+PROGMEM static const char menuLabelSpeed[] = "SPEED";
+PROGMEM static const char menuLabelSound[] = "SOUND";
+PROGMEM static const char menuLabelToneFreq[] = "TONE FREQ";
+PROGMEM static const char menuLabelLed[] = "LED";
+PROGMEM static const char menuLabelLedColor[] = "LED COLOR";
+PROGMEM static const char menuLabelKeyboard[] = "KEYBOARD";
+PROGMEM static const char menuLabelIMEMode[] = "IME MODE";
+
+PROGMEM static const MENU_ITEM_T menuItems[SETTING_ITEMS] = {
+    { menuLabelExit,        onExit },
+    { menuLabelMode,        onDecodeMode },
+    { menuLabelSpeed,       onSpeed },
+    { menuLabelSound,       onTestSignal },
+    { menuLabelToneFreq,    onTestSignal },
+    { menuLabelLed,         onTestSignal },
+    { menuLabelLedColor,    onTestSignal },
+    { menuLabelKeyboard,    onKeyboard },
+    { menuLabelIMEMode,     onIMEMode },
+};
+
 /*  Local Variables  */
 
 static MODE_T nextMode;
@@ -40,16 +63,7 @@ static bool   isSettingChanged;
 
 void initSetting(void)
 {
-    clearMenuItems();
-    addMenuItem(F("EXIT"), onExit);
-    addMenuItem(F("MODE"), onDecodeMode);
-    addMenuItem(F("SPEED"), onTestSignal);
-    addMenuItem(F("SOUND"), onTestSignal);
-    addMenuItem(F("TONE FREQ"), onTestSignal);
-    addMenuItem(F("LED"), onTestSignal);
-    addMenuItem(F("LED COLOR"), onTestSignal);
-    addMenuItem(F("KEYBOARD"), onKeyboard);
-    addMenuItem(F("IME MODE"), onIMEMode);
+    setMenu(menuItems, SETTING_ITEMS);
     setMenuCoords(7, 8, 64, 53, false);
     setMenuItemPos(0);
     counter = 0;
@@ -182,6 +196,13 @@ static void onDecodeMode(void)
     changeSettingCommon();
 }
 
+static void onSpeed(void)
+{
+    record.isAdaptive = !record.isAdaptive;
+    changeSettingCommon();
+    onTestSignal();
+}
+
 static void onTestSignal(void)
 {
     indicateSignalOn();
@@ -220,7 +241,7 @@ static void drawSettingParams(int8_t pos)
                 break;
             case 2: // Speed
                 arduboy.print(72 / (record.unitFrames + 2));
-                p = (const char*)F(" WPM");
+                p = (const char*)(record.isAdaptive ? F(" AUTO") : F(" WPM"));
                 break;
             case 3: // Sound
                 p = (const char*)(arduboy.isAudioEnabled() ? F("ON") : F("OFF"));
@@ -23,6 +23,16 @@ public:
 };
 #endif
 
+//#define INPUT_RECORD  // Log button states and frame hashes to Serial
+//#define INPUT_REPLAY  // Replay button states of "replay.h" and verify frame hashes
+
+#if defined(INPUT_RECORD) || defined(INPUT_REPLAY)
+#define INPUT_HARNESS
+#define INPUT_SEED      0x4F424E00UL
+#define micros()        ((unsigned long) inputFrames << 14) // Deterministic time
+#define millis()        ((unsigned long) inputFrames << 4)
+extern uint16_t inputFrames;
+#endif
 
 class MyArduboy : public ARDUBOY_LIB_CLASS
 {
@@ -22,6 +22,7 @@ bool        isRecordDirty;
 int8_t      padX, padY, padRepeatCount;
 GAME_MODE_T gameMode = GAME_MODE_ENDLESS;
 bool        isInvalid;
+bool        isAutoPlay;
 
 PROGMEM const uint8_t imgLabelScore[19] = { // 19x5
     0x16, 0x15, 0x0D, 0x00, 0x1E, 0x11, 0x11, 0x00, 0x1E, 0x11, 0x0F, 0x00, 0x1F, 0x05, 0x1B, 0x00, 0x1F, 0x15, 0x11
@@ -250,27 +251,27 @@ void eepReadBlock(void *p, size_t n)
 void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
@@ -36,6 +36,11 @@ typedef struct {
     uint8_t     puzzleClearCount;
 } RECORD_T; // sizeof(RECORD_T) is 22 bytes
 
+typedef struct {
+    const char  *label; // in PROGMEM
+    void        (*func)(void);
+} MENU_ITEM_T;
+
 /*  Global Functions (Common)  */
 
 void    readRecord(void);
@@ -62,8 +67,7 @@ void    eepWriteBlock(const void *p, size_t n);
 
 /*  Global Functions (Menu)  */
 
-void    clearMenuItems(void);
-void    addMenuItem(const __FlashStringHelper *label, void (*func)(void));
+void    setMenu(const MENU_ITEM_T *pItems, uint8_t count, uint8_t hiddenMask);
 int8_t  getMenuItemCount(void);
 void    setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f, bool s);
 void    setMenuItemPos(int8_t pos);
@@ -93,6 +97,7 @@ extern bool     isRecordDirty;
 extern int8_t   padX, padY, padRepeatCount;
 extern GAME_MODE_T gameMode;
 extern bool     isInvalid;
+extern bool     isAutoPlay;
 
 extern const uint8_t imgLabelScore[];
 extern const uint8_t imgLabelChain[];
@@ -0,0 +1,423 @@
+/*
+ * Headless harness of the autoplayer of psicolo.
+ *
+ * The unchanged game.cpp is built on the host and its autoplayer plays games of
+ * the endless or the time limited mode to the end, frame by frame through
+ * updateGame(). Games are shared by worker processes, because the game logic
+ * keeps its state in file-scope globals, and game i always uses seed + i. The
+ * distributions of the score, the max chain, the final level and the erased
+ * dice of each face are reported, and the frames and the logic time per frame
+ * (mean, p99 and max of the CPU time of the thread on the host) spent at each
+ * level.
+ *
+ * At the pace of the demo mode (FPS / 8 frames a move), the autoplayer plays
+ * the endless mode through level 99, so the harness moves every 45 frames by
+ * default, at which every game ends. -c finds the fastest pace at which no
+ * game of the endless mode reaches the cap, and plays at it.
+ *
+ * Build: c++ -O2 -std=gnu++11 -w -I psicolo/etc/autoplay/include \
+ *            -o autoplay psicolo/etc/autoplay/autoplay.cpp
+ *
+ * Usage: autoplay [-l] [-c] [-g games] [-j jobs] [-s seed] [-m minutes] [-p frames]
+ *   -l  Time limited mode instead of the endless mode
+ *   -c  Calibrate the pace
+ *   -m  Stop a game of the endless mode at the minutes of play (default 30)
+ *   -p  Frames between moves of the autoplayer (default 45)
+ */
+
+#include <algorithm>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#define PACE_DEFAULT        45
+#define AUTO_PLAY_INTERVAL  pace
+
+static int  pace = PACE_DEFAULT;
+
+#include "../../game.cpp"
+
+/*  Defines  */
+
+#define LEVELS_NUM  (LEVEL_MAX + 1)
+#define BAR_WIDTH   40
+#define BINS_NUM    10
+#define NANOS_STEP  50
+#define NANOS_BINS  400 // Up to 20 us
+#define CLOCK_SAMPLES 1000
+
+/*  Typedefs  */
+
+struct GAME_RESULT_T {
+    long    score, maxChain, level, frames;
+    bool    isCapped;
+    long    erased[6];
+};
+
+struct LEVEL_STATS_T {
+    long    games, frames;
+    double  nanos, maxNanos;
+    long    bins[NANOS_BINS + 1];
+};
+
+/*  Global Variables (referred by common.h)  */
+
+MyArduboy   arduboy;
+RECORD_T    record;
+bool        isRecordDirty, isInvalid, isAutoPlay;
+int8_t      padX, padY, padRepeatCount;
+GAME_MODE_T gameMode = GAME_MODE_ENDLESS;
+
+const uint8_t imgLabelScore[1] = {}, imgLabelChain[1] = {}, imgLabelLevel[1] = {}, imgLabelTime[1] = {};
+const uint8_t imgLabelInfo[1] = {}, imgLabelStep[1] = {}, imgLabelIssue[1] = {};
+
+/*  Local Variables  */
+
+static int          gamesNum = 1000, jobsNum;
+static unsigned long baseSeed = 1;
+static long         framesMax = FPS * 60 * 30;
+static double       clockNanos;
+static std::mt19937 rng;
+
+static std::vector<GAME_RESULT_T> results;
+static LEVEL_STATS_T levelStats[LEVELS_NUM];
+
+/*---------------------------------------------------------------------------*/
+/*                                   Stubs                                   */
+/*---------------------------------------------------------------------------*/
+
+void randomSeed(unsigned long seed) { rng.seed(seed); }
+long random(long howBig) { return (howBig > 0) ? (long) (rng() % howBig) : 0; }
+long random(long howSmall, long howBig) { return howSmall + random(howBig - howSmall); }
+
+void    MyArduboy::beginNoLogo(void) {}
+bool    MyArduboy::nextFrame(void) { return true; }
+bool    MyArduboy::buttonDown(uint8_t buttons) { return false; }
+bool    MyArduboy::buttonPressed(uint8_t buttons) { return false; }
+bool    MyArduboy::buttonUp(uint8_t buttons) { return false; }
+void    MyArduboy::setTextColor(uint8_t color) {}
+void    MyArduboy::setTextColor(uint8_t color, uint8_t bg) {}
+size_t  MyArduboy::printEx(int16_t x, int16_t y, const char *p) { return 0; }
+size_t  MyArduboy::printEx(int16_t x, int16_t y, const __FlashStringHelper *p) { return 0; }
+size_t  MyArduboy::write(uint8_t c) { return 1; }
+void    MyArduboy::drawRect2(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color) {}
+void    MyArduboy::drawFastVLine2(int16_t x, int16_t y, int8_t h, uint8_t color) {}
+void    MyArduboy::drawFastHLine2(int16_t x, int16_t y, uint8_t w, uint8_t color) {}
+void    MyArduboy::fillRect2(int16_t x, int16_t y, uint8_t w, int8_t h, uint8_t color) {}
+bool    MyArduboy::isAudioEnabled(void) { return false; }
+void    MyArduboy::setAudioEnabled(bool on) {}
+void    MyArduboy::saveAudioOnOff(void) {}
+void    MyArduboy::playScore2(const byte *score, uint8_t priority) {}
+void    MyArduboy::stopScore2(void) {}
+
+void    readRecord(void) {}
+void    writeRecord(void) {}
+void    clearRecord(void) {}
+void    handleDPad(void) { padX = padY = 0; }
+void    drawNumber(int16_t x, int16_t y, int32_t value) {}
+void    drawTime(int16_t x, int16_t y, uint32_t frames) {}
+void    setSound(bool on) {}
+void    playSoundTick(void) {}
+void    playSoundClick(void) {}
+void    setMenu(const MENU_ITEM_T *pItems, uint8_t count, uint8_t hiddenMask) {}
+int8_t  getMenuItemCount(void) { return 0; }
+void    setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f, bool s) {}
+void    setMenuItemPos(int8_t pos) {}
+void    handleMenu(void) {}
+void    drawMenuItems(bool isForced) {}
+void    drawSoundEnabled(void) {}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Workers                                  */
+/*---------------------------------------------------------------------------*/
+
+static double getThreadNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*  The cost of reading the clock, which is taken from the time of each frame  */
+static void measureClock(void)
+{
+    clockNanos = 1e9;
+    for (int i = 0; i < CLOCK_SAMPLES; i++) {
+        double start = getThreadNanos();
+        clockNanos = std::min(getThreadNanos() - start, clockNanos);
+    }
+}
+
+/*  Plays a game, writes the result to the stream and adds the cost of each level  */
+static void playGame(unsigned long seed, FILE *pOut)
+{
+    bool isReached[LEVELS_NUM] = {};
+    randomSeed(seed);
+    isAutoPlay = true;
+    initGame();
+    while (state == STATE_PLAYING && (gameMode != GAME_MODE_ENDLESS || gameFrames < framesMax)) {
+        int idx = (gameMode == GAME_MODE_ENDLESS) ? level : 0;
+        LEVEL_STATS_T *pStats = &levelStats[idx];
+        double start = getThreadNanos();
+        updateGame();
+        double nanos = std::max(getThreadNanos() - start - clockNanos, 0.0);
+        pStats->games += !isReached[idx];
+        isReached[idx] = true;
+        pStats->frames++;
+        pStats->nanos += nanos;
+        pStats->maxNanos = std::max(pStats->maxNanos, nanos);
+        pStats->bins[std::min((long) nanos / NANOS_STEP, (long) NANOS_BINS)]++;
+    }
+
+    fprintf(pOut, "G %lu %u %d %lu %d", (unsigned long) score, maxChain, level,
+            (unsigned long) gameFrames, state == STATE_PLAYING);
+    for (int i = 0; i < 6; i++) fprintf(pOut, " %u", erasedEachDie[i]);
+    fprintf(pOut, "\n");
+}
+
+static void writeLevelStats(FILE *pOut)
+{
+    for (int i = 0; i < LEVELS_NUM; i++) {
+        LEVEL_STATS_T *pStats = &levelStats[i];
+        if (pStats->frames == 0) continue;
+        fprintf(pOut, "L %d %ld %ld %.0f %.0f", i, pStats->games, pStats->frames, pStats->nanos, pStats->maxNanos);
+        for (int j = 0; j <= NANOS_BINS; j++) fprintf(pOut, " %ld", pStats->bins[j]);
+        fprintf(pOut, "\n");
+    }
+}
+
+static void readResults(FILE *pIn)
+{
+    char *line = NULL;
+    size_t size = 0;
+    while (getline(&line, &size, pIn) > 0) {
+        GAME_RESULT_T r;
+        LEVEL_STATS_T stats;
+        int isCapped, idx, n;
+        if (sscanf(line, "G %ld %ld %ld %ld %d %ld %ld %ld %ld %ld %ld", &r.score, &r.maxChain, &r.level,
+                &r.frames, &isCapped, &r.erased[0], &r.erased[1], &r.erased[2], &r.erased[3],
+                &r.erased[4], &r.erased[5]) == 11) {
+            r.isCapped = isCapped;
+            results.push_back(r);
+        } else if (sscanf(line, "L %d %ld %ld %lf %lf%n", &idx, &stats.games, &stats.frames,
+                &stats.nanos, &stats.maxNanos, &n) == 5 && idx >= 0 && idx < LEVELS_NUM) {
+            LEVEL_STATS_T *pStats = &levelStats[idx];
+            pStats->games += stats.games;
+            pStats->frames += stats.frames;
+            pStats->nanos += stats.nanos;
+            pStats->maxNanos = std::max(pStats->maxNanos, stats.maxNanos);
+            char *p = line + n;
+            for (int j = 0; j <= NANOS_BINS; j++) pStats->bins[j] += strtol(p, &p, 10);
+        }
+    }
+    free(line);
+}
+
+static void runWorkers(void)
+{
+    results.clear();
+    memset(levelStats, 0, sizeof(levelStats));
+    std::vector<FILE *> pipes;
+    std::vector<pid_t> pids;
+    for (int job = 0; job < jobsNum; job++) {
+        int fds[2];
+        if (pipe(fds) < 0) {
+            perror("pipe");
+            exit(1);
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            FILE *pOut = fdopen(fds[1], "w");
+            measureClock();
+            for (int i = job; i < gamesNum; i += jobsNum) playGame(baseSeed + i, pOut);
+            writeLevelStats(pOut);
+            fclose(pOut);
+            _exit(0);
+        }
+        close(fds[1]);
+        if (pid < 0) {
+            perror("fork");
+            exit(1);
+        }
+        pipes.push_back(fdopen(fds[0], "r"));
+        pids.push_back(pid);
+    }
+    for (int job = 0; job < jobsNum; job++) {
+        readResults(pipes[job]);
+        fclose(pipes[job]);
+        waitpid(pids[job], NULL, 0);
+    }
+}
+
+/*  Finds the fastest pace at which no game of the endless mode reaches the cap  */
+static void calibratePace(void)
+{
+    GAME_MODE_T mode = gameMode;
+    gameMode = GAME_MODE_ENDLESS;
+    int lo = 1, hi = FPS * 2;
+    while (lo < hi) {
+        pace = (lo + hi) / 2;
+        runWorkers();
+        long capped = 0;
+        for (const GAME_RESULT_T &r : results) capped += r.isCapped;
+        printf("pace=%d capped=%ld/%zu\n", pace, capped, results.size());
+        if (capped == 0) {
+            hi = pace;
+        } else {
+            lo = pace + 1;
+        }
+    }
+    pace = lo;
+    gameMode = mode;
+    printf("calibrated pace=%d\n", pace);
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Report                                   */
+/*---------------------------------------------------------------------------*/
+
+static long percentile(std::vector<long> sorted, double p)
+{
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[std::min((size_t) (p * sorted.size()), sorted.size() - 1)];
+}
+
+static double mean(const std::vector<long> &values)
+{
+    double sum = 0;
+    for (long v : values) sum += v;
+    return sum / values.size();
+}
+
+static void printBar(long count, long countMax)
+{
+    int w = (countMax > 0) ? (int) ((count * BAR_WIDTH + countMax - 1) / countMax) : 0;
+    printf(" %-*s %ld\n", BAR_WIDTH, std::string(w, '#').c_str(), count);
+}
+
+static double binsPercentile(const long *bins, long count, double p)
+{
+    long n = 0;
+    for (int i = 0; i < NANOS_BINS; i++) {
+        n += bins[i];
+        if (n > p * count) return (i + 1) * NANOS_STEP;
+    }
+    return NANOS_BINS * NANOS_STEP;
+}
+
+static void printDistribution(const char *label, const std::vector<long> &values)
+{
+    printf("%-12s mean=%.1f min=%ld p10=%ld p50=%ld p90=%ld max=%ld\n", label, mean(values),
+            percentile(values, 0), percentile(values, 0.1), percentile(values, 0.5),
+            percentile(values, 0.9), percentile(values, 1.0));
+}
+
+static void printHistogram(const std::vector<long> &values)
+{
+    long valueMax = percentile(values, 1.0);
+    long width = std::max((valueMax + BINS_NUM) / BINS_NUM, 1L);
+    long counts[BINS_NUM] = {}, countMax = 0;
+    for (long v : values) countMax = std::max(countMax, ++counts[std::min(v / width, (long) BINS_NUM - 1)]);
+    for (int i = 0; i < BINS_NUM && i * width <= valueMax; i++) {
+        printf("  %8ld-%-8ld", i * width, (i + 1) * width - 1);
+        printBar(counts[i], countMax);
+    }
+}
+
+static void report(void)
+{
+    if (results.empty()) {
+        fprintf(stderr, "No games were played\n");
+        exit(1);
+    }
+    bool isEndless = (gameMode == GAME_MODE_ENDLESS);
+    std::vector<long> scores, chains, levels, seconds, erased[6];
+    long capped = 0;
+    for (const GAME_RESULT_T &r : results) {
+        scores.push_back(r.score);
+        chains.push_back(r.maxChain);
+        levels.push_back(r.level);
+        seconds.push_back(r.frames / FPS);
+        for (int i = 0; i < 6; i++) erased[i].push_back(r.erased[i]);
+        capped += r.isCapped;
+    }
+    printf("mode=%s games=%zu capped=%ld seed=%lu pace=%d\n", isEndless ? "endless" : "limited",
+            results.size(), capped, baseSeed, pace);
+
+    printDistribution("score", scores);
+    printHistogram(scores);
+    printDistribution("max chain", chains);
+    printHistogram(chains);
+    if (isEndless) {
+        printDistribution("level", levels);
+        printDistribution("seconds", seconds);
+    }
+
+    printf("erased dice of each face per game\n");
+    double total = 0;
+    for (int i = 0; i < 6; i++) total += mean(erased[i]);
+    for (int i = 0; i < 6; i++) {
+        printf("  %d: mean=%7.1f p10=%5ld p50=%5ld p90=%5ld %5.1f%% ", i + 1, mean(erased[i]),
+                percentile(erased[i], 0.1), percentile(erased[i], 0.5), percentile(erased[i], 0.9),
+                mean(erased[i]) * 100.0 / std::max(total, 1.0));
+        printf("%s\n", std::string((int) (mean(erased[i]) * BAR_WIDTH / std::max(total, 1.0) * 2), '#').c_str());
+    }
+
+    printf("%-6s %8s %12s %10s %10s %10s\n", "level", "games", "frames/game", "avg us", "p99 us", "max us");
+    for (int i = 0; i < LEVELS_NUM; i++) {
+        LEVEL_STATS_T *pStats = &levelStats[i];
+        if (pStats->games == 0) continue;
+        printf("%-6s %8ld %12.0f %10.3f %10.3f %10.3f\n", isEndless ? std::to_string(i).c_str() : "-",
+                pStats->games, (double) pStats->frames / pStats->games, pStats->nanos / pStats->frames / 1000.0,
+                binsPercentile(pStats->bins, pStats->frames, 0.99) / 1000.0, pStats->maxNanos / 1000.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    jobsNum = std::max((int) std::thread::hardware_concurrency(), 1);
+    int opt;
+    bool isCalibrate = false;
+    while ((opt = getopt(argc, argv, "lcg:j:s:m:p:")) != -1) {
+        switch (opt) {
+        case 'l':
+            gameMode = GAME_MODE_LIMITED;
+            break;
+        case 'c':
+            isCalibrate = true;
+            break;
+        case 'g':
+            gamesNum = atoi(optarg);
+            break;
+        case 'j':
+            jobsNum = std::max(atoi(optarg), 1);
+            break;
+        case 's':
+            baseSeed = strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            framesMax = atol(optarg) * FPS * 60;
+            break;
+        case 'p':
+            pace = std::max(atoi(optarg), 1);
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc) {
+        fprintf(stderr, "Usage: %s [-l] [-c] [-g games] [-j jobs] [-s seed] [-m minutes] [-p frames]\n", argv[0]);
+        return 2;
+    }
+    if (isCalibrate) calibratePace();
+    runWorkers();
+    report();
+    return 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+ * Arduboy library stand-in for the autoplay harness: drawing, sound and LEDs
+ * do nothing and no button is ever pressed.
+ */
+
+#include <Arduino.h>
+
+#define WIDTH   128
+#define HEIGHT  64
+#define BLACK   0
+#define WHITE   1
+#define INVERT  2
+
+#define LEFT_BUTTON     _BV(5)
+#define RIGHT_BUTTON    _BV(6)
+#define UP_BUTTON       _BV(7)
+#define DOWN_BUTTON     _BV(4)
+#define A_BUTTON        _BV(3)
+#define B_BUTTON        _BV(2)
+
+class Print
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    size_t  print(const char *) { return 0; }
+    size_t  print(const __FlashStringHelper *) { return 0; }
+    size_t  print(char) { return 0; }
+    size_t  print(long, int = 10) { return 0; }
+    size_t  print(unsigned long, int = 10) { return 0; }
+    size_t  print(int n, int base = 10) { return print((long) n, base); }
+    size_t  print(unsigned int n, int base = 10) { return print((unsigned long) n, base); }
+    size_t  println(void) { return 0; }
+    template <typename T> size_t println(T v) { return print(v); }
+};
+
+class ArduboyAudio
+{
+public:
+    static void begin(void) {}
+    static void on(void) {}
+    static void off(void) {}
+    static bool enabled(void) { return false; }
+};
+
+class Arduboy : public Print
+{
+public:
+    void    clear(void) {}
+    void    display(void) {}
+    void    drawPixel(int16_t, int16_t, uint8_t = WHITE) {}
+    void    drawFastHLine(int16_t, int16_t, uint8_t, uint8_t = WHITE) {}
+    void    drawRect(int16_t, int16_t, uint8_t, uint8_t, uint8_t = WHITE) {}
+    void    fillRect(int16_t, int16_t, uint8_t, uint8_t, uint8_t = WHITE) {}
+    void    drawBitmap(int16_t, int16_t, const uint8_t *, uint8_t, uint8_t, uint8_t = WHITE) {}
+    void    setCursor(int16_t, int16_t) {}
+    void    setTextSize(uint8_t) {}
+    void    sendLCDCommand(uint8_t) {}
+    uint8_t buttonsState(void) { return 0; }
+    void    setRGBled(uint8_t, uint8_t, uint8_t) {}
+};
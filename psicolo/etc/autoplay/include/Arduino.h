@@ -0,0 +1,41 @@
+#pragma once
+
+/*
+ * Minimum of the Arduino core to build the game logic of psicolo on the host.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+
+class __FlashStringHelper;
+#define F(s)                ((const __FlashStringHelper *) (s))
+#define PROGMEM
+#define pgm_read_byte(p)    (*(const uint8_t *) (p))
+#define pgm_read_word(p)    pgmReadWord(p)
+#define memcpy_P            memcpy
+#define strlen_P            strlen
+#define _BV(b)              (1 << (b))
+
+/*  Tables of pointers are read as they are  */
+template <typename T>
+inline T pgmReadWord(const T *p) { return *p; }
+
+/*  Functions instead of the macros of Arduino, not to break the C++ library  */
+template <typename A, typename B>
+inline auto min(A a, B b) -> typename std::common_type<A, B>::type { return (a < b) ? a : b; }
+template <typename A, typename B>
+inline auto max(A a, B b) -> typename std::common_type<A, B>::type { return (a > b) ? a : b; }
+
+inline unsigned long millis(void) { return 0; }
+inline unsigned long micros(void) { return 0; }
+
+void    randomSeed(unsigned long seed);
+long    random(long howBig);
+long    random(long howSmall, long howBig);
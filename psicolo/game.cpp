@@ -50,6 +50,17 @@ enum OBJ_MODE
 #define BLINK_LEVEL_FRAMES_MAX  (FPS * 3)
 #define OVER_ANIM_FRAMES_MAX    FPS
 
+#ifndef AUTO_PLAY_INTERVAL
+#define AUTO_PLAY_INTERVAL      (FPS / 8) // Can be given by the autoplay harness
+#endif
+#define AUTO_PLAY_SCAN_CELLS    5
+
+#define MENU_HIDE_CONTINUE      _BV(0)
+#define MENU_HIDE_NEXT_ISSUE    _BV(2)
+#define MENU_HIDE_PREV_ISSUE    _BV(3)
+#define MENU_HIDE_ISSUES_LIST   _BV(4)
+#define MENU_HIDE_BACK_TO_TITLE _BV(5)
+
 /*  Typedefs  */
 
 typedef struct {
@@ -72,6 +83,8 @@ static void updateField(void);
 static void updateObject(OBJ_T *pObj);
 static OBJ_T *pickFloorObject(void);
 static void setDie(OBJ_T *pDie, OBJ_MODE mode);
+static void setObjectType(OBJ_T *pObj, uint8_t type);
+static void putObject(int x, int y, OBJ_T obj);
 
 static void moveCursor(void);
 static void rotateDie(OBJ_T *pDie, int vx, int vy);
@@ -83,6 +96,12 @@ static void vanishLinkedDice(uint16_t chain);
 static void vanishDie(OBJ_T *pObj, uint16_t chain);
 static void setVanishEffect(uint8_t type);
 
+static void updateAutoPlay(void);
+static void scanAutoPlayCell(int x, int y);
+static bool canRollDie(int x, int y, uint8_t dir);
+static uint32_t evaluateRoll(int x, int y, uint8_t dir, uint8_t *pNextDir);
+static uint32_t judgeVanishValue(int x, int y);
+
 static void setLevel(int level);
 static bool isTimeToBlinkFrame(void);
 static bool isGameOver(void);
@@ -109,9 +128,26 @@ static void drawOverAnimation(void);
 
 /*  Local Variables  */
 
+PROGMEM static const char menuLabelContinue[] = "CONTINUE";
+PROGMEM static const char menuLabelRestart[] = "RESTART";
+PROGMEM static const char menuLabelNextIssue[] = "NEXT ISSUE";
+PROGMEM static const char menuLabelPrevIssue[] = "PREV ISSUE";
+PROGMEM static const char menuLabelIssuesList[] = "ISSUES LIST";
+PROGMEM static const char menuLabelBackToTitle[] = "BACK TO TITLE";
+
+PROGMEM static const MENU_ITEM_T menuItems[] = {
+    { menuLabelContinue,    onMenuContine },
+    { menuLabelRestart,     onMenuRestart },
+    { menuLabelNextIssue,   onMenuNextIssue },
+    { menuLabelPrevIssue,   onMenuPreviousIssue },
+    { menuLabelIssuesList,  onMenuSelectIssue },
+    { menuLabelBackToTitle, onMenuBackToTitle },
+};
+
 static STATE_T  state = STATE_INIT;
 static OBJ_T    field[FIELD_H][FIELD_W];
 static uint8_t  vanishFlg[FIELD_H];
+static uint8_t  diceRows[6][FIELD_H]; // Bitboards of each type of dice
 static uint16_t erasedEachDie[6];
 static uint8_t  ledRGB[3];
 
@@ -130,7 +166,11 @@ static uint8_t  intervalDieUsual, intervalDieMax;
 static uint8_t  vanishFlashFrames, blinkFrameFrames, blinkChainFrames, blinkLevelFrames;
 static uint8_t  overAnimFrames;
 
-static bool     blinkFlg;
+static bool     blinkFlg, isHoldingB;
+static uint8_t  autoScanPos, autoWaitFrames, autoPlanIdx, autoBestCost;
+static int8_t   autoTargetX, autoTargetY;
+static uint8_t  autoPlan[2]; // Directions to roll, 0 for none
+static uint32_t autoBestRank;
 static const __FlashStringHelper *pLargeLabel;
 
 /*---------------------------------------------------------------------------*/
@@ -185,19 +225,20 @@ void drawGame(void)
             if (state == STATE_PLAYING) {
                 drawStrings();
                 drawCursor();
+                if (isAutoPlay && gameFrames % FPS < FPS * 2 / 3) arduboy.printEx(2, 29, F("DEMO"));
             }
             if (blinkFrameFrames > 0 && blinkFlg) arduboy.drawRect(0, 0, WIDTH, HEIGHT, WHITE);
         }
-        isInvalid = false;
     }
     if (state == STATE_MENU || state == STATE_RESULT) {
-        drawMenuItems(false);
+        drawMenuItems(isInvalid);
         arduboy.setRGBled(0, 0, 0);
     } else {
         if (state == STATE_OVER) drawOverAnimation();
         arduboy.setRGBled(ledRGB[0] * vanishFlashFrames, ledRGB[1] * vanishFlashFrames,
                 ledRGB[2] * vanishFlashFrames);
     }
+    isInvalid = false;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -236,6 +277,8 @@ static void startGame(void)
     blinkLevelFrames = 0;
     score = 0;
     blinkFlg = false;
+    autoScanPos = 0;
+    autoWaitFrames = 0;
     state = STATE_PLAYING;
     isRecordDirty = true;
     isInvalid = true;
@@ -247,7 +290,7 @@ static void initTrialField(void)
     for (int y = 0; y < FIELD_H; y++) {
         for (int x = 0; x < FIELD_W; x++) {
             OBJ_T *pObj = &field[y][x];
-            pObj->type = OBJ_TYPE_FLOOR;
+            setObjectType(pObj, OBJ_TYPE_FLOOR);
             pObj->depth = DEPTH_MAX;
         }
     }
@@ -276,11 +319,11 @@ static void initPuzzleField(void)
             uint16_t data = buffer & 0x1F;
             if (data < 30) {
                 if (data < 24) {
-                    pObj->type = data / 4 + OBJ_TYPE_1;
+                    setObjectType(pObj, data / 4 + OBJ_TYPE_1);
                     pObj->rotate = data % 4;
                     pObj->mode = OBJ_MODE_NORMAL;
                 } else {
-                    pObj->type = data - 24 + OBJ_TYPE_1;
+                    setObjectType(pObj, data - 24 + OBJ_TYPE_1);
                     pObj->rotate = 0;
                     pObj->mode = OBJ_MODE_FIXED;
                 }
@@ -288,7 +331,7 @@ static void initPuzzleField(void)
                 pObj->depth = 0;
                 countDice++;
             } else {
-                pObj->type = (data == 30) ? OBJ_TYPE_BLANK : OBJ_TYPE_FLOOR;
+                setObjectType(pObj, (data == 30) ? OBJ_TYPE_BLANK : OBJ_TYPE_FLOOR);
                 pObj->rotate = 0;
                 pObj->depth = DEPTH_MAX;
             }
@@ -322,7 +365,12 @@ static void updateGamePlaying(void)
     if (blinkFrameFrames > 0) blinkFrameFrames--;
     if (blinkChainFrames > 0) blinkChainFrames--;
     if (blinkLevelFrames > 0) blinkLevelFrames--;
-    handleDPad();
+    if (isAutoPlay) {
+        updateAutoPlay();
+    } else {
+        handleDPad();
+        isHoldingB = arduboy.buttonPressed(B_BUTTON);
+    }
     updateField();
     moveCursor();
     if (gameMode == GAME_MODE_ENDLESS) {
@@ -337,14 +385,18 @@ static void updateGamePlaying(void)
         }
     }
     gameFrames++;
-    record.playFrames++;
+    if (!isAutoPlay) record.playFrames++;
     blinkFlg = !blinkFlg;
     if (isGameOver()) {
         state = STATE_OVER;
-        writeRecord();
+        if (!isAutoPlay) writeRecord();
         blinkFlg = false;
         overAnimFrames = OVER_ANIM_FRAMES_MAX;
         dprintln(F("Game over"));
+    } else if (isAutoPlay) {
+        if (arduboy.buttonDown(UP_BUTTON | DOWN_BUTTON | LEFT_BUTTON | RIGHT_BUTTON | A_BUTTON | B_BUTTON)) {
+            state = STATE_LEAVE;
+        }
     } else if (arduboy.buttonDown(A_BUTTON)) {
         setupMenu();
     }
@@ -357,6 +409,8 @@ static void updateGameOver(void)
         overAnimFrames--;
         if (vanishFlashFrames > 0) vanishFlashFrames--;
         if (gameMode == GAME_MODE_PUZZLE && overAnimFrames == 0) arduboy.stopScore2();
+    } else if (isAutoPlay) {
+        state = STATE_LEAVE;
     } else if (arduboy.buttonDown(A_BUTTON | B_BUTTON)) {
         if (gameMode == GAME_MODE_PUZZLE) {
             state = STATE_ISSUES;
@@ -428,7 +482,7 @@ static void updateObject(OBJ_T *pObj)
         break;
     case OBJ_MODE_VANISH:
         if (++pObj->depth >= DEPTH_MAX) {
-            pObj->type = OBJ_TYPE_FLOOR;
+            setObjectType(pObj, OBJ_TYPE_FLOOR);
             pObj->depth = DEPTH_MAX;
             countDice--;
         }
@@ -451,7 +505,7 @@ static OBJ_T *pickFloorObject(void)
 
 static void setDie(OBJ_T *pDie, OBJ_MODE mode)
 {
-    pDie->type = random(OBJ_TYPE_1, OBJ_TYPE_6 + 1);
+    setObjectType(pDie, random(OBJ_TYPE_1, OBJ_TYPE_6 + 1));
     pDie->rotate = random(4);
     pDie->mode = mode;
     pDie->depth = (mode == OBJ_MODE_APPEAR) ? DEPTH_MAX : 0;
@@ -460,13 +514,32 @@ static void setDie(OBJ_T *pDie, OBJ_MODE mode)
     if (mode != OBJ_MODE_APPEAR) countValidDice++;
 }
 
+static void setObjectType(OBJ_T *pObj, uint8_t type)
+{
+    int idx = pObj - &field[0][0];
+    int y = idx / FIELD_W;
+    uint8_t bit = 1 << idx % FIELD_W;
+    if (pObj->type >= OBJ_TYPE_1 && pObj->type <= OBJ_TYPE_6) diceRows[pObj->type - OBJ_TYPE_1][y] &= ~bit;
+    if (type >= OBJ_TYPE_1 && type <= OBJ_TYPE_6) diceRows[type - OBJ_TYPE_1][y] |= bit;
+    pObj->type = type;
+}
+
+static void putObject(int x, int y, OBJ_T obj)
+{
+    OBJ_T *pObj = &field[y][x];
+    uint8_t type = obj.type;
+    obj.type = pObj->type;
+    *pObj = obj;
+    setObjectType(pObj, type);
+}
+
 static void moveCursor(void)
 {
     if (cursorX + padX < 0 || cursorX + padX >= FIELD_W) padX = 0;
     if (cursorY + padY < 0 || cursorY + padY >= FIELD_H) padY = 0;
     if (padX != 0 || padY != 0) {
         OBJ_T cursorObj = field[cursorY][cursorX];
-        if (arduboy.buttonPressed(B_BUTTON) && cursorObj.type >= OBJ_TYPE_1 &&
+        if (isHoldingB && cursorObj.type >= OBJ_TYPE_1 &&
                 cursorObj.type <= OBJ_TYPE_6 && cursorObj.depth == 0) {
             if (padX != 0 && padY != 0) {
                 if (blinkFlg) {
@@ -484,13 +557,13 @@ static void moveCursor(void)
                     destObj.depth = DEPTH_MAX;
                     countDice--;
                 }
-                field[cursorY][cursorX] = destObj;
+                putObject(cursorX, cursorY, destObj);
                 cursorX += padX;
                 cursorY += padY;
                 rotateDie(&cursorObj, padX, padY);
                 playSoundTick();
                 step--;
-                field[cursorY][cursorX] = cursorObj;
+                putObject(cursorX, cursorY, cursorObj);
                 judgeVanish(cursorX, cursorY);
             }
         } else {
@@ -555,33 +628,36 @@ static bool judgeHappyOne(int x, int y)
 
 static int judgeLinkedDice(int x, int y, uint16_t type, uint16_t *pChain)
 {
-    int link = 0, stackPos = 0;
-    uint8_t stack[FIELD_W * FIELD_H + 1];
-    uint8_t dir = 1;
+    /*  Flood fill from (x, y) on the bitboard of the type until it stops growing  */
+    const uint8_t *pRows = diceRows[type - OBJ_TYPE_1];
+    vanishFlg[y] = 1 << x;
+    bool isGrown;
+    do {
+        isGrown = false;
+        uint8_t upper = 0;
+        for (y = 0; y < FIELD_H; y++) {
+            uint8_t rows = vanishFlg[y];
+            uint8_t lower = (y < FIELD_H - 1) ? vanishFlg[y + 1] : 0;
+            uint8_t grown = (rows | rows << 1 | rows >> 1 | upper | lower) & pRows[y];
+            if (grown != rows) {
+                vanishFlg[y] = grown;
+                isGrown = true;
+            }
+            upper = grown;
+        }
+    } while (isGrown);
+
+    /*  Count the linked dice and gather the max chain among them  */
+    int link = 0;
     *pChain = 0;
-    while (stackPos >= 0) {
-        if (x < 0 || x >= FIELD_W || y < 0 || y >= FIELD_H ||
-            (vanishFlg[y] & 1 << x) || field[y][x].type != type) {
-            do {
-                if (--stackPos < 0) {
-                    goto bail;
-                }
-                dir = stack[stackPos];
-                x -= dir % 3 - 1;
-                y -= dir / 3 - 1;
-            } while (dir == 7);
-            dir += 2;
-        } else {
-            link++;
-            *pChain = max(*pChain, field[y][x].chain);
-            vanishFlg[y] |= 1 << x;
+    for (y = 0; y < FIELD_H; y++) {
+        for (x = 0; x < FIELD_W; x++) {
+            if (vanishFlg[y] & 1 << x) {
+                link++;
+                *pChain = max(*pChain, field[y][x].chain);
+            }
         }
-        x += dir % 3 - 1;
-        y += dir / 3 - 1;
-        stack[stackPos++] = dir;
-        dir = 1;
     }
-bail:
     return link;
 }
 
@@ -620,7 +696,7 @@ static void vanishLinkedDice(uint16_t chain)
 static void vanishDie(OBJ_T *pObj, uint16_t chain) {
     if (pObj->mode != OBJ_MODE_VANISH) {
         erasedEachDie[pObj->type - OBJ_TYPE_1]++;
-        record.erasedDice++;
+        if (!isAutoPlay) record.erasedDice++;
         norm--;
         if (pObj->mode != OBJ_MODE_APPEAR) countValidDice--;
     }
@@ -636,6 +712,146 @@ static void setVanishEffect(uint8_t type)
     vanishFlashFrames = VANISH_FLASH_FRAMES_MAX;
 }
 
+/*  Choose the die and the rolls by trying them on the field, and input them  */
+static void updateAutoPlay(void)
+{
+    padX = padY = 0;
+    isHoldingB = false;
+
+    /*  Scan some cells a frame not to take too long  */
+    if (autoScanPos < FIELD_W * FIELD_H) {
+        if (autoScanPos == 0) {
+            autoPlan[0] = 0;
+            autoPlanIdx = 0;
+            autoBestRank = 0;
+            autoBestCost = UINT8_MAX;
+        }
+        uint8_t flg[FIELD_H];
+        memcpy(flg, vanishFlg, FIELD_H); // Keep them for drawing flash
+        for (int i = 0; i < AUTO_PLAY_SCAN_CELLS && autoScanPos < FIELD_W * FIELD_H; i++, autoScanPos++) {
+            scanAutoPlayCell(autoScanPos % FIELD_W, autoScanPos / FIELD_W);
+        }
+        memcpy(vanishFlg, flg, FIELD_H);
+        return;
+    }
+
+    /*  Input at the pace of human  */
+    if (autoWaitFrames > 0) {
+        autoWaitFrames--;
+        return;
+    }
+    autoWaitFrames = AUTO_PLAY_INTERVAL;
+    uint8_t dir = (autoPlanIdx < 2) ? autoPlan[autoPlanIdx] : 0;
+    if (dir == 0 || !canRollDie(autoTargetX, autoTargetY, dir)) {
+        autoScanPos = 0; // Done or out of date
+        return;
+    }
+    if (cursorX != autoTargetX || cursorY != autoTargetY) {
+        padX = (autoTargetX > cursorX) - (autoTargetX < cursorX);
+        padY = (autoTargetY > cursorY) - (autoTargetY < cursorY);
+    } else {
+        padX = dir % 3 - 1;
+        padY = dir / 3 - 1;
+        isHoldingB = true;
+        autoTargetX += padX;
+        autoTargetY += padY;
+        autoPlanIdx++;
+    }
+}
+
+static void scanAutoPlayCell(int x, int y)
+{
+    uint8_t distance = max(abs(x - cursorX), abs(y - cursorY));
+    for (uint8_t dir = 1; dir < 8; dir += 2) {
+        if (!canRollDie(x, y, dir)) continue;
+        uint8_t nextDir;
+        uint32_t value = evaluateRoll(x, y, dir, &nextDir);
+        uint8_t cost = distance + 1 + (nextDir != 0);
+        uint32_t rank = value * 16 / cost;
+        if (rank > autoBestRank || (rank == autoBestRank &&
+                (cost < autoBestCost || (cost == autoBestCost && random(2))))) {
+            autoBestRank = rank;
+            autoBestCost = cost;
+            autoTargetX = x;
+            autoTargetY = y;
+            autoPlan[0] = dir;
+            autoPlan[1] = nextDir;
+        }
+    }
+}
+
+/*  Same as the conditions in moveCursor()  */
+static bool canRollDie(int x, int y, uint8_t dir)
+{
+    int nx = x + dir % 3 - 1;
+    int ny = y + dir / 3 - 1;
+    if (nx < 0 || nx >= FIELD_W || ny < 0 || ny >= FIELD_H) return false;
+    OBJ_T *pDie = &field[y][x];
+    OBJ_T *pDest = &field[ny][nx];
+    return (pDie->type >= OBJ_TYPE_1 && pDie->type <= OBJ_TYPE_6 && pDie->depth == 0 &&
+            pDie->mode == OBJ_MODE_NORMAL && (pDest->type == OBJ_TYPE_FLOOR ||
+            (pDest->type <= OBJ_TYPE_6 && pDest->depth >= DEPTH_MAX / 2)));
+}
+
+/*  Roll the die temporarily, and one more time if pNextDir isn't NULL and nothing vanishes  */
+static uint32_t evaluateRoll(int x, int y, uint8_t dir, uint8_t *pNextDir)
+{
+    int vx = dir % 3 - 1, vy = dir / 3 - 1;
+    OBJ_T dieObj = field[y][x], destObj = field[y + vy][x + vx];
+    OBJ_T obj = destObj;
+    if (obj.type != OBJ_TYPE_FLOOR && obj.mode == OBJ_MODE_VANISH) {
+        obj.type = OBJ_TYPE_FLOOR;
+        obj.depth = DEPTH_MAX;
+    }
+    putObject(x, y, obj);
+    obj = dieObj;
+    rotateDie(&obj, vx, vy);
+    putObject(x + vx, y + vy, obj);
+
+    uint32_t value = judgeVanishValue(x + vx, y + vy);
+    if (pNextDir) {
+        *pNextDir = 0;
+        if (value == 0) {
+            for (uint8_t nextDir = 1; nextDir < 8; nextDir += 2) {
+                if (nextDir == 8 - dir || !canRollDie(x + vx, y + vy, nextDir)) continue;
+                uint32_t nextValue = evaluateRoll(x + vx, y + vy, nextDir, NULL);
+                if (value < nextValue) {
+                    value = nextValue;
+                    *pNextDir = nextDir;
+                }
+            }
+        }
+    }
+
+    putObject(x + vx, y + vy, destObj);
+    putObject(x, y, dieObj);
+    return value;
+}
+
+/*  Score which judgeVanish() would give  */
+static uint32_t judgeVanishValue(int x, int y)
+{
+    uint8_t type = field[y][x].type;
+    if (type == OBJ_TYPE_1) {
+        if (!judgeHappyOne(x, y)) return 0;
+        uint32_t count = 0;
+        for (int i = 0; i < FIELD_W * FIELD_H; i++) {
+            OBJ_T *pObj = &field[0][0] + i;
+            if (pObj->type == OBJ_TYPE_1 &&
+                    (pObj->mode == OBJ_MODE_NORMAL || pObj->mode == OBJ_MODE_FIXED)) {
+                count++;
+            }
+        }
+        return count;
+    }
+    memset(vanishFlg, 0, FIELD_H);
+    uint16_t chain;
+    int link = judgeLinkedDice(x, y, type, &chain);
+    if (link < type) return 0;
+    if (chain < CHAIN_MAX) chain++;
+    return (uint32_t) type * link * chain;
+}
+
 static void setLevel(int newLevel)
 {
     level = newLevel;
@@ -681,7 +897,7 @@ static bool isGameOver(void)
     case GAME_MODE_ENDLESS:
         if (countValidDice >= FIELD_H * FIELD_W) {
             pLargeLabel = F("GAME OVER");
-            if (record.endlessHiscore < score) {
+            if (!isAutoPlay && record.endlessHiscore < score) {
                 record.endlessHiscore = score;
                 record.endlessMaxLevel = level;
                 dprintln(F("New record! (Endless)"));
@@ -693,7 +909,7 @@ static bool isGameOver(void)
     case GAME_MODE_LIMITED:
         if (gameFrames >= FRAMES_3MINUTES) {
             pLargeLabel = F("TIME UP");
-            if (record.limitedHiscore < score) {
+            if (!isAutoPlay && record.limitedHiscore < score) {
                 record.limitedHiscore = score;
                 record.limitedMaxChain = maxChain;
                 dprintln(F("New record! (Time Limited)"));
@@ -728,21 +944,19 @@ static bool isGameOver(void)
 
 static void setupMenu(void)
 {
-    clearMenuItems();
-    if (state == STATE_PLAYING) {
-        addMenuItem(F("CONTINUE"), onMenuContine);
-    }
-    addMenuItem(F("RESTART"), onMenuRestart);
+    uint8_t hiddenMask = 0;
+    if (state != STATE_PLAYING) hiddenMask |= MENU_HIDE_CONTINUE;
     int menuW;
     if (gameMode == GAME_MODE_PUZZLE) {
-        if (issue < COUNT_ISSUES - 1) addMenuItem(F("NEXT ISSUE"), onMenuNextIssue);
-        if (issue > 0) addMenuItem(F("PREV ISSUE"), onMenuPreviousIssue);
-        addMenuItem(F("ISSUES LIST"), onMenuSelectIssue);
+        if (issue >= COUNT_ISSUES - 1) hiddenMask |= MENU_HIDE_NEXT_ISSUE;
+        if (issue == 0) hiddenMask |= MENU_HIDE_PREV_ISSUE;
+        hiddenMask |= MENU_HIDE_BACK_TO_TITLE;
         menuW = 77;
     } else {
-        addMenuItem(F("BACK TO TITLE"), onMenuBackToTitle);
+        hiddenMask |= MENU_HIDE_NEXT_ISSUE | MENU_HIDE_PREV_ISSUE | MENU_HIDE_ISSUES_LIST;
         menuW = 89;
     }
+    setMenu(menuItems, sizeof(menuItems) / sizeof(*menuItems), hiddenMask);
     int menuH = getMenuItemCount() * 6 - 1;
     int menuY;
     bool flg;
@@ -1,17 +1,5 @@
 #include "common.h"
 
-/*  Defines  */
-
-#define MENU_COUNT_MAX  5
-
-/*  Typedefs  */
-
-typedef struct
-{
-    void (*func)(void);
-    const __FlashStringHelper *label;
-} ITEM_T;
-
 /*  Local Variables  */
 
 PROGMEM static const uint8_t imgSound[14] = {
@@ -23,30 +11,33 @@ PROGMEM static const uint8_t imgSoundOffOn[2][6] = {
     { 0x14, 0x08, 0x22, 0x1C, 0x41, 0x3E },
 };
 
+static const MENU_ITEM_T *pMenuItems;
+static uint8_t  menuHiddenMask;
 static int8_t   menuX, menuY, menuW, menuH;
 static bool     isFramed, isControlSound;
 static int8_t   menuItemCount;
-static ITEM_T   menuItemAry[MENU_COUNT_MAX];
-static int8_t   menuItemPos;
-static bool     isInvalidMenu;
+static int8_t   menuItemPos, drawnItemPos;
+static bool     isInvalidMenu, drawnSound;
+
+/*  Local Functions  */
+
+static const MENU_ITEM_T *getMenuItem(int8_t pos);
+static void drawMenuItem(int8_t pos);
 
 /*---------------------------------------------------------------------------*/
 
-void clearMenuItems(void)
+/*  Items are read from the table in PROGMEM, and ones of set bits of hiddenMask are skipped  */
+void setMenu(const MENU_ITEM_T *pItems, uint8_t count, uint8_t hiddenMask)
 {
+    pMenuItems = pItems;
+    menuHiddenMask = hiddenMask;
     menuItemCount = 0;
-    dprintln(F("Clear menu items"));
-}
-
-void addMenuItem(const __FlashStringHelper *label, void (*func)(void))
-{
-    if (menuItemCount >= MENU_COUNT_MAX) return;
-    ITEM_T *pItem = &menuItemAry[menuItemCount];
-    pItem->label = label;
-    pItem->func = func;
-    menuItemCount++;
-    dprint(F("Add menu items: "));
-    dprintln(label);
+    for (uint8_t i = 0; i < count; i++, hiddenMask >>= 1) {
+        if (!(hiddenMask & 1)) menuItemCount++;
+    }
+    isInvalidMenu = true;
+    dprint(F("Set menu items: "));
+    dprintln(menuItemCount);
 }
 
 int8_t getMenuItemCount(void)
@@ -62,12 +53,12 @@ void setMenuCoords(int8_t x, int8_t y, int8_t w, int8_t h, bool f, bool s)
     menuH = h;
     isFramed = f;
     isControlSound = s;
+    isInvalidMenu = true;
 }
 
 void setMenuItemPos(int8_t pos)
 {
     menuItemPos = pos;
-    isInvalidMenu = true;
     dprint(F("menuItemPos="));
     dprintln(menuItemPos);
 }
@@ -77,46 +68,76 @@ void handleMenu(void)
     if (arduboy.buttonDown(UP_BUTTON) && menuItemPos > 0) {
         menuItemPos--;
         playSoundTick();
-        isInvalidMenu = true;
         dprint(F("menuItemPos="));
         dprintln(menuItemPos);
     }
     if (arduboy.buttonDown(DOWN_BUTTON) && menuItemPos < menuItemCount - 1) {
         menuItemPos++;
         playSoundTick();
-        isInvalidMenu = true;
         dprint(F("menuItemPos="));
         dprintln(menuItemPos);
     }
     if (isControlSound && arduboy.buttonDown(A_BUTTON)) {
         setSound(!arduboy.isAudioEnabled());
         playSoundClick();
-        isInvalidMenu = true;
     }
     if (arduboy.buttonDown(B_BUTTON)) {
-        menuItemAry[menuItemPos].func();
+        ((void (*)(void)) pgm_read_ptr(&getMenuItem(menuItemPos)->func))();
     }
 }
 
+/*  Only the items whose cursor has moved and the sound icon are redrawn unless forced  */
 void drawMenuItems(bool isForced)
 {
-    if (!isInvalidMenu && !isForced) return;
-    arduboy.fillRect2(menuX - 1, menuY - 1, menuW + 2, menuH + 2, BLACK);
-    if (isFramed) {
-        arduboy.drawRect2(menuX - 2, menuY - 2, menuW + 4, menuH + 4, WHITE);
-    }
-    ITEM_T *pItem = menuItemAry;
-    for (int i = 0; i < menuItemCount; i++, pItem++) {
-        arduboy.printEx(menuX + 12 - (i == menuItemPos) * 4, menuY + i * 6, pItem->label);
+    if (isInvalidMenu || isForced) {
+        arduboy.fillRect2(menuX - 1, menuY - 1, menuW + 2, menuH + 2, BLACK);
+        if (isFramed) {
+            arduboy.drawRect2(menuX - 2, menuY - 2, menuW + 4, menuH + 4, WHITE);
+        }
+        for (int8_t i = 0; i < menuItemCount; i++) {
+            drawMenuItem(i);
+        }
+        if (isControlSound) drawSoundEnabled();
+        isInvalidMenu = false;
+    } else {
+        if (drawnItemPos != menuItemPos) {
+            int8_t lastPos = drawnItemPos;
+            drawnItemPos = menuItemPos;
+            drawMenuItem(lastPos);
+            drawMenuItem(menuItemPos);
+        }
+        if (isControlSound && drawnSound != arduboy.isAudioEnabled()) drawSoundEnabled();
     }
-    arduboy.fillRect2(menuX, menuY + menuItemPos * 6, 5, 5, WHITE);
-    if (isControlSound) drawSoundEnabled();
-    isInvalidMenu = false;
+    drawnItemPos = menuItemPos;
 }
 
 void drawSoundEnabled(void)
 {
+    drawnSound = arduboy.isAudioEnabled();
     arduboy.fillRect2(106, 56, 22, 8, BLACK);
     arduboy.drawBitmap(107, 57, imgSound, 14, 7, WHITE);
-    arduboy.drawBitmap(122, 57, imgSoundOffOn[arduboy.audio.enabled()], 6, 7, WHITE);
+    arduboy.drawBitmap(122, 57, imgSoundOffOn[drawnSound], 6, 7, WHITE);
+}
+
+/*---------------------------------------------------------------------------*/
+/*                              Local Functions                              */
+/*---------------------------------------------------------------------------*/
+
+static const MENU_ITEM_T *getMenuItem(int8_t pos)
+{
+    const MENU_ITEM_T *pItem = pMenuItems;
+    for (uint8_t mask = menuHiddenMask; (mask & 1) || pos-- > 0; mask >>= 1) {
+        pItem++;
+    }
+    return pItem;
+}
+
+static void drawMenuItem(int8_t pos)
+{
+    int8_t y = menuY + pos * 6;
+    bool isSelected = (pos == menuItemPos);
+    arduboy.fillRect2(menuX, y, menuW, 5, BLACK);
+    arduboy.printEx(menuX + 12 - isSelected * 4, y,
+            (const __FlashStringHelper *) pgm_read_ptr(&getMenuItem(pos)->label));
+    if (isSelected) arduboy.fillRect2(menuX, y, 5, 5, WHITE);
 }
@@ -2,6 +2,8 @@
 
 /*  Defines  */
 
+#define DEMO_IDLE_FRAMES    (FPS * 20)
+
 enum STATE_T {
     STATE_INIT = 0,
     STATE_TITLE,
@@ -17,6 +19,7 @@ static void onStartLimited(void);
 static void onStartPuzzle(void);
 static void onRecord(void);
 static void onCredit(void);
+static void startDemo(void);
 static void handleAnyButton(void);
 
 static void drawTitleImage(void);
@@ -47,10 +50,26 @@ PROGMEM static const uint8_t imgTitlePart[8] = { // 8x8
     0xC0, 0x40, 0x20, 0x20, 0x10, 0x10, 0x08, 0xF8,
 };
 
+PROGMEM static const char menuLabelEndless[] = "ENDLESS";
+PROGMEM static const char menuLabelLimited[] = "TIME LIMITED";
+PROGMEM static const char menuLabelPuzzle[] = "PUZZLE";
+PROGMEM static const char menuLabelRecord[] = "RECORD";
+PROGMEM static const char menuLabelCredit[] = "CREDIT";
+
+PROGMEM static const MENU_ITEM_T menuItems[] = {
+    { menuLabelEndless, onStartEndless },
+    { menuLabelLimited, onStartLimited },
+    { menuLabelPuzzle,  onStartPuzzle },
+    { menuLabelRecord,  onRecord },
+    { menuLabelCredit,  onCredit },
+};
+
 PROGMEM static const char creditText[] = "- " APP_TITLE " -\0\0" APP_RELEASED \
         "\0PROGRAMMED BY OBONO\0\0THIS PROGRAM IS\0RELEASED UNDER\0THE MIT LICENSE.";
 
 static STATE_T  state = STATE_INIT;
+static uint16_t idleFrames;
+static GAME_MODE_T lastGameMode;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -62,15 +81,15 @@ void initTitle(void)
         readRecord();
     }
 
-    clearMenuItems();
-    addMenuItem(F("ENDLESS"), onStartEndless);
-    addMenuItem(F("TIME LIMITED"), onStartLimited);
-    addMenuItem(F("PUZZLE"), onStartPuzzle);
-    addMenuItem(F("RECORD"), onRecord);
-    addMenuItem(F("CREDIT"), onCredit);
+    if (isAutoPlay) {
+        gameMode = lastGameMode;
+        isAutoPlay = false;
+    }
+    setMenu(menuItems, sizeof(menuItems) / sizeof(*menuItems), 0);
     setMenuCoords(22, 34, 84, 30, false, true);
     setMenuItemPos(gameMode);
 
+    idleFrames = 0;
     state = STATE_TITLE;
     isInvalid = true;
 }
@@ -80,6 +99,11 @@ MODE_T updateTitle(void)
     MODE_T ret = MODE_TITLE;
     if (state == STATE_TITLE) {
         handleMenu();
+        if (arduboy.buttonPressed(UP_BUTTON | DOWN_BUTTON | LEFT_BUTTON | RIGHT_BUTTON | A_BUTTON | B_BUTTON)) {
+            idleFrames = 0;
+        } else if (++idleFrames >= DEMO_IDLE_FRAMES) {
+            startDemo();
+        }
         if (state == STATE_STARTED) {
             ret = MODE_GAME;
         }
@@ -153,6 +177,15 @@ static void onCredit(void)
     dprintln(F("Show credit"));
 }
 
+static void startDemo(void)
+{
+    state = STATE_STARTED;
+    lastGameMode = gameMode;
+    gameMode = GAME_MODE_LIMITED; // Ends in 3 minutes
+    isAutoPlay = true;
+    dprintln(F("Start demo"));
+}
+
 static void handleAnyButton(void)
 {
     if (arduboy.buttonDown(A_BUTTON | B_BUTTON)) {
@@ -793,7 +793,7 @@ static bool cpuThinking(void)
     dprintln(depth);
     nextCpuInterval = millis() + CPU_INTERVAL_MILLIS;
     isCpuInterrupted = false;
-    isLastAPressed = arduboy.pressed(A_BUTTON);
+    isLastAPressed = arduboy.buttonPressed(A_BUTTON);
     int eval = -alphabeta(&work, depth, -EVAL_INF, EVAL_INF);
     arduboy.setRGBled(0, 0, 0);
     if (isCpuInterrupted) {
@@ -870,7 +870,11 @@ static void cpuThinkingInterval(void)
     record.playFrames += CPU_INTERVAL_FRAMES;
     counter += CPU_INTERVAL_FRAMES;
     nextCpuInterval += CPU_INTERVAL_MILLIS;
+#ifdef INPUT_HARNESS
+    bool isAPressed = arduboy.buttonPressed(A_BUTTON); // Only the logged state is replayed
+#else
     bool isAPressed = arduboy.pressed(A_BUTTON);
+#endif
     if (!isLastAPressed && isAPressed) {
         isCpuInterrupted = true;
     } else {
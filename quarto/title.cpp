@@ -35,7 +35,7 @@ static void drawRecord(void);
 static void drawSettingOnOff(void);
 static void drawInst(void);
 static void drawCredit(void);
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 static void drawOnOff(int8_t x, int8_t y, bool isOn);
 
 /*  Local Variables  */
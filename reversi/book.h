@@ -0,0 +1,55 @@
+// Generated by etc/bookgen.go: 8 plies, depth 8, 293 positions
+
+#define BOOK_PLIES  8
+
+PROGMEM static const uint32_t bookTable[] = {
+    0x0135B72A, 0x01CEBB2A, 0x01D9B113, 0x02E74F2A, 0x05039032, 0x05237D35,
+    0x05EB9A2B, 0x05F5922D, 0x05F6972A, 0x060FE01D, 0x0646EC1D, 0x07BABD19,
+    0x083B692A, 0x08B72B33, 0x08D4AA2A, 0x0A494C1A, 0x0A537613, 0x0A659C13,
+    0x0C72E813, 0x0CE0511D, 0x0D57AF2A, 0x11397E13, 0x125D6112, 0x12606919,
+    0x1305672A, 0x13317425, 0x13614F35, 0x1410632A, 0x143E8B22, 0x144FDE22,
+    0x15664B22, 0x165B1825, 0x1789AC1A, 0x17C05926, 0x189CCE2D, 0x1912D919,
+    0x1A50E422, 0x1A710B19, 0x1A9EB312, 0x1BA21A1A, 0x1BEDEE2B, 0x1CB8162A,
+    0x1D0ECC2D, 0x1D91852B, 0x1F5ADA2A, 0x20BEB812, 0x239D9A34, 0x23C40C12,
+    0x23EB042A, 0x259AC821, 0x27BFE815, 0x2AB3F12A, 0x2CD7F913, 0x3000982A,
+    0x32AEAF32, 0x3351523D, 0x3371542A, 0x3497701A, 0x349E702D, 0x361B3033,
+    0x36624822, 0x370E4214, 0x37196D1A, 0x37323B21, 0x389B9F22, 0x38FCB52B,
+    0x39CCC92B, 0x3C097C13, 0x3CFEEF2A, 0x3D5A032B, 0x3DE0B729, 0x3EFFB712,
+    0x3FF60B1D, 0x40602E13, 0x40E4D92B, 0x42519D21, 0x427C912A, 0x4460B012,
+    0x44C21515, 0x47BC7E13, 0x49C77C1A, 0x4AA1A822, 0x4C4C871A, 0x4C55DF2D,
+    0x4CB7ED22, 0x4CDD3122, 0x4DD66234, 0x4F2B9813, 0x506A4D22, 0x50901326,
+    0x51CD181A, 0x54A3E326, 0x552B921A, 0x57E1002C, 0x57FCDC22, 0x5822FC2A,
+    0x5A18422C, 0x5A673F13, 0x5ADEFB2A, 0x5B8B6321, 0x5D2CDC33, 0x5EF62A2A,
+    0x60BC603F, 0x64602113, 0x6625802E, 0x66FD0E25, 0x670F0D34, 0x69090529,
+    0x69411116, 0x6945602A, 0x69D47D21, 0x6B55C333, 0x6C23D532, 0x6C4E1B13,
+    0x6DE9E92B, 0x6F232513, 0x6F8ED52A, 0x71EA6013, 0x73FF1A14, 0x745A7319,
+    0x74B4D134, 0x74E94612, 0x75BB8912, 0x7603AE2B, 0x7796C62B, 0x77DB1212,
+    0x77F71212, 0x78B84219, 0x795A961A, 0x79EE1825, 0x7A1A3125, 0x7A2FB333,
+    0x7A32E134, 0x7B554534, 0x7BFC3C19, 0x7C1C8713, 0x7E27FD2A, 0x7F45CE1A,
+    0x81C7E12C, 0x81FF512A, 0x824BE926, 0x82CDA32C, 0x83F3AA22, 0x84FFCF2A,
+    0x85086321, 0x85A0891A, 0x88DB5F22, 0x8A86FA32, 0x8C3E0512, 0x8EFBEA2A,
+    0x8F045A13, 0x8F08E52A, 0x8F238012, 0x8FC5011A, 0x8FE85A15, 0x8FEEBC15,
+    0x9035202B, 0x92553214, 0x93D7AF34, 0x9429362A, 0x944D0132, 0x94907713,
+    0x94B20E12, 0x94D4F922, 0x94F6C035, 0x9501FF25, 0x96A53A34, 0x96F6E52A,
+    0x97EDB92A, 0x9891FC22, 0x98E92D14, 0x99AE392C, 0x9B37D113, 0x9BF43B12,
+    0x9DEE0521, 0x9ED49B1D, 0x9F08A61D, 0x9F653A19, 0xA00E8E2A, 0xA0A74E2A,
+    0xA12A2E21, 0xA1FDE82A, 0xA2629F21, 0xA326101D, 0xA3BE0222, 0xA3C8FA33,
+    0xA45F2321, 0xA4EAD814, 0xA807E222, 0xA8D94F35, 0xA9579622, 0xA970311D,
+    0xA9EBFC35, 0xAA918333, 0xAAD2682A, 0xAC254625, 0xACA38A25, 0xAD0D442A,
+    0xAECC9929, 0xAF21B733, 0xAF75C625, 0xB0E4CC2A, 0xB20E8E2B, 0xB36AA212,
+    0xB41C3B29, 0xB456A31E, 0xB4B0C82E, 0xB591782E, 0xB7F18D26, 0xB948AC19,
+    0xBA03F42A, 0xBA4A4B14, 0xBA7C6714, 0xBC291C14, 0xBD32FB2D, 0xBDC90512,
+    0xBE24162D, 0xBE38A222, 0xBE3BB612, 0xBFC2071D, 0xBFF3322A, 0xC08F2D22,
+    0xC1379C2E, 0xC1864026, 0xC1AC9C2D, 0xC1E6782D, 0xC3D02A32, 0xC459D228,
+    0xC507A52E, 0xC5DE232B, 0xC630CF29, 0xC6561121, 0xC70A672A, 0xC7C7C72D,
+    0xC7E2472A, 0xC80DF71D, 0xC8E6872D, 0xC9817022, 0xCA313C32, 0xCA8EC529,
+    0xCB0A8C1D, 0xCCD47934, 0xCD095019, 0xCD564825, 0xCDB96922, 0xCDCA192D,
+    0xCE0C6D2C, 0xCFA2D61A, 0xD01F402B, 0xD06BBA32, 0xD19B1D13, 0xD2A20C21,
+    0xD2DE8422, 0xD45D563F, 0xD47DF813, 0xD57B232A, 0xD6283734, 0xD87F4F26,
+    0xD8A44F13, 0xDA11972D, 0xDA5DD72D, 0xDB78AA2A, 0xDD8ED825, 0xDDB6CA1D,
+    0xDE6FC335, 0xDEFF7112, 0xE006412A, 0xE112C92B, 0xE242EB2B, 0xE43E0F25,
+    0xE4AE7022, 0xE57B3314, 0xE623F01D, 0xE7A94925, 0xE8938D2D, 0xE9310419,
+    0xE9989221, 0xEC01302C, 0xEDF08C2A, 0xEDF27914, 0xEE8CFD2D, 0xEF662534,
+    0xF118412B, 0xF2FBCA35, 0xF3D8A425, 0xF460B534, 0xF5E46922, 0xF7A68F13,
+    0xF83FC22C, 0xFAFA2F1A, 0xFCBFF42D, 0xFDC00514, 0xFE455F12,
+};
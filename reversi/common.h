@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MyArduboy.h"
+#include "MyRandom.h"
 
 /*  Defines  */
 
@@ -0,0 +1,161 @@
+package main
+
+/*
+Generate the opening book of reversi.
+
+The board rules, the evaluation and the search of game.cpp are reproduced, and
+the evaluation tables are read from data.h, so the book follows the tables.
+From the initial position, the best move of the CPU is searched deeply for
+every position which can appear within the given plies, for both colors of the
+CPU. Positions which are equal under the 8 symmetries of the board are stored
+once.
+
+Each entry of the book is a 32-bit value: the upper 24 bits of the FNV-1a hash
+of the position (black rows, white rows and the turn) and the move (y * 8 + x)
+in the lower 8 bits. The entries are sorted to be binary searched.
+
+Usage: go run bookgen.go engine.go [-plies n] [-depth n] [-o book.h] <data.h>
+*/
+
+import (
+	"flag"
+	"fmt"
+	"os"
+	"runtime"
+	"sort"
+	"sync"
+)
+
+/*---------------------------------------------------------------------------*/
+/*                                Generation                                 */
+/*---------------------------------------------------------------------------*/
+
+type generator struct {
+	plies, depth int
+	entries      map[uint32]uint32
+	collisions   int
+}
+
+/*  Walk the plies breadth first, searching the positions of the CPU in parallel  */
+func (g *generator) generate(isCpuWhite bool) {
+	visited := map[string]bool{}
+	frontier := []board{initialBoard()}
+	for len(frontier) > 0 {
+		var cpuNodes []board
+		var cpuTransforms []int
+		var next []board
+		for i := range frontier {
+			p := &frontier[i]
+			for p.numPlaceable == 0 && !p.isGameOver() {
+				*p = p.pass()
+			}
+			if p.numStones-initialStones >= g.plies || p.isGameOver() {
+				continue
+			}
+			t, key := p.canonical()
+			if visited[key] {
+				continue
+			}
+			visited[key] = true
+			if p.isWhiteTurn == isCpuWhite {
+				cpuNodes = append(cpuNodes, *p)
+				cpuTransforms = append(cpuTransforms, t)
+				continue
+			}
+			for y := 0; y < boardH; y++ {
+				for x := 0; x < boardW; x++ {
+					if p.placeable(x, y) {
+						next = append(next, p.play(x, y))
+					}
+				}
+			}
+		}
+
+		moves := make([][2]int, len(cpuNodes))
+		var wg sync.WaitGroup
+		sem := make(chan bool, runtime.NumCPU())
+		for i := range cpuNodes {
+			wg.Add(1)
+			sem <- true
+			go func(i int) {
+				defer wg.Done()
+				_, bx, by := alphabeta(&cpuNodes[i], g.depth, -evalInf, evalInf)
+				moves[i] = [2]int{bx, by}
+				<-sem
+			}(i)
+		}
+		wg.Wait()
+
+		for i := range cpuNodes {
+			p, t, bx, by := &cpuNodes[i], cpuTransforms[i], moves[i][0], moves[i][1]
+			if bx < 0 {
+				continue
+			}
+			g.store(p, t, bx, by)
+			next = append(next, p.play(bx, by))
+		}
+		frontier = next
+	}
+}
+
+func (g *generator) store(p *board, t, bx, by int) {
+	for m := 0; m < boardW*boardH; m++ {
+		if sx, sy := transformPos(m&7, m>>3, t); sx == bx && sy == by {
+			black, white := p.transform(t)
+			hash := hashBoard(black, white, p.isWhiteTurn) >> 8
+			if _, exists := g.entries[hash]; exists {
+				g.collisions++
+			} else {
+				g.entries[hash] = hash<<8 | uint32(m)
+			}
+			return
+		}
+	}
+}
+
+func main() {
+	plies := flag.Int("plies", 8, "number of moves from the initial position")
+	depth := flag.Int("depth", 8, "search depth")
+	out := flag.String("o", "book.h", "output header")
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+	if err := readTables(flag.Arg(0)); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	g := &generator{plies: *plies, depth: *depth, entries: map[uint32]uint32{}}
+	for _, isCpuWhite := range []bool{false, true} {
+		g.generate(isCpuWhite)
+	}
+	var entries []uint32
+	for _, e := range g.entries {
+		entries = append(entries, e)
+	}
+	sort.Slice(entries, func(i, j int) bool { return entries[i] < entries[j] })
+
+	w, err := os.Create(*out)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	defer w.Close()
+	fmt.Fprintf(w, "// Generated by etc/bookgen.go: %d plies, depth %d, %d positions\n\n", *plies, *depth, len(entries))
+	fmt.Fprintf(w, "#define BOOK_PLIES  %d\n\n", *plies)
+	fmt.Fprintf(w, "PROGMEM static const uint32_t bookTable[] = {\n")
+	for i := 0; i < len(entries); i += 6 {
+		fmt.Fprint(w, "   ")
+		for _, e := range entries[i:min(i+6, len(entries))] {
+			fmt.Fprintf(w, " 0x%08X,", e)
+		}
+		fmt.Fprintln(w)
+	}
+	fmt.Fprintf(w, "};\n")
+	if g.collisions > 0 {
+		fmt.Fprintf(os.Stderr, "%d positions were dropped by hash collisions\n", g.collisions)
+	}
+	fmt.Printf("%s: %d positions, %d bytes\n", *out, len(entries), len(entries)*4)
+}
@@ -0,0 +1,146 @@
+package main
+
+/*
+Benchmark the endgame solver of reversi and use it as an oracle.
+
+Random positions with the given number of empty squares are made by random
+playouts from the initial position. Each position is solved exactly by the
+same solver as game.cpp (parity ordering, fastest-first ordering and the disc
+differential), and the speed is reported. The move which the midgame search
+chooses at the given depth is also solved, to show how many discs the midgame
+search loses where the solver could take over.
+With -verify, the solver is checked against a plain minimax of the final disc
+differential, which is slow beyond 10 empties.
+
+Usage: go run endgame.go engine.go [-empties n] [-n positions] [-depth n]
+       [-seed n] [-verify] <data.h>
+*/
+
+import (
+	"flag"
+	"fmt"
+	"math/rand"
+	"os"
+	"time"
+)
+
+/*  Play random moves until the given number of empties remain with a move to play  */
+func randomPosition(r *rand.Rand, empties int) (board, bool) {
+	p := initialBoard()
+	for !p.isGameOver() {
+		if p.numPlaceable == 0 {
+			p = p.pass()
+			continue
+		}
+		if boardW*boardH-p.numStones == empties {
+			return p, true
+		}
+		n := r.Intn(p.numPlaceable)
+		for m := 0; m < boardW*boardH; m++ {
+			if p.placeable(m&7, m>>3) {
+				if n == 0 {
+					p = p.play(m&7, m>>3)
+					break
+				}
+				n--
+			}
+		}
+	}
+	return p, false
+}
+
+/*  Exact value of a move for the side to move  */
+func solveMove(p *board, x, y int) int {
+	q := p.play(x, y)
+	diff, _, _ := newEndgame(&q).solve(&q)
+	return -diff
+}
+
+func bruteForce(p *board) int {
+	if p.isGameOver() {
+		diff := p.numBlack - p.numWhite
+		if p.isWhiteTurn {
+			diff = -diff
+		}
+		empties := boardW*boardH - p.numStones
+		if diff > 0 {
+			diff += empties
+		} else if diff < 0 {
+			diff -= empties
+		}
+		return diff
+	}
+	if p.numPlaceable == 0 {
+		q := p.pass()
+		return -bruteForce(&q)
+	}
+	best := -boardW*boardH - 1
+	for m := 0; m < boardW*boardH; m++ {
+		if p.placeable(m&7, m>>3) {
+			q := p.play(m&7, m>>3)
+			best = max(best, -bruteForce(&q))
+		}
+	}
+	return best
+}
+
+func main() {
+	empties := flag.Int("empties", 14, "number of empty squares")
+	num := flag.Int("n", 100, "number of positions")
+	depth := flag.Int("depth", 4, "depth of the midgame search to compare")
+	seed := flag.Int64("seed", 1, "random seed of the positions")
+	verify := flag.Bool("verify", false, "check the solver against a plain minimax")
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+	if err := readTables(flag.Arg(0)); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	r := rand.New(rand.NewSource(*seed))
+	var positions, optimal, mismatches int
+	var nodes, lossTotal int64
+	var lossWorst int
+	var elapsed time.Duration
+	for positions < *num {
+		p, ok := randomPosition(r, *empties)
+		if !ok {
+			continue
+		}
+		positions++
+
+		e := newEndgame(&p)
+		start := time.Now()
+		diff, _, _ := e.solve(&p)
+		elapsed += time.Since(start)
+		nodes += e.nodes
+
+		_, mx, my := alphabeta(&p, *depth, -evalInf, evalInf)
+		loss := diff - solveMove(&p, mx, my)
+		if loss == 0 {
+			optimal++
+		}
+		lossTotal += int64(loss)
+		lossWorst = max(lossWorst, loss)
+
+		if *verify && bruteForce(&p) != diff {
+			mismatches++
+		}
+	}
+
+	seconds := elapsed.Seconds()
+	fmt.Printf("%d positions with %d empties\n", positions, *empties)
+	fmt.Printf("solver: %.1f positions/s, %.0f nodes/s, %.0f nodes/position\n",
+		float64(positions)/seconds, float64(nodes)/seconds, float64(nodes)/float64(positions))
+	fmt.Printf("midgame depth %d: %.1f%% optimal, %.2f discs lost on average, %d at worst\n",
+		*depth, float64(optimal)*100/float64(positions), float64(lossTotal)/float64(positions), lossWorst)
+	if *verify {
+		fmt.Printf("verify: %d mismatches\n", mismatches)
+		if mismatches > 0 {
+			os.Exit(1)
+		}
+	}
+}
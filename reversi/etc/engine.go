@@ -0,0 +1,547 @@
+package main
+
+/*
+Reversi engine shared by the host tools: the board rules, the fixed-stone
+analysis, the evaluation and the search of game.cpp, the endgame solver, and
+the evaluation tables read from data.h.
+Run the tools together with this file, e.g. "go run bookgen.go engine.go".
+*/
+
+import (
+	"fmt"
+	"io/ioutil"
+	"regexp"
+	"strconv"
+	"strings"
+)
+
+const (
+	boardW        = 8
+	boardH        = 8
+	initialStones = 4
+	fnvBasis      = 2166136261
+	fnvPrime      = 16777619
+)
+
+const (
+	existEmpty = iota
+	noEmpty
+	neighborFixed
+)
+
+type board struct {
+	black, white, flag                                          [boardH]uint8
+	numStones, numBlack, numWhite, numFixedBlack, numFixedWhite int
+	numPlaceable                                                int
+	isWhiteTurn, isLastPassed                                   bool
+}
+
+var (
+	evalStonesTable      [4][32]int
+	evalFixedStonesTable [4][32]int
+	evalInf              = 32767
+	evalWin              = 1000
+	evalLose             = -1000
+	evalNoPlaceable      = -10
+)
+
+/*---------------------------------------------------------------------------*/
+/*                              Rules of game.cpp                            */
+/*---------------------------------------------------------------------------*/
+
+func countBits(v uint8) int {
+	n := 0
+	for ; v != 0; v &= v - 1 {
+		n++
+	}
+	return n
+}
+
+func (p *board) analyze() {
+	p.numBlack, p.numWhite, p.numPlaceable = 0, 0, 0
+	for y := 0; y < boardH; y++ {
+		black, white, flag := p.black[y], p.white[y], p.flag[y]
+		p.numBlack += countBits(black)
+		p.numWhite += countBits(white)
+		for x := 0; x < boardW; x++ {
+			b := uint8(1) << x
+			if ^(black|white)&b != 0 {
+				if p.isPlaceable(x, y, false) {
+					flag |= b
+				} else {
+					flag &^= b
+				}
+			}
+		}
+		p.flag[y] = flag
+		p.numPlaceable += countBits(^(black | white) & flag)
+	}
+	p.numStones = p.numBlack + p.numWhite
+	p.checkFixedStones()
+}
+
+func (p *board) isPlaceable(x, y int, isActual bool) bool {
+	ret := false
+	if isActual {
+		b := uint8(1) << x
+		if p.isWhiteTurn {
+			p.white[y] |= b
+		} else {
+			p.black[y] |= b
+		}
+		p.flag[y] &^= b
+	}
+	for vy := -1; vy <= 1; vy++ {
+		for vx := -1; vx <= 1; vx++ {
+			if vx == 0 && vy == 0 {
+				continue
+			}
+			if p.isReversible(x, y, vx, vy, isActual) {
+				if !isActual {
+					return true
+				}
+				ret = true
+			}
+		}
+	}
+	return ret
+}
+
+func (p *board) isReversible(x, y, vx, vy int, isActual bool) bool {
+	for s := 0; ; s++ {
+		x += vx
+		y += vy
+		if x < 0 || y < 0 || x >= boardW || y >= boardH {
+			return false
+		}
+		b := uint8(1) << x
+		isBlack := p.black[y]&b != 0
+		isWhite := p.white[y]&b != 0
+		if !isBlack && !isWhite {
+			return false
+		}
+		if isWhite == p.isWhiteTurn {
+			if s == 0 {
+				return false
+			}
+			if isActual {
+				for ; s > 0; s-- {
+					x -= vx
+					y -= vy
+					b = uint8(1) << x
+					p.black[y] ^= b
+					p.white[y] ^= b
+				}
+			}
+			return true
+		}
+	}
+}
+
+func (p *board) checkFixedStones() {
+	for isUpdated := true; isUpdated; {
+		p.numFixedBlack, p.numFixedWhite = 0, 0
+		isUpdated = false
+		for y := 0; y < boardH; y++ {
+			black, white := p.black[y], p.white[y]
+			stones := black | white
+			if stones == 0 {
+				continue
+			}
+			flag := p.flag[y]
+			for x := 0; x < boardW; x++ {
+				b := uint8(1) << x
+				if stones&b != 0 && flag&b == 0 && p.isFixed(x, y, black&b != 0) {
+					flag |= b
+					isUpdated = true
+				}
+			}
+			p.flag[y] = flag
+			p.numFixedBlack += countBits(black & flag)
+			p.numFixedWhite += countBits(white & flag)
+		}
+	}
+}
+
+func (p *board) isFixed(x, y int, isCheckingBlack bool) bool {
+	for vy := -1; vy <= 0; vy++ {
+		vxMax := -1
+		if vy == -1 {
+			vxMax = 1
+		}
+		for vx := -1; vx <= vxMax; vx++ {
+			cond1 := p.checkFixCond(x, y, vx, vy, isCheckingBlack)
+			cond2 := p.checkFixCond(x, y, -vx, -vy, isCheckingBlack)
+			if cond1 == existEmpty && cond2 != neighborFixed || cond1 == noEmpty && cond2 == existEmpty {
+				return false
+			}
+		}
+	}
+	return true
+}
+
+func (p *board) checkFixCond(x, y, vx, vy int, isCheckingBlack bool) int {
+	ret := neighborFixed
+	for {
+		x += vx
+		y += vy
+		if x < 0 || y < 0 || x >= boardW || y >= boardH {
+			return ret
+		}
+		b := uint8(1) << x
+		isBlack := p.black[y]&b != 0
+		isWhite := p.white[y]&b != 0
+		if !isBlack && !isWhite {
+			return existEmpty
+		}
+		if ret == neighborFixed {
+			if p.flag[y]&b != 0 && isBlack == isCheckingBlack {
+				return neighborFixed
+			}
+			ret = noEmpty
+		}
+	}
+}
+
+func (p *board) isGameOver() bool {
+	return p.numStones == boardH*boardW || p.numBlack == 0 || p.numWhite == 0 ||
+		p.isLastPassed && p.numPlaceable == 0
+}
+
+func evaluateBit(table *[32]int, v uint8) int {
+	return table[v&0xF] + table[16+(v>>4&0xF)]
+}
+
+func (p *board) evaluate() int {
+	eval := 0
+	if p.isGameOver() {
+		if p.numBlack > p.numWhite {
+			eval = evalWin
+		} else if p.numBlack < p.numWhite {
+			eval = evalLose
+		}
+	} else {
+		for y := 0; y < boardH; y++ {
+			black, white, flag := p.black[y], p.white[y], p.flag[y]
+			row := y
+			if y >= boardH/2 {
+				row = boardH - 1 - y
+			}
+			eval += evaluateBit(&evalStonesTable[row], black&^flag)
+			eval -= evaluateBit(&evalStonesTable[row], white&^flag)
+			eval += evaluateBit(&evalFixedStonesTable[row], black&flag)
+			eval -= evaluateBit(&evalFixedStonesTable[row], white&flag)
+		}
+	}
+	if p.isWhiteTurn {
+		eval = -eval
+	}
+	eval += p.numPlaceable
+	if p.numPlaceable == 0 {
+		eval += evalNoPlaceable
+	}
+	return eval
+}
+
+func (p *board) play(x, y int) board {
+	q := *p
+	q.isPlaceable(x, y, true)
+	q.isWhiteTurn = !q.isWhiteTurn
+	q.isLastPassed = false
+	q.analyze()
+	return q
+}
+
+func (p *board) pass() board {
+	q := *p
+	q.isWhiteTurn = !q.isWhiteTurn
+	q.isLastPassed = true
+	q.analyze()
+	return q
+}
+
+func (p *board) placeable(x, y int) bool {
+	return ^(p.black[y]|p.white[y])&p.flag[y]&(1<<x) != 0
+}
+
+/*  Same as alphabeta() of game.cpp without the random noise, with the best move  */
+func alphabeta(p *board, depth, alpha, beta int) (int, int, int) {
+	if depth <= 0 || p.isGameOver() {
+		return -p.evaluate(), -1, -1
+	}
+	depth--
+	if p.numPlaceable == 0 {
+		q := p.pass()
+		eval, _, _ := alphabeta(&q, depth, -beta, -alpha)
+		return -eval, -1, -1
+	}
+	bestX, bestY := -1, -1
+	for y := 0; y < boardH; y++ {
+		for x := 0; x < boardW; x++ {
+			if !p.placeable(x, y) {
+				continue
+			}
+			q := p.play(x, y)
+			eval, _, _ := alphabeta(&q, depth, -beta, -alpha)
+			if eval > alpha {
+				alpha = eval
+				bestX, bestY = x, y
+			}
+			if alpha >= beta {
+				return -alpha, bestX, bestY
+			}
+		}
+	}
+	return -alpha, bestX, bestY
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                 Symmetries                                */
+/*---------------------------------------------------------------------------*/
+
+/*  Square of the original board which appears at (x, y) by transform t  */
+func transformPos(x, y, t int) (int, int) {
+	if t&1 != 0 {
+		x = boardW - 1 - x
+	}
+	if t&2 != 0 {
+		y = boardH - 1 - y
+	}
+	if t&4 != 0 {
+		x, y = y, x
+	}
+	return x, y
+}
+
+func (p *board) transform(t int) (black, white [boardH]uint8) {
+	for y := 0; y < boardH; y++ {
+		for x := 0; x < boardW; x++ {
+			sx, sy := transformPos(x, y, t)
+			black[y] |= (p.black[sy] >> sx & 1) << x
+			white[y] |= (p.white[sy] >> sx & 1) << x
+		}
+	}
+	return
+}
+
+func hashBoard(black, white [boardH]uint8, isWhiteTurn bool) uint32 {
+	hash := uint32(fnvBasis)
+	for _, v := range append(black[:], white[:]...) {
+		hash = (hash ^ uint32(v)) * fnvPrime
+	}
+	turn := uint32(0)
+	if isWhiteTurn {
+		turn = 1
+	}
+	return (hash ^ turn) * fnvPrime
+}
+
+/*  Canonical transform and the key of the position  */
+func (p *board) canonical() (int, string) {
+	bestT, bestKey := 0, ""
+	for t := 0; t < 8; t++ {
+		black, white := p.transform(t)
+		key := fmt.Sprintf("%x%x%v", black, white, p.isWhiteTurn)
+		if t == 0 || key < bestKey {
+			bestT, bestKey = t, key
+		}
+	}
+	return bestT, bestKey
+}
+
+/*---------------------------------------------------------------------------*/
+/*                         Endgame solver of game.cpp                        */
+/*---------------------------------------------------------------------------*/
+
+const endgameFastestFirst = 6
+
+type endgame struct {
+	squares []int
+	nodes   int64
+}
+
+/*  Order the empty squares by parity: quadrants with odd empties first  */
+func newEndgame(p *board) *endgame {
+	var quadrants [4]int
+	for y := 0; y < boardH; y++ {
+		for x := 0; x < boardW; x++ {
+			if ^(p.black[y]|p.white[y])&(1<<x) != 0 {
+				quadrants[y>>2*2+x>>2]++
+			}
+		}
+	}
+	e := &endgame{}
+	for parity := 1; parity >= 0; parity-- {
+		for y := 0; y < boardH; y++ {
+			for x := 0; x < boardW; x++ {
+				if ^(p.black[y]|p.white[y])&(1<<x) != 0 && quadrants[y>>2*2+x>>2]&1 == parity {
+					e.squares = append(e.squares, y<<3|x)
+				}
+			}
+		}
+	}
+	return e
+}
+
+/*  Exact disc differential for the side to move and its best move  */
+func (e *endgame) solve(p *board) (int, int, int) {
+	own, opp := p.black, p.white
+	if p.isWhiteTurn {
+		own, opp = opp, own
+	}
+	diff, m := e.search(&own, &opp, len(e.squares), -boardW*boardH-1, boardW*boardH+1, false)
+	return diff, m & 7, m >> 3
+}
+
+func (e *endgame) search(own, opp *[boardH]uint8, empties, alpha, beta int, isPassed bool) (int, int) {
+	e.nodes++
+	var moves []int
+	var replies []int
+	for _, sq := range e.squares {
+		x, y := sq&7, sq>>3
+		if (own[y]|opp[y])&(1<<x) != 0 {
+			continue
+		}
+		if empties >= endgameFastestFirst {
+			o, q := *own, *opp
+			if flipDiscs(&o, &q, x, y, true) == 0 {
+				continue
+			}
+			n := e.countMoves(&q, &o)
+			j := len(moves)
+			moves = append(moves, 0)
+			replies = append(replies, 0)
+			for ; j > 0 && replies[j-1] > n; j-- {
+				moves[j], replies[j] = moves[j-1], replies[j-1]
+			}
+			moves[j], replies[j] = sq, n
+		} else if flipDiscs(own, opp, x, y, false) > 0 {
+			moves = append(moves, sq)
+		}
+	}
+
+	if len(moves) == 0 {
+		if !isPassed && empties > 0 {
+			diff, _ := e.search(opp, own, empties, -beta, -alpha, true)
+			return -diff, -1
+		}
+		diff := 0
+		for y := 0; y < boardH; y++ {
+			diff += countBits(own[y]) - countBits(opp[y])
+		}
+		if diff > 0 {
+			diff += empties
+		} else if diff < 0 {
+			diff -= empties
+		}
+		return diff, -1
+	}
+
+	best := -1
+	for _, sq := range moves {
+		o, q := *own, *opp
+		flipDiscs(&o, &q, sq&7, sq>>3, true)
+		eval, _ := e.search(&q, &o, empties-1, -beta, -alpha, false)
+		eval = -eval
+		if eval > alpha {
+			alpha, best = eval, sq
+		}
+		if alpha >= beta {
+			break
+		}
+	}
+	return alpha, best
+}
+
+func (e *endgame) countMoves(own, opp *[boardH]uint8) int {
+	n := 0
+	for _, sq := range e.squares {
+		x, y := sq&7, sq>>3
+		if (own[y]|opp[y])&(1<<x) == 0 && flipDiscs(own, opp, x, y, false) > 0 {
+			n++
+		}
+	}
+	return n
+}
+
+func flipDiscs(own, opp *[boardH]uint8, x, y int, isActual bool) int {
+	ret := 0
+	for vy := -1; vy <= 1; vy++ {
+		for vx := -1; vx <= 1; vx++ {
+			if vx == 0 && vy == 0 {
+				continue
+			}
+			cx, cy, s := x+vx, y+vy, 0
+			for cx >= 0 && cy >= 0 && cx < boardW && cy < boardH && opp[cy]&(1<<cx) != 0 {
+				cx, cy, s = cx+vx, cy+vy, s+1
+			}
+			if s == 0 || cx < 0 || cy < 0 || cx >= boardW || cy >= boardH || own[cy]&(1<<cx) == 0 {
+				continue
+			}
+			if !isActual {
+				return s
+			}
+			ret += s
+			for ; s > 0; s-- {
+				cx, cy = cx-vx, cy-vy
+				own[cy] |= 1 << cx
+				opp[cy] &^= 1 << cx
+			}
+		}
+	}
+	if ret > 0 {
+		own[y] |= 1 << x
+	}
+	return ret
+}
+
+func initialBoard() board {
+	var p board
+	p.black[3] = 1 << 3
+	p.white[3] = 1 << 4
+	p.black[4] = 1 << 4
+	p.white[4] = 1 << 3
+	p.analyze()
+	return p
+}
+
+/*---------------------------------------------------------------------------*/
+
+var reComment = regexp.MustCompile(`//[^\n]*|/\*(?s:.*?)\*/`)
+
+func readTables(path string) error {
+	src, err := ioutil.ReadFile(path)
+	if err != nil {
+		return err
+	}
+	text := reComment.ReplaceAllString(string(src), "")
+	for name, pTable := range map[string]*[4][32]int{
+		"evalStonesTable": &evalStonesTable, "evalFixedStonesTable": &evalFixedStonesTable,
+	} {
+		re := regexp.MustCompile(name + `\s*\[4\]\s*\[32\]\s*=\s*\{((?s:.*?))\};`)
+		m := re.FindStringSubmatch(text)
+		if m == nil {
+			return fmt.Errorf("%s isn't found", name)
+		}
+		values := strings.FieldsFunc(m[1], func(r rune) bool { return strings.ContainsRune("{}, \t\r\n", r) })
+		if len(values) != 4*32 {
+			return fmt.Errorf("%s has %d values", name, len(values))
+		}
+		for i, v := range values {
+			n, err := strconv.Atoi(v)
+			if err != nil {
+				return fmt.Errorf("%s: %v", name, err)
+			}
+			pTable[i/32][i%32] = n
+		}
+	}
+	for name, pValue := range map[string]*int{
+		"EVAL_INF": &evalInf, "EVAL_WIN": &evalWin, "EVAL_LOSE": &evalLose, "EVAL_NOPLACEABLE": &evalNoPlaceable,
+	} {
+		m := regexp.MustCompile(`#define\s+` + name + `\s+(-?\d+)`).FindStringSubmatch(text)
+		if m != nil {
+			*pValue, _ = strconv.Atoi(m[1])
+		}
+	}
+	return nil
+}
@@ -0,0 +1,386 @@
+package main
+
+/*
+Tune the evaluation tables of reversi by self-play and regression.
+
+Games are played from random openings by the midgame search of game.cpp, and
+the last empties are played perfectly by the endgame solver. Every position of
+the games is labeled by the final disc differential for the side to move.
+
+evaluateBoard() sums the weights of the squares for unfixed stones and fixed
+stones, plus the number of placeable squares and EVAL_NOPLACEABLE. The scale k
+of the current tables in discs is fitted first, so that the new evaluation
+keeps its magnitude against EVAL_WIN and the random noise. Then the weights
+are fitted by least squares under the 8 symmetries of the board, with the
+mobility term fixed as it is on the device:
+
+	label / k ≈ Σ weight * stones + placeable + EVAL_NOPLACEABLE * (placeable == 0)
+
+The fitted weights are expanded into the same [4][32] nibble tables as data.h,
+so the cost on the device is unchanged. The error of the current tables and the
+new tables on held-out games is reported, each with its own best scale.
+
+Usage: go run evaltune.go engine.go [-games n] [-random n] [-depth n]
+       [-exact n] [-seed n] [-o file | -replace] <data.h>
+*/
+
+import (
+	"flag"
+	"fmt"
+	"io/ioutil"
+	"math"
+	"math/rand"
+	"os"
+	"regexp"
+	"runtime"
+	"strings"
+	"sync"
+)
+
+const (
+	squareClasses = 10 // Squares of a quadrant under the diagonal
+	featuresNum   = squareClasses*2 + 1
+	minEmpties    = 4
+	weightMax     = 127 / 4 // A nibble of the table sums up to 4 weights
+)
+
+type sample struct {
+	features [featuresNum]float64
+	label    float64
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                 Self-play                                 */
+/*---------------------------------------------------------------------------*/
+
+func squareClass(x, y int) int {
+	x, y = min(x, boardW-1-x), min(y, boardH-1-y)
+	if x > y {
+		x, y = y, x
+	}
+	return y*(y+1)/2 + x
+}
+
+/*  Stones by class for the side to move, and the mobility term of evaluateBoard()  */
+func extractFeatures(p *board) [featuresNum]float64 {
+	var f [featuresNum]float64
+	sign := 1.0
+	if p.isWhiteTurn {
+		sign = -1.0
+	}
+	for y := 0; y < boardH; y++ {
+		for x := 0; x < boardW; x++ {
+			b := uint8(1) << x
+			idx := squareClass(x, y)
+			if p.flag[y]&b != 0 {
+				idx += squareClasses
+			}
+			if p.black[y]&b != 0 {
+				f[idx] += sign
+			} else if p.white[y]&b != 0 {
+				f[idx] -= sign
+			}
+		}
+	}
+	f[featuresNum-1] = float64(p.numPlaceable)
+	if p.numPlaceable == 0 {
+		f[featuresNum-1] += float64(evalNoPlaceable)
+	}
+	return f
+}
+
+func playGame(r *rand.Rand, randomPlies, depth, exact int) []sample {
+	var history []board
+	p := initialBoard()
+	for !p.isGameOver() {
+		if p.numPlaceable == 0 {
+			p = p.pass()
+			continue
+		}
+		empties := boardW*boardH - p.numStones
+		if empties >= minEmpties && p.numStones-initialStones >= randomPlies {
+			history = append(history, p)
+		}
+		var x, y int
+		if p.numStones-initialStones < randomPlies {
+			n := r.Intn(p.numPlaceable)
+			for m := 0; m < boardW*boardH; m++ {
+				if p.placeable(m&7, m>>3) {
+					if n == 0 {
+						x, y = m&7, m>>3
+						break
+					}
+					n--
+				}
+			}
+		} else if empties <= exact {
+			_, x, y = newEndgame(&p).solve(&p)
+		} else {
+			_, x, y = alphabeta(&p, depth, -evalInf, evalInf)
+		}
+		p = p.play(x, y)
+	}
+
+	diff := float64(p.numBlack - p.numWhite)
+	if empties := float64(boardW*boardH - p.numStones); diff > 0 {
+		diff += empties
+	} else if diff < 0 {
+		diff -= empties
+	}
+	samples := make([]sample, len(history))
+	for i := range history {
+		samples[i].features = extractFeatures(&history[i])
+		samples[i].label = diff
+		if history[i].isWhiteTurn {
+			samples[i].label = -diff
+		}
+	}
+	return samples
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                Regression                                 */
+/*---------------------------------------------------------------------------*/
+
+/*  Least squares of the stone weights by the normal equations with a small ridge  */
+func fit(samples []sample, k float64) ([squareClasses * 2]float64, error) {
+	const n = squareClasses * 2
+	var a [n][n + 1]float64
+	for i := range samples {
+		f := &samples[i].features
+		target := samples[i].label/k - f[featuresNum-1]
+		for j := 0; j < n; j++ {
+			for l := 0; l < n; l++ {
+				a[j][l] += f[j] * f[l]
+			}
+			a[j][n] += f[j] * target
+		}
+	}
+	for j := 0; j < n; j++ {
+		a[j][j] += 1e-3 * float64(len(samples))
+	}
+	for c := 0; c < n; c++ {
+		pivot := c
+		for r := c + 1; r < n; r++ {
+			if math.Abs(a[r][c]) > math.Abs(a[pivot][c]) {
+				pivot = r
+			}
+		}
+		if a[pivot][c] == 0 {
+			return [n]float64{}, fmt.Errorf("singular system")
+		}
+		a[c], a[pivot] = a[pivot], a[c]
+		for r := 0; r < n; r++ {
+			if r != c {
+				m := a[r][c] / a[c][c]
+				for l := c; l <= n; l++ {
+					a[r][l] -= m * a[c][l]
+				}
+			}
+		}
+	}
+	var x [n]float64
+	for j := 0; j < n; j++ {
+		x[j] = a[j][n] / a[j][j]
+	}
+	return x, nil
+}
+
+/*  Weights of the square classes as they are in the given tables  */
+func tableWeights(stones, fixed *[4][32]int) (w [featuresNum]float64) {
+	for y := 0; y < boardH/2; y++ {
+		for x := 0; x < boardW; x++ {
+			idx := x
+			if x >= 4 {
+				idx = 16 + x - 4
+			}
+			w[squareClass(x, y)] = float64(stones[y][1<<(idx&3)|idx&16])
+			w[squareClasses+squareClass(x, y)] = float64(fixed[y][1<<(idx&3)|idx&16])
+		}
+	}
+	w[featuresNum-1] = 1
+	return w
+}
+
+func expandTable(w []int) (table [4][32]int) {
+	for y := 0; y < boardH/2; y++ {
+		for v := 0; v < 16; v++ {
+			for x := 0; x < 4; x++ {
+				if v&(1<<x) != 0 {
+					table[y][v] += w[squareClass(x, y)]
+					table[y][16+v] += w[squareClass(x+4, y)]
+				}
+			}
+		}
+	}
+	return table
+}
+
+func evaluate(f *[featuresNum]float64, w *[featuresNum]float64) float64 {
+	eval := 0.0
+	for j, v := range f {
+		eval += v * w[j]
+	}
+	return eval
+}
+
+/*  Best scale of the evaluation in discs  */
+func bestScale(samples []sample, w *[featuresNum]float64) float64 {
+	var ee, el float64
+	for i := range samples {
+		eval := evaluate(&samples[i].features, w)
+		ee += eval * eval
+		el += eval * samples[i].label
+	}
+	return el / ee
+}
+
+/*  RMS error in discs with the best scale of the evaluation  */
+func rmsError(samples []sample, w *[featuresNum]float64) float64 {
+	k, sum := bestScale(samples, w), 0.0
+	for i := range samples {
+		d := k*evaluate(&samples[i].features, w) - samples[i].label
+		sum += d * d
+	}
+	return math.Sqrt(sum / float64(len(samples)))
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                  Output                                   */
+/*---------------------------------------------------------------------------*/
+
+func formatTable(name string, w []int) string {
+	var sb strings.Builder
+	sb.WriteString("/*\n")
+	for y := 0; y < boardH; y++ {
+		sb.WriteString("   ")
+		for x := 0; x < boardW; x++ {
+			fmt.Fprintf(&sb, "%3d", w[squareClass(x, y)])
+		}
+		sb.WriteString("\n")
+	}
+	fmt.Fprintf(&sb, "*/\nPROGMEM static const int8_t %s[4][32] = {\n", name)
+	table := expandTable(w)
+	for y := range table {
+		if y == 0 {
+			sb.WriteString("    {\n")
+		} else {
+			sb.WriteString("    },{\n")
+		}
+		for half := 0; half < 2; half++ {
+			sb.WriteString("      ")
+			for _, v := range table[y][half*16 : half*16+16] {
+				fmt.Fprintf(&sb, "%3d,", v)
+			}
+			sb.WriteString("\n")
+		}
+	}
+	sb.WriteString("    }\n};\n")
+	return sb.String()
+}
+
+func main() {
+	games := flag.Int("games", 2000, "number of self-play games")
+	randomPlies := flag.Int("random", 10, "random plies of the openings")
+	depth := flag.Int("depth", 2, "depth of the midgame search")
+	exact := flag.Int("exact", 12, "empties played by the endgame solver")
+	seed := flag.Int64("seed", 1, "random seed of the openings")
+	out := flag.String("o", "", "output file of the tables (default stdout)")
+	replace := flag.Bool("replace", false, "replace the tables in data.h")
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+	if err := readTables(flag.Arg(0)); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+
+	/*  Play in parallel, holding out every tenth game  */
+	results := make([][]sample, *games)
+	var wg sync.WaitGroup
+	sem := make(chan bool, runtime.NumCPU())
+	for i := range results {
+		wg.Add(1)
+		sem <- true
+		go func(i int) {
+			defer wg.Done()
+			results[i] = playGame(rand.New(rand.NewSource(*seed+int64(i))), *randomPlies, *depth, *exact)
+			<-sem
+		}(i)
+	}
+	wg.Wait()
+	var training, test []sample
+	for i, s := range results {
+		if i%10 == 9 {
+			test = append(test, s...)
+		} else {
+			training = append(training, s...)
+		}
+	}
+
+	oldWeights := tableWeights(&evalStonesTable, &evalFixedStonesTable)
+	k := bestScale(training, &oldWeights)
+	if k <= 0 {
+		fmt.Fprintf(os.Stderr, "current tables have no positive scale (%.3f)\n", k)
+		os.Exit(1)
+	}
+	x, err := fit(training, k)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	var stones, fixed [squareClasses]int
+	clamped := 0
+	for c := 0; c < squareClasses*2; c++ {
+		v := int(math.Round(x[c]))
+		if v > weightMax || v < -weightMax {
+			v = max(min(v, weightMax), -weightMax)
+			clamped++
+		}
+		if c < squareClasses {
+			stones[c] = v
+		} else {
+			fixed[c-squareClasses] = v
+		}
+	}
+
+	var newWeights [featuresNum]float64
+	for c := 0; c < squareClasses; c++ {
+		newWeights[c], newWeights[squareClasses+c] = float64(stones[c]), float64(fixed[c])
+	}
+	newWeights[featuresNum-1] = 1
+	fmt.Fprintf(os.Stderr, "%d training positions, %d test positions\n", len(training), len(test))
+	fmt.Fprintf(os.Stderr, "RMS error in discs: current %.3f, tuned %.3f\n",
+		rmsError(test, &oldWeights), rmsError(test, &newWeights))
+	if clamped > 0 {
+		fmt.Fprintf(os.Stderr, "%d weights were clamped to ±%d\n", clamped, weightMax)
+	}
+
+	text := formatTable("evalStonesTable", stones[:]) + "\n" + formatTable("evalFixedStonesTable", fixed[:])
+	switch {
+	case *replace:
+		src, err := ioutil.ReadFile(flag.Arg(0))
+		if err == nil {
+			re := regexp.MustCompile(`/\*[^/]*\*/\s*PROGMEM static const int8_t evalStonesTable(?s:.*?)\n};\n` +
+				`\s*/\*[^/]*\*/\s*PROGMEM static const int8_t evalFixedStonesTable(?s:.*?)\n};\n`)
+			if !re.Match(src) {
+				err = fmt.Errorf("%s: tables aren't found", flag.Arg(0))
+			} else {
+				err = ioutil.WriteFile(flag.Arg(0), re.ReplaceAllLiteral(src, []byte(text)), 0644)
+			}
+		}
+		if err != nil {
+			fmt.Fprintln(os.Stderr, err)
+			os.Exit(1)
+		}
+	case *out != "":
+		if err := ioutil.WriteFile(*out, []byte(text), 0644); err != nil {
+			fmt.Fprintln(os.Stderr, err)
+			os.Exit(1)
+		}
+	default:
+		fmt.Print(text)
+	}
+}
@@ -1,5 +1,6 @@
 #include "common.h"
 #include "data.h"
+#include "book.h"
 
 /*  Defines  */
 
@@ -10,6 +11,10 @@
 #define CPU_INTERVAL_FRAMES 8
 #define CPU_INTERVAL_MILLIS ((1000 * CPU_INTERVAL_FRAMES) / FPS)
 
+#define ENDGAME_EMPTIES(level)  ((level) * 2 + 2) // Solved exactly at this number of empties
+#define ENDGAME_EMPTIES_MAX     ENDGAME_EMPTIES(4)
+#define ENDGAME_FASTEST_FIRST   6
+
 enum STATE_T {
     STATE_INIT = 0,
     STATE_PLAYING,
@@ -74,10 +79,17 @@ static FIX_COND_T checkFixCond(BOARD_T *p, int8_t x, int8_t y, int8_t vx, int8_t
 #define     countBits(val) pgm_read_byte(bitNumTable + (val))
 
 static void cpuThinking(void);
+static bool lookupBook(void);
+static uint32_t hashBoard(BOARD_T *p, uint8_t t);
+static void transformPos(int8_t *pX, int8_t *pY, uint8_t t);
 static void cpuThinkingInterval(void);
 static int  alphabeta(BOARD_T *p, int8_t depth, int alpha, int beta);
 static int  evaluateBoard(BOARD_T *p);
 static int8_t evaluateBit(const int8_t *pTable, uint8_t value);
+static int8_t solveEndgame(void);
+static int8_t searchEndgame(const uint8_t *pOwn, const uint8_t *pOpp, int8_t empties, int8_t alpha, int8_t beta, bool isPassed, bool isRoot);
+static uint8_t flipDiscs(uint8_t *pOwn, uint8_t *pOpp, int8_t x, int8_t y, bool isActual);
+static int8_t countMoves(const uint8_t *pOwn, const uint8_t *pOpp);
 
 /*  Local Variables  */
 
@@ -91,6 +103,8 @@ static bool     isCursorMoved, isCancelable, isPreLost, isCpuInterrupted, isLast
 static unsigned long nextCpuInterval;
 static const byte *resultSound;
 static const __FlashStringHelper *resultLabel;
+static MyRandom aiRandom;
+static uint8_t  endgameSquares[ENDGAME_EMPTIES_MAX], endgameSquaresNum;
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Functions                               */
@@ -110,6 +124,7 @@ void initGame(void)
     writeRecord();
 
     resetFlipAnimationParams();
+    aiRandom.setSeed(random());
     isCancelable = false;
     arduboy.playScore2(soundStart, 0);
     isInvalid = true;
@@ -768,23 +783,91 @@ static FIX_COND_T checkFixCond(BOARD_T *p, int8_t x, int8_t y, int8_t vx, int8_t
 
 static void cpuThinking(void)
 {
-    int8_t depth = min(record.cpuLevel, board.numStones / 4 + 1);
-    if (board.numPlaceable == 1) depth = 1;
+    if (board.numPlaceable > 1 && lookupBook()) {
+        dprintln(F("CPU used the book"));
+        resetFlipAnimationParams();
+        placeStone();
+        return;
+    }
     nextCpuInterval = millis() + CPU_INTERVAL_MILLIS;
     isCpuInterrupted = false;
-    isLastAPressed = arduboy.pressed(A_BUTTON);
-    int eval = -alphabeta(NULL, depth, -EVAL_INF, EVAL_INF);
+    isLastAPressed = arduboy.buttonPressed(A_BUTTON);
+    int eval;
+    bool isEndgame = (BOARD_W * BOARD_H - board.numStones <= ENDGAME_EMPTIES(record.cpuLevel));
+    if (isEndgame) {
+        eval = solveEndgame();
+    } else {
+        int8_t depth = min(record.cpuLevel, board.numStones / 4 + 1);
+        if (board.numPlaceable == 1) depth = 1;
+        eval = -alphabeta(NULL, depth, -EVAL_INF, EVAL_INF);
+    }
     resetFlipAnimationParams();
     arduboy.setRGBled(0, 0, 0);
     if (isCpuInterrupted) {
         dprintln(F("CPU was interrupted"));
     } else {
-        dprint(F("CPU's evaluation="));
+        dprint((isEndgame) ? F("CPU's exact result=") : F("CPU's evaluation="));
         dprintln(eval);
         placeStone();
     }
 }
 
+static bool lookupBook(void)
+{
+    if (board.numStones >= INITIAL_STONES + BOOK_PLIES) return false;
+    for (uint8_t t = 0; t < 8; t++) {
+        uint32_t hash = hashBoard(&board, t) >> 8;
+        int16_t lo = 0, hi = sizeof(bookTable) / sizeof(bookTable[0]) - 1;
+        while (lo <= hi) {
+            int16_t mid = (lo + hi) / 2;
+            uint32_t entry = pgm_read_dword(&bookTable[mid]);
+            if ((entry >> 8) < hash) {
+                lo = mid + 1;
+            } else if ((entry >> 8) > hash) {
+                hi = mid - 1;
+            } else {
+                int8_t x = entry & 7, y = entry >> 3 & 7;
+                transformPos(&x, &y, t);
+                if (~(board.black[y] | board.white[y]) & board.flag[y] & 1 << x) {
+                    cursorPos.x = x;
+                    cursorPos.y = y;
+                    return true;
+                }
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+static uint32_t hashBoard(BOARD_T *p, uint8_t t)
+{
+    /*  FNV-1a of the board seen through transform t, same as etc/bookgen.go  */
+    uint32_t hash = 2166136261UL;
+    for (int8_t i = 0; i < BOARD_H * 2; i++) {
+        const uint8_t *pRows = (i < BOARD_H) ? p->black : p->white;
+        uint8_t v = 0;
+        for (int8_t x = 0; x < BOARD_W; x++) {
+            int8_t sx = x, sy = i & (BOARD_H - 1);
+            transformPos(&sx, &sy, t);
+            if (pRows[sy] & 1 << sx) v |= 1 << x;
+        }
+        hash = (hash ^ v) * 16777619UL;
+    }
+    return (hash ^ p->isWhiteTurn) * 16777619UL;
+}
+
+static void transformPos(int8_t *pX, int8_t *pY, uint8_t t)
+{
+    if (t & 1) *pX = BOARD_W - 1 - *pX;
+    if (t & 2) *pY = BOARD_H - 1 - *pY;
+    if (t & 4) {
+        int8_t tmp = *pX;
+        *pX = *pY;
+        *pY = tmp;
+    }
+}
+
 static int alphabeta(BOARD_T *p, int8_t depth, int alpha, int beta)
 {
     bool isRoot;
@@ -797,7 +880,7 @@ static int alphabeta(BOARD_T *p, int8_t depth, int alpha, int beta)
     }
 
     if (depth-- <= 0 || isGameOver(p)) {
-        return -evaluateBoard(p) + random(3);
+        return -evaluateBoard(p) + aiRandom.below(3);
     }
     if (p->numPlaceable == 0) {
         BOARD_T tmpBoard = *p;
@@ -840,7 +923,11 @@ static void cpuThinkingInterval(void)
     record.playFrames += CPU_INTERVAL_FRAMES;
     counter += CPU_INTERVAL_FRAMES;
     nextCpuInterval += CPU_INTERVAL_MILLIS;
+#ifdef INPUT_HARNESS
+    bool isAPressed = arduboy.buttonPressed(A_BUTTON); // Only the logged state is replayed
+#else
     bool isAPressed = arduboy.pressed(A_BUTTON);
+#endif
     if (!isLastAPressed && isAPressed) {
         isCpuInterrupted = true;
     } else {
@@ -886,3 +973,133 @@ static int8_t evaluateBit(const int8_t *pTable, uint8_t value)
     return  (int8_t) pgm_read_byte(pTable + (value & 0xf)) +
             (int8_t) pgm_read_byte(pTable + 16 + (value >> 4 & 0xf));
 }
+
+/*---------------------------------------------------------------------------*/
+/*                              Endgame Solver                               */
+/*---------------------------------------------------------------------------*/
+
+static int8_t solveEndgame(void)
+{
+    /*  Order the empty squares by parity: quadrants with odd empties first  */
+    uint8_t quadrants[4] = { 0, 0, 0, 0 };
+    for (int8_t y = 0; y < BOARD_H; y++) {
+        uint8_t empty = ~(board.black[y] | board.white[y]);
+        quadrants[(y >> 2) * 2] += countBits(empty & 0x0F);
+        quadrants[(y >> 2) * 2 + 1] += countBits(empty & 0xF0);
+    }
+    endgameSquaresNum = 0;
+    for (int8_t parity = 1; parity >= 0; parity--) {
+        for (int8_t y = 0; y < BOARD_H; y++) {
+            uint8_t empty = ~(board.black[y] | board.white[y]);
+            for (int8_t x = 0; x < BOARD_W; x++) {
+                if ((empty & 1 << x) && (quadrants[(y >> 2) * 2 + (x >> 2)] & 1) == parity) {
+                    endgameSquares[endgameSquaresNum++] = y << 3 | x;
+                }
+            }
+        }
+    }
+
+    const uint8_t *pOwn = (board.isWhiteTurn) ? board.white : board.black;
+    const uint8_t *pOpp = (board.isWhiteTurn) ? board.black : board.white;
+    return searchEndgame(pOwn, pOpp, endgameSquaresNum, -BOARD_W * BOARD_H - 1, BOARD_W * BOARD_H + 1, false, true);
+}
+
+static int8_t searchEndgame(const uint8_t *pOwn, const uint8_t *pOpp, int8_t empties, int8_t alpha, int8_t beta, bool isPassed, bool isRoot)
+{
+    if (millis() >= nextCpuInterval) cpuThinkingInterval();
+    if (isCpuInterrupted) return alpha;
+
+    /*  List the moves, fastest-first (fewest replies) near the root  */
+    uint8_t moves[ENDGAME_EMPTIES_MAX], replies[ENDGAME_EMPTIES_MAX];
+    int8_t movesNum = 0;
+    for (uint8_t i = 0; i < endgameSquaresNum && empties > 0; i++) {
+        int8_t x = endgameSquares[i] & 7, y = endgameSquares[i] >> 3;
+        if ((pOwn[y] | pOpp[y]) & 1 << x) continue;
+        if (empties >= ENDGAME_FASTEST_FIRST) {
+            uint8_t own[BOARD_H], opp[BOARD_H];
+            memcpy(own, pOwn, BOARD_H);
+            memcpy(opp, pOpp, BOARD_H);
+            if (!flipDiscs(own, opp, x, y, true)) continue;
+            int8_t n = countMoves(opp, own), j;
+            for (j = movesNum; j > 0 && replies[j - 1] > n; j--) {
+                moves[j] = moves[j - 1];
+                replies[j] = replies[j - 1];
+            }
+            moves[j] = endgameSquares[i];
+            replies[j] = n;
+            movesNum++;
+        } else if (flipDiscs((uint8_t *) pOwn, (uint8_t *) pOpp, x, y, false)) {
+            moves[movesNum++] = endgameSquares[i];
+        }
+    }
+
+    /*  No move  */
+    if (movesNum == 0) {
+        if (!isPassed && empties > 0) {
+            return -searchEndgame(pOpp, pOwn, empties, -beta, -alpha, true, false);
+        }
+        int8_t diff = 0;
+        for (int8_t y = 0; y < BOARD_H; y++) {
+            diff += countBits(pOwn[y]) - countBits(pOpp[y]);
+        }
+        if (diff > 0) diff += empties; // Empty squares go to the winner
+        if (diff < 0) diff -= empties;
+        return diff;
+    }
+
+    for (int8_t i = 0; i < movesNum; i++) {
+        int8_t x = moves[i] & 7, y = moves[i] >> 3;
+        uint8_t own[BOARD_H], opp[BOARD_H];
+        memcpy(own, pOwn, BOARD_H);
+        memcpy(opp, pOpp, BOARD_H);
+        flipDiscs(own, opp, x, y, true);
+        int8_t eval = -searchEndgame(opp, own, empties - 1, -beta, -alpha, false, false);
+        if (isCpuInterrupted) return alpha;
+        if (eval > alpha) {
+            alpha = eval;
+            if (isRoot) {
+                cursorPos.x = x;
+                cursorPos.y = y;
+            }
+        }
+        if (alpha >= beta) break;
+    }
+    return alpha;
+}
+
+static uint8_t flipDiscs(uint8_t *pOwn, uint8_t *pOpp, int8_t x, int8_t y, bool isActual)
+{
+    uint8_t ret = 0;
+    for (int8_t vy = -1; vy <= 1; vy++) {
+        for (int8_t vx = -1; vx <= 1; vx++) {
+            if (vx == 0 && vy == 0) continue;
+            int8_t cx = x + vx, cy = y + vy, s = 0;
+            while (cx >= 0 && cy >= 0 && cx < BOARD_W && cy < BOARD_H && (pOpp[cy] & 1 << cx)) {
+                cx += vx;
+                cy += vy;
+                s++;
+            }
+            if (s == 0 || cx < 0 || cy < 0 || cx >= BOARD_W || cy >= BOARD_H || !(pOwn[cy] & 1 << cx)) continue;
+            if (!isActual) return s;
+            ret += s;
+            while (s-- > 0) {
+                cx -= vx;
+                cy -= vy;
+                pOwn[cy] |= 1 << cx;
+                pOpp[cy] &= ~(1 << cx);
+            }
+        }
+    }
+    if (ret) pOwn[y] |= 1 << x;
+    return ret;
+}
+
+static int8_t countMoves(const uint8_t *pOwn, const uint8_t *pOpp)
+{
+    int8_t ret = 0;
+    for (uint8_t i = 0; i < endgameSquaresNum; i++) {
+        int8_t x = endgameSquares[i] & 7, y = endgameSquares[i] >> 3;
+        if (!((pOwn[y] | pOpp[y]) & 1 << x) && flipDiscs((uint8_t *) pOwn, (uint8_t *) pOpp, x, y, false)) ret++;
+    }
+    return ret;
+}
@@ -1,5 +1,18 @@
 #include "MyArduboy2.h"
 
+/*  Local Typedefs  */
+
+typedef struct {
+    const uint8_t   *p, *pCopy;
+    uint8_t         op, count, value;
+} UNPACK_T;
+
+/*  Local Functions  */
+
+static void     getBitmapColumn(uint16_t *pColumn, const uint8_t *bitmap, uint8_t w, uint8_t pages, int16_t i, int16_t r, uint8_t rows);
+static uint8_t  unpackByte(UNPACK_T &u);
+static void     blendByte(uint8_t *p, uint8_t d, uint8_t color);
+
 /*  Local Constants  */
 
 PROGMEM static const uint32_t imgFont[] = {
@@ -30,12 +43,100 @@ void MyArduboy2::beginNoLogo(void)
 /*                               Buttons status                              */
 /*---------------------------------------------------------------------------*/
 
+#ifdef INPUT_HARNESS
+
+#include <util/crc16.h>
+#ifdef INPUT_REPLAY
+#include "replay.h" // Generated by etc/inputlog.go
+#endif
+
+uint16_t inputFrames;
+
+static uint8_t  inputRunState, inputRunCount;
+#ifdef INPUT_REPLAY
+static uint16_t inputReplayIdx, inputErrors;
+static bool     isInputReplaying;
+#endif
+
+static uint8_t updateInput(uint8_t state, const uint8_t *pBuffer)
+{
+    if (inputFrames == 0) {
+        while (!Serial) { ; } // Wait for the serial monitor
+#ifdef INPUT_REPLAY
+        uint32_t seed = pgm_read_dword(inputReplayData);
+        inputReplayIdx = 4;
+        isInputReplaying = true;
+#else
+        uint32_t seed = INPUT_SEED;
+#endif
+        Serial.print(F("S "));
+        Serial.println(seed, HEX);
+        srand(seed);
+        randomSeed(seed);
+    } else {
+        /*  Hash of the frame which has been drawn since the last call  */
+        uint16_t hash = 0xFFFF;
+        for (int i = 0; i < WIDTH * HEIGHT / 8; i++) {
+            hash = _crc16_update(hash, pBuffer[i]);
+        }
+#ifdef INPUT_REPLAY
+        if (isInputReplaying && inputFrames <= INPUT_REPLAY_HASHES &&
+                hash != pgm_read_word(&inputReplayHashes[inputFrames - 1])) {
+            inputErrors++;
+            Serial.print(F("E "));
+            Serial.println(inputFrames - 1);
+        }
+#else
+        Serial.print(F("H "));
+        Serial.println(hash, HEX);
+#endif
+    }
+
+#ifdef INPUT_REPLAY
+    if (isInputReplaying && inputRunCount == 0) {
+        inputRunCount = pgm_read_byte(inputReplayData + inputReplayIdx + 1);
+        if (inputRunCount > 0) {
+            inputRunState = pgm_read_byte(inputReplayData + inputReplayIdx);
+            inputReplayIdx += 2;
+        } else {
+            isInputReplaying = false; // Back to the real buttons
+            Serial.print(F("R "));
+            Serial.print(inputFrames);
+            Serial.print(' ');
+            Serial.println(inputErrors);
+        }
+    }
+    if (isInputReplaying) {
+        state = inputRunState;
+        inputRunCount--;
+    }
+#else
+    if (inputRunCount > 0 && (state != inputRunState || inputRunCount == 255)) {
+        Serial.print(F("I "));
+        Serial.print(inputRunState, HEX);
+        Serial.print(' ');
+        Serial.println(inputRunCount);
+        inputRunCount = 0;
+    }
+    inputRunState = state;
+    inputRunCount++;
+#endif
+    inputFrames++;
+    return state;
+}
+
+#endif
+
 bool MyArduboy2::nextFrame(void)
 {
     bool ret = Arduboy2::nextFrame();
     if (ret) {
         lastButtonState = currentButtonState;
+#ifdef INPUT_HARNESS
+        currentButtonState = updateInput(buttonsState(), getBuffer());
+#else
         currentButtonState = buttonsState();
+#endif
     }
     return ret;
 }
@@ -215,3 +316,158 @@ void MyArduboy2::fillBeltWhite(uint8_t *p, uint8_t d, uint8_t w)
         *p++ |= d;
     }
 }
+
+/*---------------------------------------------------------------------------*/
+/*                                Draw bitmaps                               */
+/*---------------------------------------------------------------------------*/
+
+void MyArduboy2::drawBitmapWithMask(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h)
+{
+    drawMaskedBitmap(x, y, bitmap, mask, w, h);
+}
+
+void MyArduboy2::drawBitmapBordered(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h)
+{
+    drawMaskedBitmap(x, y, bitmap, NULL, w, h);
+}
+
+void MyArduboy2::drawMaskedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h)
+{
+    /*  Check parameters  */
+    uint8_t border = (mask == NULL);
+    uint8_t pages = (h + 7) >> 3;
+    int16_t x0 = x - border, x1 = x + w + border;
+    int16_t y0 = y - border, y1 = y + pages * 8 + border;
+    if (x0 >= WIDTH || x1 <= 0 || y0 >= HEIGHT || y1 <= 0) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+    if (y0 < 0) y0 = 0;
+    if (y1 > HEIGHT) y1 = HEIGHT;
+
+    /*  Draw a bitmap with mask column by column, reading each byte of them and
+        writing each byte of the buffer only once  */
+    uint8_t rows = ((y1 - 1) >> 3) - (y0 >> 3) + 1;
+    int16_t r = (y0 & ~7) - y - border;
+    int16_t i = x0 - x;
+    uint8_t *p = getBuffer() + x0 + (y0 >> 3) * WIDTH;
+    if (border) {
+        uint16_t columns[3][HEIGHT / 8];
+        uint16_t *pPrev = columns[0], *pCur = columns[1], *pNext = columns[2];
+        getBitmapColumn(pPrev, bitmap, w, pages, i - 1, r, rows);
+        getBitmapColumn(pCur, bitmap, w, pages, i, r, rows);
+        for (; i < x1 - x; i++, p++) {
+            getBitmapColumn(pNext, bitmap, w, pages, i + 1, r, rows);
+            uint8_t *q = p;
+            for (uint8_t j = 0; j < rows; j++, q += WIDTH) {
+                uint8_t d = pCur[j] >> 1;
+                uint8_t m = pCur[j] | pCur[j] >> 2 | pPrev[j] >> 1 | pNext[j] >> 1;
+                *q = (*q & ~m) | d;
+            }
+            uint16_t *pTmp = pPrev;
+            pPrev = pCur;
+            pCur = pNext;
+            pNext = pTmp;
+        }
+    } else {
+        uint8_t shift = r & 7;
+        for (; i < x1 - x; i++, p++) {
+            int8_t page = r >> 3;
+            const uint8_t *pBitmap = bitmap + page * w + i, *pMask = mask + page * w + i;
+            uint16_t d = 0, m = 0;
+            if (page >= 0) {
+                d = pgm_read_byte(pBitmap);
+                m = pgm_read_byte(pMask);
+            }
+            uint8_t *q = p;
+            for (uint8_t j = 0; j < rows; j++, q += WIDTH) {
+                pBitmap += w;
+                pMask += w;
+                if (++page < pages) {
+                    d |= pgm_read_byte(pBitmap) << 8;
+                    m |= pgm_read_byte(pMask) << 8;
+                }
+                *q = (*q & ~(m >> shift)) | d >> shift;
+                d >>= 8;
+                m >>= 8;
+            }
+        }
+    }
+}
+
+/*  Gets the bits from the row r of a column for each page of the buffer, reading each byte only once  */
+static void getBitmapColumn(uint16_t *pColumn, const uint8_t *bitmap, uint8_t w, uint8_t pages, int16_t i, int16_t r, uint8_t rows)
+{
+    if (i < 0 || i >= w) {
+        memset(pColumn, 0, rows * sizeof(uint16_t));
+        return;
+    }
+    int8_t page = r >> 3;
+    uint8_t shift = r & 7;
+    bitmap += i;
+    uint8_t b0 = (page >= 0 && page < pages) ? pgm_read_byte(bitmap + page * w) : 0;
+    page++;
+    uint8_t b1 = (page >= 0 && page < pages) ? pgm_read_byte(bitmap + page * w) : 0;
+    for (; rows > 0; rows--) {
+        page++;
+        uint8_t b2 = (page >= 0 && page < pages) ? pgm_read_byte(bitmap + page * w) : 0;
+        uint16_t v = ((uint16_t)b1 << 8 | b0) >> shift;
+        if (shift > 6) v |= (uint16_t)b2 << (16 - shift);
+        *pColumn++ = v;
+        b0 = b1;
+        b1 = b2;
+    }
+}
+
+void MyArduboy2::drawCompressedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color)
+{
+    /*  Check parameters  */
+    uint8_t pages = (h + 7) >> 3;
+    if (x >= WIDTH || x + w <= 0 || y >= HEIGHT || y + pages * 8 <= 0) return;
+
+    /*  Draw a bitmap packed by etc/imgpack.go, decoding it on the way without a buffer  */
+    UNPACK_T u = { bitmap, NULL, 0, 0, 0 };
+    uint8_t shift = y & 7;
+    int16_t row = y >> 3;
+    for (uint8_t r = 0; r < pages && row < HEIGHT / 8; r++, row++) {
+        bool isUpper = (row >= 0);
+        bool isLower = (shift > 0 && row + 1 >= 0 && row + 1 < HEIGHT / 8);
+        for (int16_t i = x; i < x + w; i++) {
+            uint16_t v = (uint16_t) unpackByte(u) << shift;
+            if (i < 0 || i >= WIDTH) continue;
+            if (isUpper) blendByte(getBuffer() + row * WIDTH + i, v, color);
+            if (isLower) blendByte(getBuffer() + (row + 1) * WIDTH + i, v >> 8, color);
+        }
+    }
+}
+
+static uint8_t unpackByte(UNPACK_T &u)
+{
+    if (u.count == 0) {
+        u.op = pgm_read_byte(u.p++);
+        if (u.op < 0x40) {
+            u.count = u.op + 1;
+        } else if (u.op < 0x80) {
+            u.count = u.op - 0x40 + 2;
+            u.value = pgm_read_byte(u.p++);
+        } else {
+            u.count = (u.op >> 2 & 0x1F) + 3;
+            u.pCopy = u.p - ((u.op & 3) << 8 | pgm_read_byte(u.p)) - 1;
+            u.p++;
+        }
+    }
+    u.count--;
+    if (u.op < 0x40) return pgm_read_byte(u.p++);
+    if (u.op < 0x80) return u.value;
+    return pgm_read_byte(u.pCopy++);
+}
+
+static void blendByte(uint8_t *p, uint8_t d, uint8_t color)
+{
+    if (color == WHITE) {
+        *p |= d;
+    } else if (color == BLACK) {
+        *p &= ~d;
+    } else {
+        *p ^= d;
+    }
+}
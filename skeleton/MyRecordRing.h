@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+/*  Journal of a record into a ring of EEPROM slots of a sequence, the record and a CRC-16  */
+
+class MyRecordRing
+{
+public:
+    MyRecordRing(const uint16_t *pAddrs, uint8_t slots, uint32_t signature, void *pRecord, uint8_t size)
+        : pAddrs(pAddrs), signature(signature), pRecord((uint8_t *) pRecord), slots(slots), size(size) { reset(); }
+    bool    read(void);
+    void    write(void);
+    void    clear(void);
+    uint8_t getSlot(void) const { return slot; }
+
+private:
+    void     reset(void) { seq = 0xFF; slot = slots - 1; }
+    uint8_t  *slotAddr(uint8_t i) const { return (uint8_t *) pgm_read_word(pAddrs + i); }
+    uint16_t calcCrcHead(uint8_t s) const;
+
+    const uint16_t  *pAddrs; // Addresses of the slots in PROGMEM
+    uint32_t        signature;
+    uint8_t         *pRecord;
+    uint8_t         slots, size, seq, slot;
+};
+
+/*  Loads the newest slot whose CRC is valid, or returns false leaving the record as it is  */
+inline bool MyRecordRing::read(void)
+{
+    bool ret = false;
+    eeprom_busy_wait();
+    for (uint8_t i = 0; i < slots; i++) {
+        const uint8_t *p = slotAddr(i);
+        uint8_t s = eeprom_read_byte(p++);
+        uint16_t crc = calcCrcHead(s);
+        for (uint8_t j = 0; j < size; j++) {
+            crc = _crc16_update(crc, eeprom_read_byte(p++));
+        }
+        if (eeprom_read_word((const uint16_t *) p) == crc && (!ret || (int8_t)(s - seq) > 0)) {
+            seq = s;
+            slot = i;
+            ret = true;
+        }
+    }
+    if (ret) {
+        eeprom_read_block(pRecord, slotAddr(slot) + 1, size);
+    } else {
+        reset();
+    }
+    return ret;
+}
+
+/*  Writes into the slot after the newest, so a power loss breaks only the slot being written.
+    Only bytes which differ from what the slot held are programmed.  */
+inline void MyRecordRing::write(void)
+{
+    if (++slot >= slots) slot = 0;
+    seq++;
+    uint16_t crc = calcCrcHead(seq);
+    for (uint8_t i = 0; i < size; i++) {
+        crc = _crc16_update(crc, pRecord[i]);
+    }
+    uint8_t *p = slotAddr(slot);
+    eeprom_busy_wait();
+    eeprom_update_byte(p, seq);
+    eeprom_update_block(pRecord, p + 1, size);
+    eeprom_update_word((uint16_t *) (p + 1 + size), crc);
+}
+
+inline void MyRecordRing::clear(void)
+{
+    eeprom_busy_wait();
+    for (uint8_t i = 0; i < slots; i++) {
+        uint8_t *p = slotAddr(i);
+        for (uint8_t j = 0; j < size + 3; j++) {
+            eeprom_update_byte(p++, 0xFF);
+        }
+    }
+    reset();
+}
+
+/*  The signature keeps a record of another game at the same addresses from being taken  */
+inline uint16_t MyRecordRing::calcCrcHead(uint8_t s) const
+{
+    uint16_t crc = 0xFFFF;
+    uint32_t v = signature;
+    for (uint8_t i = 0; i < 4; i++, v >>= 8) {
+        crc = _crc16_update(crc, v & 0xFF);
+    }
+    return _crc16_update(crc, s);
+}
@@ -1,19 +1,16 @@
 #include "common.h"
+#include "MyRecordRing.h"
 
 /*  Defines  */
 
-#define EEPROM_ADDR_BASE    16 // TODO
+#define EEPROM_ADDR_BASE    548 // TODO: Take a window of your own by "EEPROM map" of README.md
 #define EEPROM_SIGNATURE    0x004E424FUL // "OBN\x00"
+#define EEPROM_SLOTS        4
+#define EEPROM_SLOT_SIZE    (sizeof(RECORD_T) + 3) // sequence, record and CRC
 
 #define PAD_REPEAT_DELAY    (FPS / 4)
 #define PAD_REPEAT_INTERVAL (FPS / 12)
 
-enum RECORD_STATE_T : uint8_t {
-    RECORD_NOT_READ = 0,
-    RECORD_INITIAL,
-    RECORD_STORED,
-};
-
 /*  Global Variables  */
 
 MyArduboy2  ab;
@@ -24,8 +21,6 @@ bool        isInvalid, isRecordDirty;
 
 /*  Local Functions  */
 
-static uint16_t calcCheckSum();
-
 static void     eepSeek(int addr);
 static uint8_t  eepRead8(void);
 static uint16_t eepRead16(void);
@@ -38,7 +33,12 @@ static void     eepWriteBlock(const void *p, size_t n);
 
 /*  Local Variables  */
 
-static RECORD_STATE_T   recordState = RECORD_NOT_READ;
+PROGMEM static const uint16_t eepromSlotAddrs[EEPROM_SLOTS] = {
+    EEPROM_ADDR_BASE, EEPROM_ADDR_BASE + EEPROM_SLOT_SIZE,
+    EEPROM_ADDR_BASE + EEPROM_SLOT_SIZE * 2, EEPROM_ADDR_BASE + EEPROM_SLOT_SIZE * 3
+};
+
+static MyRecordRing     recordRing(eepromSlotAddrs, EEPROM_SLOTS, EEPROM_SIGNATURE, &record, sizeof(record));
 static int16_t          eepAddr;
 static bool             isInvalidInst;
 
@@ -48,15 +48,7 @@ static bool             isInvalidInst;
 
 void readRecord(void)
 {
-    bool isVerified = false;
-    eepSeek(EEPROM_ADDR_BASE);
-    if (eepRead32() == EEPROM_SIGNATURE) {
-        eepReadBlock(&record, sizeof(record));
-        isVerified = (eepRead16() == calcCheckSum());
-    }
-
-    if (isVerified) {
-        recordState = RECORD_STORED;
+    if (recordRing.read()) {
         isRecordDirty = false;
     } else {
         memset(&record, 0, sizeof(record));
@@ -64,7 +56,6 @@ void readRecord(void)
         record.config[1] = 2;
         record.config[2] = 4;
         record.config[3] = 8;
-        recordState = RECORD_INITIAL;
         isRecordDirty = true;
     }
     setSound(ab.isAudioEnabled()); // Load Sound ON/OFF
@@ -73,36 +64,14 @@ void readRecord(void)
 void writeRecord(void)
 {
     if (!isRecordDirty) return;
-    if (recordState == RECORD_INITIAL) {
-        eepSeek(EEPROM_ADDR_BASE);
-        eepWrite32(EEPROM_SIGNATURE);
-    } else {
-        eepSeek(EEPROM_ADDR_BASE + 4);
-    }
-    eepWriteBlock(&record, sizeof(record));
-    eepWrite16(calcCheckSum());
+    recordRing.write();
     ab.audio.saveOnOff(); // Save Sound ON/OFF
-    recordState = RECORD_STORED;
     isRecordDirty = false;
 }
 
-static uint16_t calcCheckSum()
-{
-    uint16_t checkSum = (EEPROM_SIGNATURE & 0xFFFF) + (EEPROM_SIGNATURE >> 16) * 3;
-    uint16_t *p = (uint16_t *) &record;
-    for (int i = 0; i < sizeof(record) / 2; i++) {
-        checkSum += *p++ * (i * 2 + 5);
-    }
-    return checkSum;
-}
-
 void clearRecord(void)
 {
-    eepSeek(EEPROM_ADDR_BASE);
-    for (int i = 0; i < (sizeof(record) + 6) / 4; i++) {
-        eepWrite32(0);
-    }
-    recordState = RECORD_INITIAL;
+    recordRing.clear();
 }
 
 void handleDPad(void)
@@ -207,27 +176,27 @@ void eepReadBlock(void *p, size_t n)
 void eepWrite8(uint8_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_byte((uint8_t *) eepAddr, val);
+    eeprom_update_byte((uint8_t *) eepAddr, val);
     eepAddr++;
 }
 
 void eepWrite16(uint16_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_word((uint16_t *)eepAddr, val);
+    eeprom_update_word((uint16_t *)eepAddr, val);
     eepAddr += 2;
 }
 
 void eepWrite32(uint32_t val)
 {
     eeprom_busy_wait();
-    eeprom_write_dword((uint32_t *)eepAddr, val);
+    eeprom_update_dword((uint32_t *)eepAddr, val);
     eepAddr += 4;
 }
 
 void eepWriteBlock(const void *p, size_t n)
 {
     eeprom_busy_wait();
-    eeprom_write_block(p, (void *) eepAddr, n);
+    eeprom_update_block(p, (void *) eepAddr, n);
     eepAddr += n;
 }
@@ -32,7 +32,7 @@ static void drawTop(void);
 static void drawSettings(void);
 static void drawCredit(void);
 
-static void drawText(const char *p, int lines);
+static void drawText(const char *p, int16_t y);
 
 /*  Local Functions (macros)  */
 